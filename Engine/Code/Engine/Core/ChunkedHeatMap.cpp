@@ -0,0 +1,478 @@
+#include "Engine/Core/ChunkedHeatMap.hpp"
+#include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <string.h>
+#include <stdio.h>
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr unsigned int	CHUNKED_HEAT_MAP_FILE_VERSION	= 1;
+constexpr size_t		CHUNK_FILE_ALIGNMENT			= 16;
+
+
+//--------------------------------------------------------------------------------------------------
+// Followed by one 64-bit file offset per chunk (0 for default chunks), then the chunk data
+struct ChunkedHeatMapFileHeader
+{
+	char			m_fourCC[4]			= { 'H', 'M', 'A', 'P' };
+	unsigned int	m_version			= CHUNKED_HEAT_MAP_FILE_VERSION;
+	int				m_dimensionsX		= 0;
+	int				m_dimensionsY		= 0;
+	int				m_chunkSize			= HEAT_MAP_CHUNK_SIZE;
+	int				m_valueFormat		= HEAT_MAP_VALUE_FLOAT32;
+	float			m_defaultValue		= 0.f;
+	float			m_quantizedMin		= 0.f;
+	float			m_quantizedMax		= 1.f;
+	int				m_numChunks			= 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static int GetBytesPerValue(HeatMapValueFormat valueFormat)
+{
+	switch (valueFormat)
+	{
+	case HEAT_MAP_VALUE_FLOAT32:	return 4;
+	case HEAT_MAP_VALUE_UNORM16:	return 2;
+	case HEAT_MAP_VALUE_UNORM8:		return 1;
+	default:
+		ERROR_AND_DIE("Unknown heat map value format");
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ChunkedTileHeatMap::ChunkedTileHeatMap(IntVec2 const& dimensions, float defaultValue, HeatMapValueFormat valueFormat, FloatRange const& quantizedRange)
+	: m_dimensions(dimensions)
+	, m_valueFormat(valueFormat)
+	, m_quantizedRange(quantizedRange)
+{
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, "Chunked heat map needs positive dimensions");
+	m_bytesPerValue = GetBytesPerValue(valueFormat);
+	m_numChunks = IntVec2((dimensions.x + HEAT_MAP_CHUNK_SIZE - 1) >> HEAT_MAP_CHUNK_SIZE_LOG2, (dimensions.y + HEAT_MAP_CHUNK_SIZE - 1) >> HEAT_MAP_CHUNK_SIZE_LOG2);
+	m_chunks.resize(m_numChunks.x * m_numChunks.y, nullptr);
+	m_isChunkMapped.resize(m_chunks.size(), false);
+	SetAllValues(defaultValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ChunkedTileHeatMap::~ChunkedTileHeatMap()
+{
+	FreeAllChunks();
+	CloseMappedFile();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float ChunkedTileHeatMap::GetHeatValueAt(IntVec2 const& tileCoords) const
+{
+	unsigned char const* chunk = m_chunks[GetChunkIndex(tileCoords)];
+	return chunk ? DecodeValue(chunk, GetIndexInChunk(tileCoords)) : m_defaultValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ChunkedTileHeatMap::SetHeatValueAt(IntVec2 const& tileCoords, float heatValueToSet)
+{
+	int chunkIndex = GetChunkIndex(tileCoords);
+	if (!m_chunks[chunkIndex] && heatValueToSet == m_defaultValue)
+	{
+		return;
+	}
+	EncodeValue(GetChunkForWriting(chunkIndex), GetIndexInChunk(tileCoords), heatValueToSet);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ChunkedTileHeatMap::AddHeatValueAt(IntVec2 const& tileCoords, float heatValueToAdd)
+{
+	SetHeatValueAt(tileCoords, GetHeatValueAt(tileCoords) + heatValueToAdd);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Quantized maps keep the default value as it would read back, so default and written tiles compare equal
+void ChunkedTileHeatMap::SetAllValues(float resetValue)
+{
+	FreeAllChunks();
+	CloseMappedFile();
+
+	unsigned char encodedDefault[4];
+	EncodeValue(encodedDefault, 0, resetValue);
+	m_defaultValue = DecodeValue(encodedDefault, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ChunkedTileHeatMap::FreeDefaultChunks()
+{
+	unsigned char encodedDefault[4];
+	EncodeValue(encodedDefault, 0, m_defaultValue);
+
+	int numFreedChunks = 0;
+	for (int chunkIndex = 0; chunkIndex < (int)m_chunks.size(); ++chunkIndex)
+	{
+		unsigned char* chunk = m_chunks[chunkIndex];
+		if (!chunk)
+		{
+			continue;
+		}
+
+		bool isAllDefault = true;
+		for (int indexInChunk = 0; indexInChunk < HEAT_MAP_TILES_PER_CHUNK && isAllDefault; ++indexInChunk)
+		{
+			isAllDefault = memcmp(chunk + (indexInChunk * m_bytesPerValue), encodedDefault, m_bytesPerValue) == 0;
+		}
+
+		if (isAllDefault)
+		{
+			if (!m_isChunkMapped[chunkIndex])
+			{
+				delete[] chunk;
+			}
+			m_chunks[chunkIndex] = nullptr;
+			m_isChunkMapped[chunkIndex] = false;
+			++numFreedChunks;
+		}
+	}
+	return numFreedChunks;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+IntVec2 const& ChunkedTileHeatMap::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+IntVec2 const& ChunkedTileHeatMap::GetNumChunks() const
+{
+	return m_numChunks;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float ChunkedTileHeatMap::GetDefaultValue() const
+{
+	return m_defaultValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+HeatMapValueFormat ChunkedTileHeatMap::GetValueFormat() const
+{
+	return m_valueFormat;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ChunkedTileHeatMap::GetNumAllocatedChunks() const
+{
+	int numAllocatedChunks = 0;
+	for (int chunkIndex = 0; chunkIndex < (int)m_chunks.size(); ++chunkIndex)
+	{
+		if (m_chunks[chunkIndex] && !m_isChunkMapped[chunkIndex])
+		{
+			++numAllocatedChunks;
+		}
+	}
+	return numAllocatedChunks;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t ChunkedTileHeatMap::GetNumBytesAllocated() const
+{
+	size_t chunkTableBytes = m_chunks.size() * sizeof(unsigned char*);
+	return chunkTableBytes + ((size_t)GetNumAllocatedChunks() * (size_t)GetNumBytesPerChunk());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ChunkedTileHeatMap::CopyRegionToTileHeatMap(IntVec2 const& mins, TileHeatMap& out_heatMap) const
+{
+	for (int localY = 0; localY < out_heatMap.m_dimensions.y; ++localY)
+	{
+		for (int localX = 0; localX < out_heatMap.m_dimensions.x; ++localX)
+		{
+			IntVec2 tileCoords = mins + IntVec2(localX, localY);
+			bool isOnMap = tileCoords.x >= 0 && tileCoords.y >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y < m_dimensions.y;
+			out_heatMap.m_values[localX + (localY * out_heatMap.m_dimensions.x)] = isOnMap ? GetHeatValueAt(tileCoords) : m_defaultValue;
+		}
+	}
+	out_heatMap.MarkValuesChanged();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool ChunkedTileHeatMap::SaveToFile(std::string const& filePath) const
+{
+	FILE* fileStreamPtr = nullptr;
+	errno_t fOpenErr = fopen_s(&fileStreamPtr, filePath.c_str(), "wb");
+	if (fOpenErr || !fileStreamPtr)
+	{
+		return false;
+	}
+
+	ChunkedHeatMapFileHeader header;
+	header.m_dimensionsX = m_dimensions.x;
+	header.m_dimensionsY = m_dimensions.y;
+	header.m_valueFormat = m_valueFormat;
+	header.m_defaultValue = m_defaultValue;
+	header.m_quantizedMin = m_quantizedRange.m_min;
+	header.m_quantizedMax = m_quantizedRange.m_max;
+	header.m_numChunks = (int)m_chunks.size();
+
+	size_t chunkDataStart = sizeof(header) + (m_chunks.size() * sizeof(unsigned long long));
+	chunkDataStart = (chunkDataStart + CHUNK_FILE_ALIGNMENT - 1) & ~(CHUNK_FILE_ALIGNMENT - 1);
+	size_t numBytesPerChunk = (size_t)GetNumBytesPerChunk();
+	std::vector<unsigned long long> chunkOffsets(m_chunks.size(), 0);
+	unsigned long long nextChunkOffset = chunkDataStart;
+	for (int chunkIndex = 0; chunkIndex < (int)m_chunks.size(); ++chunkIndex)
+	{
+		if (m_chunks[chunkIndex])
+		{
+			chunkOffsets[chunkIndex] = nextChunkOffset;
+			nextChunkOffset += numBytesPerChunk;
+		}
+	}
+
+	bool wasWritten = fwrite(&header, sizeof(header), 1, fileStreamPtr) == 1;
+	wasWritten = wasWritten && fwrite(chunkOffsets.data(), sizeof(unsigned long long), chunkOffsets.size(), fileStreamPtr) == chunkOffsets.size();
+	unsigned char padding[CHUNK_FILE_ALIGNMENT] = {};
+	size_t numPaddingBytes = chunkDataStart - (sizeof(header) + (m_chunks.size() * sizeof(unsigned long long)));
+	wasWritten = wasWritten && fwrite(padding, 1, numPaddingBytes, fileStreamPtr) == numPaddingBytes;
+	for (int chunkIndex = 0; chunkIndex < (int)m_chunks.size() && wasWritten; ++chunkIndex)
+	{
+		if (m_chunks[chunkIndex])
+		{
+			wasWritten = fwrite(m_chunks[chunkIndex], 1, numBytesPerChunk, fileStreamPtr) == numBytesPerChunk;
+		}
+	}
+	fclose(fileStreamPtr);
+	return wasWritten;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool ChunkedTileHeatMap::LoadFromFile(std::string const& filePath)
+{
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	HANDLE fileMappingHandle = nullptr;
+	unsigned char const* mappedFileData = nullptr;
+	if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart >= (LONGLONG)sizeof(ChunkedHeatMapFileHeader))
+	{
+		fileMappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+	if (fileMappingHandle)
+	{
+		mappedFileData = (unsigned char const*)MapViewOfFile(fileMappingHandle, FILE_MAP_READ, 0, 0, 0);
+	}
+	if (!mappedFileData)
+	{
+		if (fileMappingHandle)
+		{
+			CloseHandle(fileMappingHandle);
+		}
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	ChunkedHeatMapFileHeader header;
+	memcpy(&header, mappedFileData, sizeof(header));
+	bool isHeaderValid = memcmp(header.m_fourCC, "HMAP", 4) == 0 && header.m_version == CHUNKED_HEAT_MAP_FILE_VERSION && header.m_chunkSize == HEAT_MAP_CHUNK_SIZE
+		&& header.m_dimensionsX > 0 && header.m_dimensionsY > 0 && header.m_valueFormat >= 0 && header.m_valueFormat < HEAT_MAP_VALUE_FORMAT_COUNT;
+	IntVec2 numChunks((header.m_dimensionsX + HEAT_MAP_CHUNK_SIZE - 1) >> HEAT_MAP_CHUNK_SIZE_LOG2, (header.m_dimensionsY + HEAT_MAP_CHUNK_SIZE - 1) >> HEAT_MAP_CHUNK_SIZE_LOG2);
+	isHeaderValid = isHeaderValid && header.m_numChunks == numChunks.x * numChunks.y;
+	isHeaderValid = isHeaderValid && (unsigned long long)fileSize.QuadPart >= sizeof(header) + ((unsigned long long)header.m_numChunks * sizeof(unsigned long long));
+
+	// Every stored chunk has to lie inside the file; this is checked before anything is replaced
+	unsigned long long const* chunkOffsets = (unsigned long long const*)(mappedFileData + sizeof(header));
+	unsigned long long numBytesPerChunk = isHeaderValid ? (unsigned long long)(HEAT_MAP_TILES_PER_CHUNK * GetBytesPerValue((HeatMapValueFormat)header.m_valueFormat)) : 0;
+	for (int chunkIndex = 0; isHeaderValid && chunkIndex < header.m_numChunks; ++chunkIndex)
+	{
+		unsigned long long chunkOffset = chunkOffsets[chunkIndex];
+		isHeaderValid = chunkOffset == 0 || (chunkOffset <= (unsigned long long)fileSize.QuadPart && numBytesPerChunk <= (unsigned long long)fileSize.QuadPart - chunkOffset);
+	}
+	if (!isHeaderValid)
+	{
+		UnmapViewOfFile(mappedFileData);
+		CloseHandle(fileMappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	FreeAllChunks();
+	CloseMappedFile();
+	m_dimensions = IntVec2(header.m_dimensionsX, header.m_dimensionsY);
+	m_numChunks = numChunks;
+	m_valueFormat = (HeatMapValueFormat)header.m_valueFormat;
+	m_bytesPerValue = GetBytesPerValue(m_valueFormat);
+	m_defaultValue = header.m_defaultValue;
+	m_quantizedRange = FloatRange(header.m_quantizedMin, header.m_quantizedMax);
+	m_fileHandle = fileHandle;
+	m_fileMappingHandle = fileMappingHandle;
+	m_mappedFileData = mappedFileData;
+
+	// Mapped chunks are only ever read; GetChunkForWriting() copies them before any write
+	m_chunks.assign(header.m_numChunks, nullptr);
+	m_isChunkMapped.assign(header.m_numChunks, false);
+	for (int chunkIndex = 0; chunkIndex < header.m_numChunks; ++chunkIndex)
+	{
+		unsigned long long chunkOffset = chunkOffsets[chunkIndex];
+		if (chunkOffset != 0)
+		{
+			m_chunks[chunkIndex] = const_cast<unsigned char*>(mappedFileData + chunkOffset);
+			m_isChunkMapped[chunkIndex] = true;
+		}
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ChunkedTileHeatMap::GetChunkIndex(IntVec2 const& tileCoords) const
+{
+	return (tileCoords.x >> HEAT_MAP_CHUNK_SIZE_LOG2) + ((tileCoords.y >> HEAT_MAP_CHUNK_SIZE_LOG2) * m_numChunks.x);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ChunkedTileHeatMap::GetIndexInChunk(IntVec2 const& tileCoords) const
+{
+	return (tileCoords.x & (HEAT_MAP_CHUNK_SIZE - 1)) + ((tileCoords.y & (HEAT_MAP_CHUNK_SIZE - 1)) << HEAT_MAP_CHUNK_SIZE_LOG2);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ChunkedTileHeatMap::GetNumBytesPerChunk() const
+{
+	return HEAT_MAP_TILES_PER_CHUNK * m_bytesPerValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Default chunks are filled with the default value, and mapped chunks are copied, before the first write
+unsigned char* ChunkedTileHeatMap::GetChunkForWriting(int chunkIndex)
+{
+	unsigned char* chunk = m_chunks[chunkIndex];
+	if (chunk && !m_isChunkMapped[chunkIndex])
+	{
+		return chunk;
+	}
+
+	unsigned char* newChunk = new unsigned char[GetNumBytesPerChunk()];
+	if (chunk)
+	{
+		memcpy(newChunk, chunk, GetNumBytesPerChunk());
+	}
+	else
+	{
+		EncodeValue(newChunk, 0, m_defaultValue);
+		for (int indexInChunk = 1; indexInChunk < HEAT_MAP_TILES_PER_CHUNK; ++indexInChunk)
+		{
+			memcpy(newChunk + (indexInChunk * m_bytesPerValue), newChunk, m_bytesPerValue);
+		}
+	}
+	m_chunks[chunkIndex] = newChunk;
+	m_isChunkMapped[chunkIndex] = false;
+	return newChunk;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float ChunkedTileHeatMap::DecodeValue(unsigned char const* chunk, int indexInChunk) const
+{
+	float range = m_quantizedRange.m_max - m_quantizedRange.m_min;
+	switch (m_valueFormat)
+	{
+	case HEAT_MAP_VALUE_UNORM16:
+	{
+		unsigned short quantizedValue;
+		memcpy(&quantizedValue, chunk + (indexInChunk * 2), 2);
+		return m_quantizedRange.m_min + (((float)quantizedValue * (1.f / 65535.f)) * range);
+	}
+	case HEAT_MAP_VALUE_UNORM8:
+		return m_quantizedRange.m_min + (((float)chunk[indexInChunk] * (1.f / 255.f)) * range);
+	default:
+	{
+		float value;
+		memcpy(&value, chunk + (indexInChunk * 4), 4);
+		return value;
+	}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Quantized values are clamped to the quantized range and rounded to the nearest step
+void ChunkedTileHeatMap::EncodeValue(unsigned char* chunk, int indexInChunk, float value) const
+{
+	if (m_valueFormat == HEAT_MAP_VALUE_FLOAT32)
+	{
+		memcpy(chunk + (indexInChunk * 4), &value, 4);
+		return;
+	}
+
+	float range = m_quantizedRange.m_max - m_quantizedRange.m_min;
+	float fraction = range != 0.f ? (value - m_quantizedRange.m_min) / range : 0.f;
+	fraction = fraction < 0.f ? 0.f : (fraction > 1.f ? 1.f : fraction);
+	if (m_valueFormat == HEAT_MAP_VALUE_UNORM16)
+	{
+		unsigned short quantizedValue = (unsigned short)((fraction * 65535.f) + 0.5f);
+		memcpy(chunk + (indexInChunk * 2), &quantizedValue, 2);
+	}
+	else
+	{
+		chunk[indexInChunk] = (unsigned char)((fraction * 255.f) + 0.5f);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ChunkedTileHeatMap::FreeAllChunks()
+{
+	for (int chunkIndex = 0; chunkIndex < (int)m_chunks.size(); ++chunkIndex)
+	{
+		if (!m_isChunkMapped[chunkIndex])
+		{
+			delete[] m_chunks[chunkIndex];
+		}
+		m_chunks[chunkIndex] = nullptr;
+		m_isChunkMapped[chunkIndex] = false;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ChunkedTileHeatMap::CloseMappedFile()
+{
+	if (m_mappedFileData)
+	{
+		UnmapViewOfFile(m_mappedFileData);
+		m_mappedFileData = nullptr;
+	}
+	if (m_fileMappingHandle)
+	{
+		CloseHandle(m_fileMappingHandle);
+		m_fileMappingHandle = nullptr;
+	}
+	if (m_fileHandle)
+	{
+		CloseHandle(m_fileHandle);
+		m_fileHandle = nullptr;
+	}
+}
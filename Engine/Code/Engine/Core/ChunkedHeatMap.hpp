@@ -0,0 +1,87 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/FloatRange.hpp"
+
+#include <string>
+#include <vector>
+
+class TileHeatMap;
+
+
+//--------------------------------------------------------------------------------------------------
+enum HeatMapValueFormat : unsigned char
+{
+	HEAT_MAP_VALUE_FLOAT32,
+	HEAT_MAP_VALUE_UNORM16,	// Quantized across the map's quantized range
+	HEAT_MAP_VALUE_UNORM8,
+
+	HEAT_MAP_VALUE_FORMAT_COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int HEAT_MAP_CHUNK_SIZE_LOG2		= 6;
+constexpr int HEAT_MAP_CHUNK_SIZE			= 1 << HEAT_MAP_CHUNK_SIZE_LOG2;	// Tiles per side of a chunk
+constexpr int HEAT_MAP_TILES_PER_CHUNK		= HEAT_MAP_CHUNK_SIZE * HEAT_MAP_CHUNK_SIZE;
+
+
+//--------------------------------------------------------------------------------------------------
+// Heat map for worlds too big for a dense TileHeatMap. Tiles are stored in 64x64 chunks, found
+// with a shift and a table lookup, and chunks that have never been written hold no memory at all:
+// they read as the default value and are only allocated on their first write (copy-on-write).
+// Values can be quantized to 16 or 8 bits across a fixed range to save more.
+//
+// LoadFromFile() memory-maps the saved file instead of reading it, so a huge map opens instantly
+// and the OS pages chunks in as they are first read. Writing to a mapped chunk copies it to the heap.
+//--------------------------------------------------------------------------------------------------
+class ChunkedTileHeatMap
+{
+public:
+	explicit ChunkedTileHeatMap(IntVec2 const& dimensions, float defaultValue = 0.f, HeatMapValueFormat valueFormat = HEAT_MAP_VALUE_FLOAT32, FloatRange const& quantizedRange = FloatRange(0.f, 1.f));
+	~ChunkedTileHeatMap();
+	ChunkedTileHeatMap(ChunkedTileHeatMap const& copyFrom) = delete;
+	void operator=(ChunkedTileHeatMap const& copyFrom) = delete;
+
+	float	GetHeatValueAt(IntVec2 const& tileCoords) const;
+	void	SetHeatValueAt(IntVec2 const& tileCoords, float heatValueToSet);
+	void	AddHeatValueAt(IntVec2 const& tileCoords, float heatValueToAdd);
+	void	SetAllValues(float resetValue);	// Also frees every chunk
+	int		FreeDefaultChunks();			// Frees chunks whose tiles all hold the default value again; returns how many
+
+	IntVec2 const&		GetDimensions() const;
+	IntVec2 const&		GetNumChunks() const;
+	float				GetDefaultValue() const;
+	HeatMapValueFormat	GetValueFormat() const;
+	int					GetNumAllocatedChunks() const;	// Heap chunks only; mapped chunks belong to the OS
+	size_t				GetNumBytesAllocated() const;
+
+	// Fills out_heatMap (at its own dimensions) with the tiles starting at mins; tiles off this map read as the default value
+	void	CopyRegionToTileHeatMap(IntVec2 const& mins, TileHeatMap& out_heatMap) const;
+
+	// Only chunks that have been written are saved. Don't save over the file this map is currently mapped from.
+	bool	SaveToFile(std::string const& filePath) const;
+	bool	LoadFromFile(std::string const& filePath);
+
+private:
+	int				GetChunkIndex(IntVec2 const& tileCoords) const;
+	int				GetIndexInChunk(IntVec2 const& tileCoords) const;
+	int				GetNumBytesPerChunk() const;
+	unsigned char*	GetChunkForWriting(int chunkIndex);
+	float			DecodeValue(unsigned char const* chunk, int indexInChunk) const;
+	void			EncodeValue(unsigned char* chunk, int indexInChunk, float value) const;
+	void			FreeAllChunks();
+	void			CloseMappedFile();
+
+private:
+	IntVec2						m_dimensions;
+	IntVec2						m_numChunks;
+	float						m_defaultValue		= 0.f;
+	HeatMapValueFormat			m_valueFormat		= HEAT_MAP_VALUE_FLOAT32;
+	FloatRange					m_quantizedRange;
+	int							m_bytesPerValue		= 4;
+	std::vector<unsigned char*>	m_chunks;					// nullptr: every tile in the chunk holds the default value
+	std::vector<bool>			m_isChunkMapped;			// Points into the mapped file, which is read-only
+	void*						m_fileHandle		= nullptr;
+	void*						m_fileMappingHandle	= nullptr;
+	unsigned char const*		m_mappedFileData	= nullptr;
+};
@@ -1,4 +1,8 @@
 #include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <xmmintrin.h>
 
 TileHeatMap::TileHeatMap(IntVec2 const& dimensions, float defaultValue) :
 	m_dimensions(dimensions)
@@ -16,20 +20,530 @@ float TileHeatMap::GetHeatValueAt(IntVec2 const& tileCoords) const
 
 void TileHeatMap::SetAllValues(float resetValue)
 {
-	for (int tileIndex = 0; tileIndex < (int)m_values.size(); ++tileIndex)
+	__m128 resetValues = _mm_set1_ps(resetValue);
+	float* values = m_values.data();
+	int numTiles = (int)m_values.size();
+	int tileIndex = 0;
+	for (; tileIndex + 4 <= numTiles; tileIndex += 4)
+	{
+		_mm_storeu_ps(values + tileIndex, resetValues);
+	}
+	for (; tileIndex < numTiles; ++tileIndex)
 	{
-		m_values[tileIndex] = resetValue;
+		values[tileIndex] = resetValue;
 	}
+	MarkValuesChanged();
 }
 
 void TileHeatMap::SetHeatValueAt(IntVec2 const& tileCoords, float heatValueToSet)
 {
 	int tileIndex = tileCoords.x + (tileCoords.y * m_dimensions.x);
 	m_values[tileIndex] = heatValueToSet;
+	MarkValuesChanged(tileCoords.y);
 }
 
 void TileHeatMap::AddHeatValueAt(IntVec2 const& tileCoords, float heatValueToAdd)
 {
 	int tileIndex = tileCoords.x + (tileCoords.y * m_dimensions.x);
 	m_values[tileIndex] += heatValueToAdd;
+	MarkValuesChanged(tileCoords.y);
+}
+
+GridRaycastResult2D TileHeatMap::Raycast(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, float minSolidHeatValue) const
+{
+	auto IsTileSolid = [this, minSolidHeatValue](IntVec2 const& tileCoords)
+	{
+		return m_values[tileCoords.x + (tileCoords.y * m_dimensions.x)] >= minSolidHeatValue;
+	};
+	return RaycastVsGrid2D(startPos, fwdNormal, maxDist, m_dimensions, IsTileSolid);
+}
+
+// The searches run on a copy of the map with a one-tile border, where blocked and border tiles are -1;
+// a blocked neighbor then never looks closer than its current distance, so no bounds or blocker checks are needed
+static void StartPaddedDistanceField(IntVec2 const& dimensions, std::vector<IntVec2> const& seedTiles, bool seedBlockedTiles, std::vector<float>& out_paddedDists, std::vector<int>& out_seedPaddedIndexes)
+{
+	int paddedWidth = dimensions.x + 2;
+	for (int seedNum = 0; seedNum < (int)seedTiles.size(); ++seedNum)
+	{
+		IntVec2 const& seedCoords = seedTiles[seedNum];
+		if (seedCoords.x < 0 || seedCoords.y < 0 || seedCoords.x >= dimensions.x || seedCoords.y >= dimensions.y)
+		{
+			continue;
+		}
+
+		int paddedIndex = (seedCoords.x + 1) + ((seedCoords.y + 1) * paddedWidth);
+		// Blocked seeds (-1) are skipped unless asked for, and duplicate seeds (0) are only queued once
+		float paddedDist = out_paddedDists[paddedIndex];
+		if (paddedDist > 0.f || (seedBlockedTiles && paddedDist < 0.f))
+		{
+			out_paddedDists[paddedIndex] = 0.f;
+			out_seedPaddedIndexes.push_back(paddedIndex);
+		}
+	}
+}
+
+static void CopyPaddedDistancesToHeatMap(std::vector<float> const& paddedDists, float maxCost, TileHeatMap& heatMap)
+{
+	int paddedWidth = heatMap.m_dimensions.x + 2;
+	for (int tileY = 0; tileY < heatMap.m_dimensions.y; ++tileY)
+	{
+		float const* paddedRow = &paddedDists[((tileY + 1) * paddedWidth) + 1];
+		float* heatRow = &heatMap.m_values[tileY * heatMap.m_dimensions.x];
+		for (int tileX = 0; tileX < heatMap.m_dimensions.x; ++tileX)
+		{
+			heatRow[tileX] = paddedRow[tileX] < 0.f ? maxCost : paddedRow[tileX];
+		}
+	}
+	heatMap.MarkValuesChanged();
+}
+
+void TileHeatMap::GenerateDistanceField(std::vector<bool> const& isTileBlocked, std::vector<IntVec2> const& seedTiles, float maxCost, bool seedBlockedTiles)
+{
+	GUARANTEE_OR_DIE(isTileBlocked.size() == m_values.size(), "Blocked tile list must match the heat map's dimensions");
+
+	int paddedWidth = m_dimensions.x + 2;
+	std::vector<float> paddedDists(paddedWidth * (m_dimensions.y + 2), -1.f);
+	for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+	{
+		float* paddedRow = &paddedDists[((tileY + 1) * paddedWidth) + 1];
+		int rowStartIndex = tileY * m_dimensions.x;
+		for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+		{
+			paddedRow[tileX] = isTileBlocked[rowStartIndex + tileX] ? -1.f : maxCost;
+		}
+	}
+
+	// Every step costs 1, so tiles come off a FIFO queue in distance order
+	std::vector<int> tileQueue;
+	tileQueue.reserve(m_values.size());
+	StartPaddedDistanceField(m_dimensions, seedTiles, seedBlockedTiles, paddedDists, tileQueue);
+
+	int const neighborOffsets[4] = { 1, -1, paddedWidth, -paddedWidth };
+	for (int queueIndex = 0; queueIndex < (int)tileQueue.size(); ++queueIndex)
+	{
+		int paddedIndex = tileQueue[queueIndex];
+		float neighborDist = paddedDists[paddedIndex] + 1.f;
+		if (neighborDist >= maxCost)
+		{
+			continue;
+		}
+
+		for (int neighborNum = 0; neighborNum < 4; ++neighborNum)
+		{
+			int neighborIndex = paddedIndex + neighborOffsets[neighborNum];
+			if (neighborDist < paddedDists[neighborIndex])
+			{
+				paddedDists[neighborIndex] = neighborDist;
+				tileQueue.push_back(neighborIndex);
+			}
+		}
+	}
+
+	CopyPaddedDistancesToHeatMap(paddedDists, maxCost, *this);
+}
+
+void TileHeatMap::GenerateDistanceField(std::vector<unsigned char> const& tileStepCosts, std::vector<IntVec2> const& seedTiles, float maxCost, bool seedBlockedTiles)
+{
+	GUARANTEE_OR_DIE(tileStepCosts.size() == m_values.size(), "Tile step cost list must match the heat map's dimensions");
+
+	int paddedWidth = m_dimensions.x + 2;
+	std::vector<float> paddedDists(paddedWidth * (m_dimensions.y + 2), -1.f);
+	std::vector<unsigned char> paddedStepCosts(paddedDists.size(), 0);
+	int maxStepCost = 1;
+	for (int tileY = 0; tileY < m_dimensions.y; ++tileY)
+	{
+		int paddedRowStartIndex = ((tileY + 1) * paddedWidth) + 1;
+		int rowStartIndex = tileY * m_dimensions.x;
+		for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+		{
+			unsigned char stepCost = tileStepCosts[rowStartIndex + tileX];
+			paddedDists[paddedRowStartIndex + tileX] = stepCost == 0 ? -1.f : maxCost;
+			paddedStepCosts[paddedRowStartIndex + tileX] = stepCost;
+			maxStepCost = stepCost > maxStepCost ? stepCost : maxStepCost;
+		}
+	}
+
+	// Path costs are whole numbers, and a tile's neighbors are at most maxStepCost further away than it is,
+	// so a ring of maxStepCost + 1 buckets holds every queued tile; bucket N holds tiles at distances N, N + ring size...
+	int numBuckets = maxStepCost + 1;
+	std::vector<std::vector<int>> buckets(numBuckets);
+	StartPaddedDistanceField(m_dimensions, seedTiles, seedBlockedTiles, paddedDists, buckets[0]);
+	int numQueuedTiles = (int)buckets[0].size();
+
+	int const neighborOffsets[4] = { 1, -1, paddedWidth, -paddedWidth };
+	for (int currentDist = 0; numQueuedTiles > 0; ++currentDist)
+	{
+		// Steps cost 1 to maxStepCost, so nothing gets queued into the bucket being processed
+		std::vector<int>& currentTiles = buckets[currentDist % numBuckets];
+		numQueuedTiles -= (int)currentTiles.size();
+		for (int paddedIndex : currentTiles)
+		{
+			if (paddedDists[paddedIndex] != (float)currentDist)
+			{
+				continue; // Queued again since, at a shorter distance
+			}
+
+			for (int neighborNum = 0; neighborNum < 4; ++neighborNum)
+			{
+				int neighborIndex = paddedIndex + neighborOffsets[neighborNum];
+				int neighborDist = currentDist + paddedStepCosts[neighborIndex];
+				if ((float)neighborDist < paddedDists[neighborIndex] && (float)neighborDist < maxCost)
+				{
+					paddedDists[neighborIndex] = (float)neighborDist;
+					buckets[neighborDist % numBuckets].push_back(neighborIndex);
+					++numQueuedTiles;
+				}
+			}
+		}
+		currentTiles.clear();
+	}
+
+	CopyPaddedDistancesToHeatMap(paddedDists, maxCost, *this);
+}
+
+class DistanceFieldJob : public Job
+{
+public:
+	DistanceFieldJob(DistanceFieldRequest const& request) :
+		m_request(request)
+	{};
+	virtual void Execute() override
+	{
+		if (m_request.m_tileStepCosts)
+		{
+			m_request.m_heatMap->GenerateDistanceField(*m_request.m_tileStepCosts, m_request.m_seedTiles, m_request.m_maxCost, m_request.m_seedBlockedTiles);
+		}
+		else
+		{
+			m_request.m_heatMap->GenerateDistanceField(*m_request.m_isTileBlocked, m_request.m_seedTiles, m_request.m_maxCost, m_request.m_seedBlockedTiles);
+		}
+	}
+
+	DistanceFieldRequest const& m_request;
+};
+
+void TileHeatMap::GenerateDistanceFields(std::vector<DistanceFieldRequest> const& requests, bool useJobSystem)
+{
+	std::vector<Job*> jobs;
+	for (int requestIndex = 0; requestIndex < (int)requests.size(); ++requestIndex)
+	{
+		GUARANTEE_OR_DIE(requests[requestIndex].m_isTileBlocked || requests[requestIndex].m_tileStepCosts, "Distance field request has no blocked tiles or step costs");
+		jobs.push_back(new DistanceFieldJob(requests[requestIndex]));
+	}
+
+	if (useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0 && jobs.size() > 1)
+	{
+		g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+	}
+	else
+	{
+		for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+		{
+			jobs[jobIndex]->Execute();
+		}
+	}
+
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+}
+
+// Applies the four-wide operation to values (paired with otherValues, if any), then the scalar one to the leftovers
+template<typename SimdOperation, typename ScalarOperation>
+static void ApplyToValues(float* values, float const* otherValues, int numValues, SimdOperation simdOperation, ScalarOperation scalarOperation)
+{
+	int valueIndex = 0;
+	for (; valueIndex + 4 <= numValues; valueIndex += 4)
+	{
+		__m128 otherFour = otherValues ? _mm_loadu_ps(otherValues + valueIndex) : _mm_setzero_ps();
+		_mm_storeu_ps(values + valueIndex, simdOperation(_mm_loadu_ps(values + valueIndex), otherFour));
+	}
+	for (; valueIndex < numValues; ++valueIndex)
+	{
+		values[valueIndex] = scalarOperation(values[valueIndex], otherValues ? otherValues[valueIndex] : 0.f);
+	}
+}
+
+// Min, max and sum of values, keeping four running lanes and combining them at the end
+static void GetValueStats(float const* values, int numValues, float& out_min, float& out_max, double& out_sum)
+{
+	__m128 mins = _mm_set1_ps(FLT_MAX);
+	__m128 maxs = _mm_set1_ps(-FLT_MAX);
+	__m128 sums = _mm_setzero_ps();
+	int valueIndex = 0;
+	double sum = 0.0;
+	for (; valueIndex + 4 <= numValues; valueIndex += 4)
+	{
+		__m128 fourValues = _mm_loadu_ps(values + valueIndex);
+		mins = _mm_min_ps(mins, fourValues);
+		maxs = _mm_max_ps(maxs, fourValues);
+		sums = _mm_add_ps(sums, fourValues);
+		if ((valueIndex & 1023) == 1020)
+		{
+			// Flush the float lanes into a double now and then so long rows don't lose precision
+			float laneSums[4];
+			_mm_storeu_ps(laneSums, sums);
+			sum += (double)laneSums[0] + (double)laneSums[1] + (double)laneSums[2] + (double)laneSums[3];
+			sums = _mm_setzero_ps();
+		}
+	}
+
+	float laneMins[4];
+	float laneMaxs[4];
+	float laneSums[4];
+	_mm_storeu_ps(laneMins, mins);
+	_mm_storeu_ps(laneMaxs, maxs);
+	_mm_storeu_ps(laneSums, sums);
+	float minValue = laneMins[0];
+	float maxValue = laneMaxs[0];
+	for (int lane = 1; lane < 4; ++lane)
+	{
+		minValue = laneMins[lane] < minValue ? laneMins[lane] : minValue;
+		maxValue = laneMaxs[lane] > maxValue ? laneMaxs[lane] : maxValue;
+	}
+	sum += (double)laneSums[0] + (double)laneSums[1] + (double)laneSums[2] + (double)laneSums[3];
+
+	for (; valueIndex < numValues; ++valueIndex)
+	{
+		minValue = values[valueIndex] < minValue ? values[valueIndex] : minValue;
+		maxValue = values[valueIndex] > maxValue ? values[valueIndex] : maxValue;
+		sum += (double)values[valueIndex];
+	}
+	out_min = minValue;
+	out_max = maxValue;
+	out_sum = sum;
+}
+
+void TileHeatMap::AddToAllValues(float valueToAdd)
+{
+	__m128 valuesToAdd = _mm_set1_ps(valueToAdd);
+	ApplyToValues(m_values.data(), nullptr, (int)m_values.size(),
+		[valuesToAdd](__m128 values, __m128) { return _mm_add_ps(values, valuesToAdd); },
+		[valueToAdd](float value, float) { return value + valueToAdd; });
+	MarkValuesChanged();
+}
+
+void TileHeatMap::ScaleAllValues(float scale)
+{
+	__m128 scales = _mm_set1_ps(scale);
+	ApplyToValues(m_values.data(), nullptr, (int)m_values.size(),
+		[scales](__m128 values, __m128) { return _mm_mul_ps(values, scales); },
+		[scale](float value, float) { return value * scale; });
+	MarkValuesChanged();
+}
+
+void TileHeatMap::ClampAllValues(float minValue, float maxValue)
+{
+	__m128 minValues = _mm_set1_ps(minValue);
+	__m128 maxValues = _mm_set1_ps(maxValue);
+	ApplyToValues(m_values.data(), nullptr, (int)m_values.size(),
+		[minValues, maxValues](__m128 values, __m128) { return _mm_min_ps(_mm_max_ps(values, minValues), maxValues); },
+		[minValue, maxValue](float value, float) { return value < minValue ? minValue : (value > maxValue ? maxValue : value); });
+	MarkValuesChanged();
+}
+
+void TileHeatMap::AddValuesFrom(TileHeatMap const& otherMap, float scale)
+{
+	GUARANTEE_OR_DIE(otherMap.m_values.size() == m_values.size(), "Heat maps must have the same dimensions");
+	__m128 scales = _mm_set1_ps(scale);
+	ApplyToValues(m_values.data(), otherMap.m_values.data(), (int)m_values.size(),
+		[scales](__m128 values, __m128 otherValues) { return _mm_add_ps(values, _mm_mul_ps(otherValues, scales)); },
+		[scale](float value, float otherValue) { return value + (otherValue * scale); });
+	MarkValuesChanged();
+}
+
+void TileHeatMap::BlendWith(TileHeatMap const& otherMap, float fractionTowardOther)
+{
+	GUARANTEE_OR_DIE(otherMap.m_values.size() == m_values.size(), "Heat maps must have the same dimensions");
+	__m128 fractions = _mm_set1_ps(fractionTowardOther);
+	ApplyToValues(m_values.data(), otherMap.m_values.data(), (int)m_values.size(),
+		[fractions](__m128 values, __m128 otherValues) { return _mm_add_ps(values, _mm_mul_ps(_mm_sub_ps(otherValues, values), fractions)); },
+		[fractionTowardOther](float value, float otherValue) { return value + ((otherValue - value) * fractionTowardOther); });
+	MarkValuesChanged();
+}
+
+float TileHeatMap::GetMinValue() const
+{
+	float minValue = 0.f;
+	float maxValue = 0.f;
+	double sum = 0.0;
+	GetValueStats(m_values.data(), (int)m_values.size(), minValue, maxValue, sum);
+	return minValue;
+}
+
+float TileHeatMap::GetMaxValue() const
+{
+	float minValue = 0.f;
+	float maxValue = 0.f;
+	double sum = 0.0;
+	GetValueStats(m_values.data(), (int)m_values.size(), minValue, maxValue, sum);
+	return maxValue;
+}
+
+float TileHeatMap::GetSumOfValues() const
+{
+	float minValue = 0.f;
+	float maxValue = 0.f;
+	double sum = 0.0;
+	GetValueStats(m_values.data(), (int)m_values.size(), minValue, maxValue, sum);
+	return (float)sum;
+}
+
+IntVec2 TileHeatMap::GetCoordsOfMinValue() const
+{
+	float minValue = GetMinValue();
+	for (int tileIndex = 0; tileIndex < (int)m_values.size(); ++tileIndex)
+	{
+		if (m_values[tileIndex] == minValue)
+		{
+			return IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+		}
+	}
+	return IntVec2(-1, -1);
+}
+
+IntVec2 TileHeatMap::GetCoordsOfMaxValue() const
+{
+	float maxValue = GetMaxValue();
+	for (int tileIndex = 0; tileIndex < (int)m_values.size(); ++tileIndex)
+	{
+		if (m_values[tileIndex] == maxValue)
+		{
+			return IntVec2(tileIndex % m_dimensions.x, tileIndex / m_dimensions.x);
+		}
+	}
+	return IntVec2(-1, -1);
+}
+
+// Clamps a region to the map; returns false if nothing is left
+static bool ClampRegionToMap(IntVec2 const& dimensions, IntVec2 const& mins, IntVec2 const& maxs, IntVec2& out_mins, IntVec2& out_maxs)
+{
+	out_mins = IntVec2(mins.x > 0 ? mins.x : 0, mins.y > 0 ? mins.y : 0);
+	out_maxs = IntVec2(maxs.x < dimensions.x - 1 ? maxs.x : dimensions.x - 1, maxs.y < dimensions.y - 1 ? maxs.y : dimensions.y - 1);
+	return out_mins.x <= out_maxs.x && out_mins.y <= out_maxs.y;
+}
+
+float TileHeatMap::GetSumInRegion(IntVec2 const& mins, IntVec2 const& maxs) const
+{
+	IntVec2 regionMins;
+	IntVec2 regionMaxs;
+	if (!ClampRegionToMap(m_dimensions, mins, maxs, regionMins, regionMaxs))
+	{
+		return 0.f;
+	}
+
+	if (IsSummedAreaTableUpToDate())
+	{
+		int tableWidth = m_dimensions.x + 1;
+		double sum = m_summedAreaTable[(regionMaxs.x + 1) + ((regionMaxs.y + 1) * tableWidth)]
+			- m_summedAreaTable[regionMins.x + ((regionMaxs.y + 1) * tableWidth)]
+			- m_summedAreaTable[(regionMaxs.x + 1) + (regionMins.y * tableWidth)]
+			+ m_summedAreaTable[regionMins.x + (regionMins.y * tableWidth)];
+		return (float)sum;
+	}
+
+	double sum = 0.0;
+	for (int tileY = regionMins.y; tileY <= regionMaxs.y; ++tileY)
+	{
+		float rowMin = 0.f;
+		float rowMax = 0.f;
+		double rowSum = 0.0;
+		GetValueStats(&m_values[regionMins.x + (tileY * m_dimensions.x)], 1 + regionMaxs.x - regionMins.x, rowMin, rowMax, rowSum);
+		sum += rowSum;
+	}
+	return (float)sum;
+}
+
+float TileHeatMap::GetMinInRegion(IntVec2 const& mins, IntVec2 const& maxs) const
+{
+	IntVec2 regionMins;
+	IntVec2 regionMaxs;
+	if (!ClampRegionToMap(m_dimensions, mins, maxs, regionMins, regionMaxs))
+	{
+		return 0.f;
+	}
+
+	float minValue = FLT_MAX;
+	for (int tileY = regionMins.y; tileY <= regionMaxs.y; ++tileY)
+	{
+		float rowMin = 0.f;
+		float rowMax = 0.f;
+		double rowSum = 0.0;
+		GetValueStats(&m_values[regionMins.x + (tileY * m_dimensions.x)], 1 + regionMaxs.x - regionMins.x, rowMin, rowMax, rowSum);
+		minValue = rowMin < minValue ? rowMin : minValue;
+	}
+	return minValue;
+}
+
+float TileHeatMap::GetMaxInRegion(IntVec2 const& mins, IntVec2 const& maxs) const
+{
+	IntVec2 regionMins;
+	IntVec2 regionMaxs;
+	if (!ClampRegionToMap(m_dimensions, mins, maxs, regionMins, regionMaxs))
+	{
+		return 0.f;
+	}
+
+	float maxValue = -FLT_MAX;
+	for (int tileY = regionMins.y; tileY <= regionMaxs.y; ++tileY)
+	{
+		float rowMin = 0.f;
+		float rowMax = 0.f;
+		double rowSum = 0.0;
+		GetValueStats(&m_values[regionMins.x + (tileY * m_dimensions.x)], 1 + regionMaxs.x - regionMins.x, rowMin, rowMax, rowSum);
+		maxValue = rowMax > maxValue ? rowMax : maxValue;
+	}
+	return maxValue;
+}
+
+void TileHeatMap::EnableSummedAreaTable(bool isEnabled)
+{
+	m_isSummedAreaTableEnabled = isEnabled;
+	if (!isEnabled)
+	{
+		m_summedAreaTable.clear();
+		m_summedAreaTable.shrink_to_fit();
+	}
+	MarkValuesChanged();
+}
+
+// Rows above the first dirty row are untouched, so only the rest is re-accumulated
+void TileHeatMap::UpdateSummedAreaTable()
+{
+	if (!m_isSummedAreaTableEnabled || IsSummedAreaTableUpToDate())
+	{
+		return;
+	}
+
+	int tableWidth = m_dimensions.x + 1;
+	if (m_summedAreaTable.size() != (size_t)(tableWidth * (m_dimensions.y + 1)))
+	{
+		m_summedAreaTable.assign(tableWidth * (m_dimensions.y + 1), 0.0);
+		m_summedAreaTableFirstDirtyRow = 0;
+	}
+
+	for (int tileY = m_summedAreaTableFirstDirtyRow; tileY < m_dimensions.y; ++tileY)
+	{
+		double const* rowBelow = &m_summedAreaTable[tileY * tableWidth];
+		double* row = &m_summedAreaTable[(tileY + 1) * tableWidth];
+		float const* values = &m_values[tileY * m_dimensions.x];
+		double rowSumSoFar = 0.0;
+		for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+		{
+			rowSumSoFar += (double)values[tileX];
+			row[tileX + 1] = rowBelow[tileX + 1] + rowSumSoFar;
+		}
+	}
+	m_summedAreaTableFirstDirtyRow = m_dimensions.y;
+}
+
+void TileHeatMap::MarkValuesChanged(int firstChangedRow)
+{
+	m_summedAreaTableFirstDirtyRow = firstChangedRow < m_summedAreaTableFirstDirtyRow ? firstChangedRow : m_summedAreaTableFirstDirtyRow;
+}
+
+bool TileHeatMap::IsSummedAreaTableUpToDate() const
+{
+	return m_isSummedAreaTableEnabled && m_summedAreaTableFirstDirtyRow >= m_dimensions.y;
 }
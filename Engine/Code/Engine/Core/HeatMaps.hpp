@@ -1,9 +1,24 @@
 #pragma once
 #include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
 
 #include <vector>
+#include <float.h>
 
 struct IntVec2;
+class TileHeatMap;
+
+//--------------------------------------------------------------------------------------------------
+// One distance field for TileHeatMap::GenerateDistanceFields(); set either m_isTileBlocked or m_tileStepCosts
+struct DistanceFieldRequest
+{
+	TileHeatMap*						m_heatMap = nullptr;
+	std::vector<bool> const*			m_isTileBlocked = nullptr;
+	std::vector<unsigned char> const*	m_tileStepCosts = nullptr;
+	std::vector<IntVec2>				m_seedTiles;
+	float								m_maxCost = FLT_MAX;
+	bool								m_seedBlockedTiles = false;
+};
 
 class TileHeatMap
 {
@@ -15,7 +30,54 @@ public:
 	void SetAllValues(float resetValue);
 	void SetHeatValueAt(IntVec2 const& tileCoords, float heatValueToSet);
 	void AddHeatValueAt(IntVec2 const& tileCoords, float heatValueToAdd);
+
+	// Tiles with a heat value of at least minSolidHeatValue block the ray
+	GridRaycastResult2D Raycast(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, float minSolidHeatValue) const;
+
+	// Dijkstra maps: every tile gets the cost of the cheapest 4-way path to the nearest seed tile.
+	// Tiles that are blocked, unreachable, or at least maxCost away are set to maxCost. Seeds on blocked tiles are
+	// ignored, unless seedBlockedTiles is set: then they stay at 0 and their open neighbors are reached through them.
+	// The first version costs 1 per step (breadth-first); the second costs the entered tile's step cost,
+	// where 0 is blocked, using a bucket queue with one bucket per cost (Dial's algorithm).
+	void GenerateDistanceField(std::vector<bool> const& isTileBlocked, std::vector<IntVec2> const& seedTiles, float maxCost = FLT_MAX, bool seedBlockedTiles = false);
+	void GenerateDistanceField(std::vector<unsigned char> const& tileStepCosts, std::vector<IntVec2> const& seedTiles, float maxCost = FLT_MAX, bool seedBlockedTiles = false);
+
+	// Solves independent heat maps in parallel over the JobSystem
+	static void GenerateDistanceFields(std::vector<DistanceFieldRequest> const& requests, bool useJobSystem = true);
+
+	// Bulk operations over every tile, four at a time; other maps must have the same dimensions
+	void AddToAllValues(float valueToAdd);
+	void ScaleAllValues(float scale);
+	void ClampAllValues(float minValue, float maxValue);
+	void AddValuesFrom(TileHeatMap const& otherMap, float scale = 1.f);
+	void BlendWith(TileHeatMap const& otherMap, float fractionTowardOther);
+
+	float	GetMinValue() const;
+	float	GetMaxValue() const;
+	float	GetSumOfValues() const;
+	IntVec2 GetCoordsOfMinValue() const; // First tile in index order that holds the min
+	IntVec2 GetCoordsOfMaxValue() const;
+
+	// Rectangle queries over [mins, maxs] inclusive, clamped to the map; 0 for empty rectangles
+	float GetSumInRegion(IntVec2 const& mins, IntVec2 const& maxs) const;
+	float GetMinInRegion(IntVec2 const& mins, IntVec2 const& maxs) const;
+	float GetMaxInRegion(IntVec2 const& mins, IntVec2 const& maxs) const;
+
+	// Optional summed-area table making GetSumInRegion() O(1) while it is up to date. Changes made
+	// through this class remember the first row they touched, and UpdateSummedAreaTable() only
+	// re-accumulates from that row down; until then sums fall back to adding up each row.
+	// Call MarkValuesChanged() after writing m_values directly.
+	void EnableSummedAreaTable(bool isEnabled);
+	void UpdateSummedAreaTable();
+	void MarkValuesChanged(int firstChangedRow = 0);
+	bool IsSummedAreaTableUpToDate() const;
+
 public:
 	std::vector<float>m_values;
 	IntVec2 m_dimensions;
+
+private:
+	std::vector<double>	m_summedAreaTable;						// (width + 1) x (height + 1); entry (x, y) sums every tile below and left of it
+	int					m_summedAreaTableFirstDirtyRow = 0;
+	bool				m_isSummedAreaTableEnabled = false;
 };
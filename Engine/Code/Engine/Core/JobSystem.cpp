@@ -48,7 +48,7 @@ void JobSystem::Shutdown()
 void JobSystem::QueueNewJob(Job* job)
 {
 	m_queuedJobsListMutex.lock();
-	m_queuedJobsList.push(job);
+	m_queuedJobsList.push_back(job);
 	job->m_status = JOB_STATUS_QUEUED;
 	m_queuedJobsListMutex.unlock();
 }
@@ -57,16 +57,98 @@ Job* JobSystem::RetrieveCompletedJob()
 {
 	Job* completedJob = nullptr;
 	m_completedJobsListMutex.lock();
-	if (!m_completedJobsList.empty())
+	for (auto completedJobIter = m_completedJobsList.begin(); completedJobIter != m_completedJobsList.end(); ++completedJobIter)
 	{
-		completedJob = m_completedJobsList.front();
-		m_completedJobsList.pop();
-		completedJob->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+		if (!(*completedJobIter)->m_isRetrievedByOwner)
+		{
+			completedJob = *completedJobIter;
+			m_completedJobsList.erase(completedJobIter);
+			completedJob->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+			break;
+		}
 	}
 	m_completedJobsListMutex.unlock();
 	return completedJob;
 }
 
+bool JobSystem::RetrieveSpecificJob(Job* job)
+{
+	bool wasRetrieved = false;
+
+	m_completedJobsListMutex.lock();
+	for (auto completedJobIter = m_completedJobsList.begin(); completedJobIter != m_completedJobsList.end(); ++completedJobIter)
+	{
+		if (*completedJobIter == job)
+		{
+			m_completedJobsList.erase(completedJobIter);
+			job->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+			wasRetrieved = true;
+			break;
+		}
+	}
+	m_completedJobsListMutex.unlock();
+	return wasRetrieved;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void JobSystem::ExecuteAndRetrieveJobs(std::vector<Job*> const& jobs)
+{
+	if (m_jobWorkerThreads.empty())
+	{
+		for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+		{
+			jobs[jobIndex]->m_status = JOB_STATUS_CLAIMED_AND_EXECUTING;
+			jobs[jobIndex]->Execute();
+			jobs[jobIndex]->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+		}
+		return;
+	}
+
+	// Marked as ours so RetrieveCompletedJob never hands one to another caller before the sweep below
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		jobs[jobIndex]->m_isRetrievedByOwner = true;
+		QueueNewJob(jobs[jobIndex]);
+	}
+
+	// Workers claim from the front of the queue, so the main thread works through its own batch from the back
+	// and never picks up anyone else's jobs; jobs it runs itself never enter the completed list
+	for (int jobIndex = (int)jobs.size() - 1; jobIndex >= 0; --jobIndex)
+	{
+		Job* job = jobs[jobIndex];
+		if (ClaimSpecificJob(job))
+		{
+			job->Execute();
+			job->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+		}
+	}
+
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		while (jobs[jobIndex]->m_status != JOB_STATUS_COMPLETED && jobs[jobIndex]->m_status != JOB_STATUS_RETRIEVED_AND_RETIRED)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Jobs that ran on a worker thread are waiting in the completed list; pull out only ours
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		if (jobs[jobIndex]->m_status != JOB_STATUS_RETRIEVED_AND_RETIRED)
+		{
+			RetrieveSpecificJob(jobs[jobIndex]);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int JobSystem::GetNumWorkers() const
+{
+	return (int)m_jobWorkerThreads.size();
+}
+
 
 //--------------------------------------------------------------------------------------------------
 void JobSystem::CreateNewWorkerThreads(int numWorkerThreads)
@@ -106,7 +188,7 @@ Job* JobSystem::ClaimJob()
 	if (!m_queuedJobsList.empty())
 	{
 		nextJob = m_queuedJobsList.front();
-		m_queuedJobsList.pop();
+		m_queuedJobsList.pop_front();
 		nextJob->m_status = JOB_STATUS_CLAIMED_AND_EXECUTING;
 	}
 	m_queuedJobsListMutex.unlock();
@@ -114,11 +196,32 @@ Job* JobSystem::ClaimJob()
 }
 
 
+//--------------------------------------------------------------------------------------------------
+bool JobSystem::ClaimSpecificJob(Job* job)
+{
+	bool wasClaimed = false;
+
+	m_queuedJobsListMutex.lock();
+	for (auto queuedJobIter = m_queuedJobsList.rbegin(); queuedJobIter != m_queuedJobsList.rend(); ++queuedJobIter)
+	{
+		if (*queuedJobIter == job)
+		{
+			m_queuedJobsList.erase(std::next(queuedJobIter).base());
+			job->m_status = JOB_STATUS_CLAIMED_AND_EXECUTING;
+			wasClaimed = true;
+			break;
+		}
+	}
+	m_queuedJobsListMutex.unlock();
+	return wasClaimed;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void JobSystem::ReportCompletedJob(Job* job)
 {
 	m_completedJobsListMutex.lock();
-	m_completedJobsList.push(job);
+	m_completedJobsList.push_back(job);
 	job->m_status = JOB_STATUS_COMPLETED;
 	m_completedJobsListMutex.unlock();
 }
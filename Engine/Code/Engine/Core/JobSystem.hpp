@@ -5,7 +5,8 @@
 #include <vector>
 #include <thread>
 #include <mutex>
-#include <queue>
+#include <deque>
+#include <atomic>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -41,6 +42,7 @@ public:
 
 public:
 	std::atomic<JobStatus> m_status = JOB_STATUS_CONSTRUCTED_BUT_NOT_QUEUED;
+	bool m_isRetrievedByOwner = false; // Skipped by RetrieveCompletedJob; whoever queued it takes it back with RetrieveSpecificJob
 };
 
 
@@ -81,20 +83,25 @@ public:
 
 	void QueueNewJob(Job* job);  // Called by main thread to get a Job INTO the system (and give up ownership)
 	Job* RetrieveCompletedJob(); // Called by main thread to get a Job back OUT of the system ( and retake ownership)
+	bool RetrieveSpecificJob(Job* job); // Called by main thread to take back one particular completed Job; false if it isn't completed yet
+	void ExecuteAndRetrieveJobs(std::vector<Job*> const& jobs); // Called by main thread to queue a batch of its own Jobs, help execute them, and retake ownership once ALL are completed
+
+	int GetNumWorkers() const;
 
 protected:
 	void CreateNewWorkerThreads(int numWorkerThreads);
 	void DestroyAllWorkers();
 	bool IsQuitting() const;
 	Job* ClaimJob();
+	bool ClaimSpecificJob(Job* job);
 	void ReportCompletedJob(Job* job);
 
 private:
 	JobSystemConfig					m_config;
 	std::atomic<bool>				m_isQuitting = false;
-	std::queue<Job*>				m_queuedJobsList;
+	std::deque<Job*>				m_queuedJobsList;
 	std::mutex						m_queuedJobsListMutex;
-	std::queue<Job*>				m_completedJobsList;
+	std::deque<Job*>				m_completedJobsList;
 	std::mutex						m_completedJobsListMutex;
 	std::vector<JobWorkerThread*>	m_jobWorkerThreads;
 	// std::vector<Job*>	m_unclaimedJobsList;
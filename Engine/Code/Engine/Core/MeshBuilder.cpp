@@ -0,0 +1,232 @@
+#include "Engine/Core/MeshBuilder.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+MeshBuilder::MeshBuilder(MeshIndexFormat indexFormat)
+	: m_indexFormat(indexFormat)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::Reserve(int numVerts, int numIndexes)
+{
+	m_verts.reserve(numVerts);
+	if (m_indexFormat == MESH_INDEX_FORMAT_UINT16)
+	{
+		m_indexes16.reserve(numIndexes);
+	}
+	else
+	{
+		m_indexes32.reserve(numIndexes);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::Clear()
+{
+	m_verts.clear();
+	m_indexes32.clear();
+	m_indexes16.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshOptimizationStats MeshBuilder::Optimize(float overdrawThreshold)
+{
+	if (m_indexFormat != MESH_INDEX_FORMAT_UINT16)
+	{
+		return OptimizeMesh(m_verts, m_indexes32, overdrawThreshold);
+	}
+
+	m_indexes32.assign(m_indexes16.begin(), m_indexes16.end());
+	MeshOptimizationStats stats = OptimizeMesh(m_verts, m_indexes32, overdrawThreshold);
+	CompactIndexesToUint16(m_indexes32, m_indexes16);
+	m_indexes32.clear();
+	return stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddQuad3D(Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color, AABB2 const& UVs)
+{
+	int firstVertIndex = GetNumVerts();
+	WriteVertsForQuad3D(AddVerts(NUM_VERTS_PER_INDEXED_QUAD), bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+	AddIndexesForQuads(firstVertIndex, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddAABB2D(AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+	int firstVertIndex = GetNumVerts();
+	WriteVertsForAABB2D(AddVerts(NUM_VERTS_PER_INDEXED_QUAD), bounds, color, UVs);
+	AddIndexesForQuads(firstVertIndex, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddAABB3D(AABB3 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+	int firstVertIndex = GetNumVerts();
+	WriteVertsForAABB3D(AddVerts(NUM_QUADS_PER_AABB3 * NUM_VERTS_PER_INDEXED_QUAD), bounds, color, UVs);
+	AddIndexesForQuads(firstVertIndex, NUM_QUADS_PER_AABB3);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddOBB2D(OBB2 const& box, Rgba8 const& color)
+{
+	int firstVertIndex = GetNumVerts();
+	WriteVertsForOBB2D(AddVerts(NUM_VERTS_PER_INDEXED_QUAD), box, color);
+	AddIndexesForQuads(firstVertIndex, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddLineSegment2D(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color)
+{
+	int firstVertIndex = GetNumVerts();
+	WriteVertsForLineSegment2D(AddVerts(NUM_VERTS_PER_INDEXED_QUAD), start, end, thickness, color);
+	AddIndexesForQuads(firstVertIndex, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddDisc2D(Vec2 const& center, float radius, Rgba8 const& color, int numSlices)
+{
+	int firstVertIndex = GetNumVerts();
+	int numVerts = GetNumVertsForDisc2D(numSlices);
+	WriteVertsForDisc2D(AddVerts(numVerts), center, radius, color, numSlices);
+	AddIndexesInOrder(firstVertIndex, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddUVSphereZ3D(Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs)
+{
+	int firstVertIndex = GetNumVerts();
+	int numVerts = GetNumVertsForUVSphereZ3D(numSlices, numStacks);
+	WriteVertsForUVSphereZ3D(AddVerts(numVerts), center, radius, numSlices, numStacks, tint, UVs);
+	AddIndexesInOrder(firstVertIndex, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddCylinder3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
+{
+	int firstVertIndex = GetNumVerts();
+	int numVerts = GetNumVertsForCylinder3D(numSlices);
+	WriteVertsForCylinder3D(AddVerts(numVerts), start, end, radius, tint, numSlices, UVs);
+	AddIndexesInOrder(firstVertIndex, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddCone3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
+{
+	int firstVertIndex = GetNumVerts();
+	int numVerts = GetNumVertsForCone3D(numSlices);
+	WriteVertsForCone3D(AddVerts(numVerts), start, end, radius, tint, numSlices, UVs);
+	AddIndexesInOrder(firstVertIndex, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshIndexFormat MeshBuilder::GetIndexFormat() const
+{
+	return m_indexFormat;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int MeshBuilder::GetNumVerts() const
+{
+	return (int)m_verts.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int MeshBuilder::GetNumIndexes() const
+{
+	return m_indexFormat == MESH_INDEX_FORMAT_UINT16 ? (int)m_indexes16.size() : (int)m_indexes32.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCU> const& MeshBuilder::GetVerts() const
+{
+	return m_verts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<unsigned int> const& MeshBuilder::GetIndexes32() const
+{
+	return m_indexes32;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<unsigned short> const& MeshBuilder::GetIndexes16() const
+{
+	return m_indexes16;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vertex_PCU* MeshBuilder::AddVerts(int numVerts)
+{
+	size_t firstVertIndex = m_verts.size();
+	GUARANTEE_OR_DIE(m_indexFormat != MESH_INDEX_FORMAT_UINT16 || (int)firstVertIndex + numVerts <= MAX_VERTS_FOR_UINT16_INDEXES, "Too many verts for a mesh with 16-bit indexes");
+	m_verts.resize(firstVertIndex + numVerts);
+	return m_verts.data() + firstVertIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddIndexesForQuads(int firstVertIndex, int numQuads)
+{
+	int numIndexes = numQuads * NUM_INDEXES_PER_QUAD;
+	if (m_indexFormat == MESH_INDEX_FORMAT_UINT16)
+	{
+		size_t firstIndex = m_indexes16.size();
+		m_indexes16.resize(firstIndex + numIndexes);
+		WriteIndexesForQuads(m_indexes16.data() + firstIndex, firstVertIndex, numQuads);
+	}
+	else
+	{
+		size_t firstIndex = m_indexes32.size();
+		m_indexes32.resize(firstIndex + numIndexes);
+		WriteIndexesForQuads(m_indexes32.data() + firstIndex, firstVertIndex, numQuads);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddIndexesInOrder(int firstVertIndex, int numVerts)
+{
+	if (m_indexFormat == MESH_INDEX_FORMAT_UINT16)
+	{
+		size_t firstIndex = m_indexes16.size();
+		m_indexes16.resize(firstIndex + numVerts);
+		unsigned short* indexes = m_indexes16.data() + firstIndex;
+		for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+		{
+			indexes[vertIndex] = (unsigned short)(firstVertIndex + vertIndex);
+		}
+	}
+	else
+	{
+		size_t firstIndex = m_indexes32.size();
+		m_indexes32.resize(firstIndex + numVerts);
+		unsigned int* indexes = m_indexes32.data() + firstIndex;
+		for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+		{
+			indexes[vertIndex] = (unsigned int)(firstVertIndex + vertIndex);
+		}
+	}
+}
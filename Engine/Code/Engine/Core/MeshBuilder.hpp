@@ -0,0 +1,71 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/MeshOptimizer.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB2.hpp"
+
+#include <vector>
+
+struct AABB3;
+struct OBB2;
+
+
+//--------------------------------------------------------------------------------------------------
+enum MeshIndexFormat : unsigned char
+{
+	MESH_INDEX_FORMAT_UINT32,
+	MESH_INDEX_FORMAT_UINT16,	// Half the index memory; the mesh can hold at most 65536 verts
+
+	MESH_INDEX_FORMAT_COUNT,
+};
+
+constexpr int MAX_VERTS_FOR_UINT16_INDEXES = 65536;
+
+
+//--------------------------------------------------------------------------------------------------
+// Builds one indexed mesh out of many shapes, writing verts and indexes straight into its arrays
+// with the VertexUtils Write functions. Reserve() once with the batch's total counts (see the
+// VertexUtils GetNumVertsFor functions) and no shape added after that allocates. Quads are shared
+// 4-vert quads; round shapes are triangle lists indexed in order.
+//
+// Clear() keeps the capacity, so a builder that lives across frames stops allocating altogether.
+//--------------------------------------------------------------------------------------------------
+class MeshBuilder
+{
+public:
+	explicit MeshBuilder(MeshIndexFormat indexFormat = MESH_INDEX_FORMAT_UINT32);
+	~MeshBuilder() {}
+
+	void					Reserve(int numVerts, int numIndexes);
+	void					Clear();
+	MeshOptimizationStats	Optimize(float overdrawThreshold = DEFAULT_OVERDRAW_THRESHOLD);	// For static meshes; see MeshOptimizer
+
+	void	AddQuad3D(Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddAABB2D(AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddAABB3D(AABB3 const& bounds, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddOBB2D(OBB2 const& box, Rgba8 const& color);
+	void	AddLineSegment2D(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
+	void	AddDisc2D(Vec2 const& center, float radius, Rgba8 const& color, int numSlices = DEFAULT_DISC_2D_SLICES);
+	void	AddUVSphereZ3D(Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddCylinder3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddCone3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+
+	MeshIndexFormat						GetIndexFormat() const;
+	int									GetNumVerts() const;
+	int									GetNumIndexes() const;
+	std::vector<Vertex_PCU> const&		GetVerts() const;
+	std::vector<unsigned int> const&	GetIndexes32() const;	// Only filled for MESH_INDEX_FORMAT_UINT32
+	std::vector<unsigned short> const&	GetIndexes16() const;	// Only filled for MESH_INDEX_FORMAT_UINT16
+
+private:
+	Vertex_PCU*	AddVerts(int numVerts);
+	void		AddIndexesForQuads(int firstVertIndex, int numQuads);
+	void		AddIndexesInOrder(int firstVertIndex, int numVerts);
+
+private:
+	MeshIndexFormat				m_indexFormat = MESH_INDEX_FORMAT_UINT32;
+	std::vector<Vertex_PCU>		m_verts;
+	std::vector<unsigned int>	m_indexes32;
+	std::vector<unsigned short>	m_indexes16;
+};
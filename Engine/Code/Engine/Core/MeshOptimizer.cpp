@@ -0,0 +1,482 @@
+#include "Engine/Core/MeshOptimizer.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static_assert(sizeof(Vertex_PCU) == 24, "Welding compares Vertex_PCU bytes, so it must have no padding");
+static_assert(sizeof(Vertex_PNCU) == 36, "Welding compares Vertex_PNCU bytes, so it must have no padding");
+
+constexpr float FORSYTH_LAST_TRIANGLE_SCORE		= 0.75f;
+constexpr float FORSYTH_CACHE_DECAY_POWER		= 1.5f;
+constexpr float FORSYTH_VALENCE_BOOST_SCALE		= 2.f;
+constexpr float FORSYTH_VALENCE_BOOST_POWER		= -0.5f;
+
+
+//--------------------------------------------------------------------------------------------------
+// FNV-1a over the vertex's bytes
+static unsigned int GetVertexHash(unsigned char const* vertexBytes, int numBytes)
+{
+	unsigned int hash = 2166136261u;
+	for (int byteIndex = 0; byteIndex < numBytes; ++byteIndex)
+	{
+		hash = (hash ^ vertexBytes[byteIndex]) * 16777619u;
+	}
+	return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Unique verts are compacted to the front of verts as they are found, so the hash table can refer to them by their final index
+template <typename VertexType>
+static int WeldVertsOfType(std::vector<VertexType>& verts, std::vector<unsigned int>& indexes)
+{
+	int numVerts = (int)verts.size();
+	if (indexes.empty())
+	{
+		indexes.resize(numVerts);
+		for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+		{
+			indexes[vertIndex] = (unsigned int)vertIndex;
+		}
+	}
+
+	int hashTableSize = 1;
+	while (hashTableSize < numVerts * 2)
+	{
+		hashTableSize <<= 1;
+	}
+	unsigned int hashTableMask = (unsigned int)hashTableSize - 1;
+	std::vector<int> hashTable(hashTableSize, -1);
+	std::vector<unsigned int> weldedIndexes(numVerts);
+
+	int numUniqueVerts = 0;
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		unsigned char const* vertexBytes = reinterpret_cast<unsigned char const*>(&verts[vertIndex]);
+		unsigned int slot = GetVertexHash(vertexBytes, (int)sizeof(VertexType)) & hashTableMask;
+		for (;;)
+		{
+			int uniqueIndex = hashTable[slot];
+			if (uniqueIndex < 0)
+			{
+				hashTable[slot] = numUniqueVerts;
+				weldedIndexes[vertIndex] = (unsigned int)numUniqueVerts;
+				verts[numUniqueVerts] = verts[vertIndex];
+				++numUniqueVerts;
+				break;
+			}
+			if (memcmp(&verts[uniqueIndex], vertexBytes, sizeof(VertexType)) == 0)
+			{
+				weldedIndexes[vertIndex] = (unsigned int)uniqueIndex;
+				break;
+			}
+			slot = (slot + 1) & hashTableMask;
+		}
+	}
+
+	for (int indexIndex = 0; indexIndex < (int)indexes.size(); ++indexIndex)
+	{
+		indexes[indexIndex] = weldedIndexes[indexes[indexIndex]];
+	}
+	verts.resize(numUniqueVerts);
+	return numVerts - numUniqueVerts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int WeldVerts(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes)
+{
+	return WeldVertsOfType(verts, indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int WeldVerts(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indexes)
+{
+	return WeldVertsOfType(verts, indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Verts at the front of the cache score higher, except that the last triangle's verts are damped so
+// its neighbors are not always chosen, and verts with few triangles left are boosted to finish them off
+static float GetForsythVertexScore(int cachePosition, int numRemainingTriangles)
+{
+	if (numRemainingTriangles == 0)
+	{
+		return -1.f;
+	}
+
+	float score = 0.f;
+	if (cachePosition >= 0)
+	{
+		if (cachePosition < 3)
+		{
+			score = FORSYTH_LAST_TRIANGLE_SCORE;
+		}
+		else
+		{
+			float cacheFraction = (float)(cachePosition - 3) / (float)(MESH_OPTIMIZER_VERTEX_CACHE_SIZE - 3);
+			score = powf(1.f - cacheFraction, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+	return score + (FORSYTH_VALENCE_BOOST_SCALE * powf((float)numRemainingTriangles, FORSYTH_VALENCE_BOOST_POWER));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OptimizeVertexCache(std::vector<unsigned int>& indexes, int numVerts)
+{
+	int numTriangles = (int)indexes.size() / 3;
+	if (numTriangles == 0)
+	{
+		return;
+	}
+
+	// Each vertex's remaining triangles, packed one vertex after another
+	std::vector<int> numRemainingTriangles(numVerts, 0);
+	for (int indexIndex = 0; indexIndex < numTriangles * 3; ++indexIndex)
+	{
+		++numRemainingTriangles[indexes[indexIndex]];
+	}
+	std::vector<int> firstVertexTriangles(numVerts + 1, 0);
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		firstVertexTriangles[vertIndex + 1] = firstVertexTriangles[vertIndex] + numRemainingTriangles[vertIndex];
+	}
+	std::vector<int> vertexTriangles(numTriangles * 3);
+	std::vector<int> nextVertexTriangles(firstVertexTriangles.begin(), firstVertexTriangles.end() - 1);
+	for (int indexIndex = 0; indexIndex < numTriangles * 3; ++indexIndex)
+	{
+		vertexTriangles[nextVertexTriangles[indexes[indexIndex]]++] = indexIndex / 3;
+	}
+
+	std::vector<int> cachePositions(numVerts, -1);
+	std::vector<float> vertexScores(numVerts);
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		vertexScores[vertIndex] = GetForsythVertexScore(-1, numRemainingTriangles[vertIndex]);
+	}
+
+	std::vector<bool> isTriangleAdded(numTriangles, false);
+	std::vector<unsigned int> optimizedIndexes;
+	optimizedIndexes.reserve(numTriangles * 3);
+
+	int cache[MESH_OPTIMIZER_VERTEX_CACHE_SIZE + 3];
+	int cacheSize = 0;
+	int bestTriangle = -1;
+	int nextUnaddedTriangle = 0;
+	for (int numAddedTriangles = 0; numAddedTriangles < numTriangles; ++numAddedTriangles)
+	{
+		// Nothing left around the cache: carry on from the first triangle not yet added
+		if (bestTriangle < 0)
+		{
+			while (isTriangleAdded[nextUnaddedTriangle])
+			{
+				++nextUnaddedTriangle;
+			}
+			bestTriangle = nextUnaddedTriangle;
+		}
+		isTriangleAdded[bestTriangle] = true;
+
+		int newCache[MESH_OPTIMIZER_VERTEX_CACHE_SIZE + 3];
+		int newCacheSize = 0;
+		for (int cornerIndex = 0; cornerIndex < 3; ++cornerIndex)
+		{
+			int vertIndex = (int)indexes[(bestTriangle * 3) + cornerIndex];
+			optimizedIndexes.push_back((unsigned int)vertIndex);
+
+			int firstTriangle = firstVertexTriangles[vertIndex];
+			int lastTriangle = firstTriangle + numRemainingTriangles[vertIndex] - 1;
+			for (int triangleSlot = firstTriangle; triangleSlot <= lastTriangle; ++triangleSlot)
+			{
+				if (vertexTriangles[triangleSlot] == bestTriangle)
+				{
+					vertexTriangles[triangleSlot] = vertexTriangles[lastTriangle];
+					break;
+				}
+			}
+			--numRemainingTriangles[vertIndex];
+
+			if (std::find(newCache, newCache + newCacheSize, vertIndex) == newCache + newCacheSize)
+			{
+				newCache[newCacheSize++] = vertIndex;
+			}
+		}
+		int numTriangleVerts = newCacheSize;
+		for (int cacheIndex = 0; cacheIndex < cacheSize; ++cacheIndex)
+		{
+			if (std::find(newCache, newCache + numTriangleVerts, cache[cacheIndex]) == newCache + numTriangleVerts)
+			{
+				newCache[newCacheSize++] = cache[cacheIndex];
+			}
+		}
+
+		// Verts pushed past the end of the cache drop out with their scores lowered
+		for (int cacheIndex = 0; cacheIndex < newCacheSize; ++cacheIndex)
+		{
+			int vertIndex = newCache[cacheIndex];
+			cachePositions[vertIndex] = cacheIndex < MESH_OPTIMIZER_VERTEX_CACHE_SIZE ? cacheIndex : -1;
+			vertexScores[vertIndex] = GetForsythVertexScore(cachePositions[vertIndex], numRemainingTriangles[vertIndex]);
+		}
+
+		cacheSize = newCacheSize < MESH_OPTIMIZER_VERTEX_CACHE_SIZE ? newCacheSize : MESH_OPTIMIZER_VERTEX_CACHE_SIZE;
+		bestTriangle = -1;
+		float bestTriangleScore = -1.f;
+		for (int cacheIndex = 0; cacheIndex < cacheSize; ++cacheIndex)
+		{
+			int vertIndex = newCache[cacheIndex];
+			cache[cacheIndex] = vertIndex;
+			int firstTriangle = firstVertexTriangles[vertIndex];
+			for (int triangleSlot = firstTriangle; triangleSlot < firstTriangle + numRemainingTriangles[vertIndex]; ++triangleSlot)
+			{
+				int triangle = vertexTriangles[triangleSlot];
+				unsigned int const* triangleIndexes = &indexes[triangle * 3];
+				float triangleScore = vertexScores[triangleIndexes[0]] + vertexScores[triangleIndexes[1]] + vertexScores[triangleIndexes[2]];
+				if (triangleScore > bestTriangleScore)
+				{
+					bestTriangleScore = triangleScore;
+					bestTriangle = triangle;
+				}
+			}
+		}
+	}
+	indexes.swap(optimizedIndexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float ComputeACMR(std::vector<unsigned int> const& indexes, int numVerts, int cacheSize)
+{
+	int numTriangles = (int)indexes.size() / 3;
+	if (numTriangles == 0)
+	{
+		return 0.f;
+	}
+
+	// FIFO: a vertex is still cached until cacheSize more misses have pushed it out
+	std::vector<int> missNumbers(numVerts, -1);
+	int numMisses = 0;
+	for (int indexIndex = 0; indexIndex < numTriangles * 3; ++indexIndex)
+	{
+		int vertIndex = (int)indexes[indexIndex];
+		if (missNumbers[vertIndex] < 0 || numMisses - missNumbers[vertIndex] > cacheSize)
+		{
+			missNumbers[vertIndex] = numMisses;
+			++numMisses;
+		}
+	}
+	return (float)numMisses / (float)numTriangles;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename VertexType>
+static void OptimizeOverdrawOfType(std::vector<unsigned int>& indexes, std::vector<VertexType> const& verts, float threshold)
+{
+	int numTriangles = (int)indexes.size() / 3;
+	int numVerts = (int)verts.size();
+	if (numTriangles < 2)
+	{
+		return;
+	}
+
+	// Clusters start wherever a triangle misses the cache on all three verts, so reordering them costs little
+	std::vector<int> firstClusterTriangles;
+	std::vector<int> missNumbers(numVerts, -1);
+	int numMisses = 0;
+	for (int triangle = 0; triangle < numTriangles; ++triangle)
+	{
+		int numTriangleMisses = 0;
+		for (int cornerIndex = 0; cornerIndex < 3; ++cornerIndex)
+		{
+			int vertIndex = (int)indexes[(triangle * 3) + cornerIndex];
+			if (missNumbers[vertIndex] < 0 || numMisses - missNumbers[vertIndex] > MESH_OPTIMIZER_ACMR_CACHE_SIZE)
+			{
+				missNumbers[vertIndex] = numMisses;
+				++numMisses;
+				++numTriangleMisses;
+			}
+		}
+		if (numTriangleMisses == 3)
+		{
+			firstClusterTriangles.push_back(triangle);
+		}
+	}
+	int numClusters = (int)firstClusterTriangles.size();
+	if (numClusters < 2)
+	{
+		return;
+	}
+	firstClusterTriangles.push_back(numTriangles);
+
+	// Area-weighted centroids and summed (area-scaled) normals
+	std::vector<Vec3> clusterCentroids(numClusters, Vec3(0.f, 0.f, 0.f));
+	std::vector<Vec3> clusterNormals(numClusters, Vec3(0.f, 0.f, 0.f));
+	Vec3 meshCentroid = Vec3(0.f, 0.f, 0.f);
+	float meshArea = 0.f;
+	for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex)
+	{
+		float clusterArea = 0.f;
+		for (int triangle = firstClusterTriangles[clusterIndex]; triangle < firstClusterTriangles[clusterIndex + 1]; ++triangle)
+		{
+			Vec3 const& a = verts[indexes[(triangle * 3)]].m_position;
+			Vec3 const& b = verts[indexes[(triangle * 3) + 1]].m_position;
+			Vec3 const& c = verts[indexes[(triangle * 3) + 2]].m_position;
+			Vec3 areaNormal = CrossProduct3D(b - a, c - a);
+			float area = areaNormal.GetLength();
+			clusterNormals[clusterIndex] += areaNormal;
+			clusterCentroids[clusterIndex] += (a + b + c) * area;
+			clusterArea += area;
+		}
+		meshCentroid += clusterCentroids[clusterIndex];
+		meshArea += clusterArea;
+		if (clusterArea > 0.f)
+		{
+			clusterCentroids[clusterIndex] /= clusterArea * 3.f;
+		}
+	}
+	if (meshArea > 0.f)
+	{
+		meshCentroid /= meshArea * 3.f;
+	}
+
+	// Clusters facing furthest out from the center are drawn first, since they are the likeliest to occlude the rest
+	std::vector<float> clusterSortKeys(numClusters);
+	std::vector<int> clusterOrder(numClusters);
+	for (int clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex)
+	{
+		clusterSortKeys[clusterIndex] = DotProduct3D(clusterCentroids[clusterIndex] - meshCentroid, clusterNormals[clusterIndex].GetNormalized());
+		clusterOrder[clusterIndex] = clusterIndex;
+	}
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&clusterSortKeys](int a, int b) { return clusterSortKeys[a] > clusterSortKeys[b]; });
+
+	std::vector<unsigned int> sortedIndexes;
+	sortedIndexes.reserve(indexes.size());
+	for (int orderIndex = 0; orderIndex < numClusters; ++orderIndex)
+	{
+		int clusterIndex = clusterOrder[orderIndex];
+		sortedIndexes.insert(sortedIndexes.end(), indexes.begin() + (firstClusterTriangles[clusterIndex] * 3), indexes.begin() + (firstClusterTriangles[clusterIndex + 1] * 3));
+	}
+
+	if (ComputeACMR(sortedIndexes, numVerts) <= ComputeACMR(indexes, numVerts) * threshold)
+	{
+		indexes.swap(sortedIndexes);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OptimizeOverdraw(std::vector<unsigned int>& indexes, std::vector<Vertex_PCU> const& verts, float threshold)
+{
+	OptimizeOverdrawOfType(indexes, verts, threshold);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OptimizeOverdraw(std::vector<unsigned int>& indexes, std::vector<Vertex_PNCU> const& verts, float threshold)
+{
+	OptimizeOverdrawOfType(indexes, verts, threshold);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename VertexType>
+static void OptimizeVertexFetchOfType(std::vector<VertexType>& verts, std::vector<unsigned int>& indexes)
+{
+	std::vector<int> newVertIndexes(verts.size(), -1);
+	std::vector<VertexType> fetchOrderedVerts;
+	fetchOrderedVerts.reserve(verts.size());
+	for (int indexIndex = 0; indexIndex < (int)indexes.size(); ++indexIndex)
+	{
+		unsigned int oldVertIndex = indexes[indexIndex];
+		if (newVertIndexes[oldVertIndex] < 0)
+		{
+			newVertIndexes[oldVertIndex] = (int)fetchOrderedVerts.size();
+			fetchOrderedVerts.push_back(verts[oldVertIndex]);
+		}
+		indexes[indexIndex] = (unsigned int)newVertIndexes[oldVertIndex];
+	}
+	verts.swap(fetchOrderedVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OptimizeVertexFetch(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes)
+{
+	OptimizeVertexFetchOfType(verts, indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OptimizeVertexFetch(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indexes)
+{
+	OptimizeVertexFetchOfType(verts, indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename VertexType>
+static MeshOptimizationStats OptimizeMeshOfType(std::vector<VertexType>& verts, std::vector<unsigned int>& indexes, float overdrawThreshold)
+{
+	MeshOptimizationStats stats;
+	stats.m_numVertsBefore = (int)verts.size();
+	if (indexes.empty())
+	{
+		indexes.resize(verts.size());
+		for (int vertIndex = 0; vertIndex < (int)verts.size(); ++vertIndex)
+		{
+			indexes[vertIndex] = (unsigned int)vertIndex;
+		}
+	}
+	stats.m_numTriangles = (int)indexes.size() / 3;
+	stats.m_acmrBefore = ComputeACMR(indexes, stats.m_numVertsBefore);
+
+	WeldVertsOfType(verts, indexes);
+	OptimizeVertexCache(indexes, (int)verts.size());
+	OptimizeOverdrawOfType(indexes, verts, overdrawThreshold);
+	OptimizeVertexFetchOfType(verts, indexes);
+
+	stats.m_numVertsAfter = (int)verts.size();
+	stats.m_acmrAfter = ComputeACMR(indexes, (int)verts.size());
+	stats.m_fitsUint16Indexes = stats.m_numVertsAfter <= 65536;
+	return stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshOptimizationStats OptimizeMesh(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, float overdrawThreshold)
+{
+	return OptimizeMeshOfType(verts, indexes, overdrawThreshold);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshOptimizationStats OptimizeMesh(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indexes, float overdrawThreshold)
+{
+	return OptimizeMeshOfType(verts, indexes, overdrawThreshold);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CompactIndexesToUint16(std::vector<unsigned int> const& indexes, std::vector<unsigned short>& out_indexes16)
+{
+	for (int indexIndex = 0; indexIndex < (int)indexes.size(); ++indexIndex)
+	{
+		if (indexes[indexIndex] > 0xFFFF)
+		{
+			return false;
+		}
+	}
+
+	out_indexes16.resize(indexes.size());
+	for (int indexIndex = 0; indexIndex < (int)indexes.size(); ++indexIndex)
+	{
+		out_indexes16[indexIndex] = (unsigned short)indexes[indexIndex];
+	}
+	return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PNCU.hpp"
+
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int	MESH_OPTIMIZER_ACMR_CACHE_SIZE		= 16;		// FIFO post-transform cache that ACMR is measured against
+constexpr int	MESH_OPTIMIZER_VERTEX_CACHE_SIZE	= 32;		// LRU cache that the vertex cache reordering scores against
+constexpr float	DEFAULT_OVERDRAW_THRESHOLD			= 1.05f;	// How much worse ACMR may get to sort triangles for less overdraw
+
+
+//--------------------------------------------------------------------------------------------------
+struct MeshOptimizationStats
+{
+	int		m_numVertsBefore	= 0;
+	int		m_numVertsAfter		= 0;
+	int		m_numTriangles		= 0;
+	float	m_acmrBefore		= 0.f;	// Average cache miss ratio: transformed verts per triangle, 0.5 at best and 3 at worst
+	float	m_acmrAfter			= 0.f;
+	bool	m_fitsUint16Indexes	= false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Offline passes for static indexed triangle lists; each can be run on its own, or all of them in
+// order by OptimizeMesh(). An empty index list means the verts are raw triangle soup.
+//
+// WeldVerts merges bitwise-identical verts through a hash table. OptimizeVertexCache reorders
+// triangles with Tom Forsyth's linear-speed vertex cache algorithm. OptimizeOverdraw then splits
+// that order into clusters wherever the cache starts cold and draws the most outward-facing
+// clusters first, as long as ACMR stays within the threshold. OptimizeVertexFetch renumbers verts
+// in first-use order and drops any that are no longer referenced.
+//--------------------------------------------------------------------------------------------------
+int						WeldVerts(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes);
+int						WeldVerts(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indexes);
+void					OptimizeVertexCache(std::vector<unsigned int>& indexes, int numVerts);
+void					OptimizeOverdraw(std::vector<unsigned int>& indexes, std::vector<Vertex_PCU> const& verts, float threshold = DEFAULT_OVERDRAW_THRESHOLD);
+void					OptimizeOverdraw(std::vector<unsigned int>& indexes, std::vector<Vertex_PNCU> const& verts, float threshold = DEFAULT_OVERDRAW_THRESHOLD);
+void					OptimizeVertexFetch(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes);
+void					OptimizeVertexFetch(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indexes);
+MeshOptimizationStats	OptimizeMesh(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, float overdrawThreshold = DEFAULT_OVERDRAW_THRESHOLD);
+MeshOptimizationStats	OptimizeMesh(std::vector<Vertex_PNCU>& verts, std::vector<unsigned int>& indexes, float overdrawThreshold = DEFAULT_OVERDRAW_THRESHOLD);
+
+//--------------------------------------------------------------------------------------------------
+float	ComputeACMR(std::vector<unsigned int> const& indexes, int numVerts, int cacheSize = MESH_OPTIMIZER_ACMR_CACHE_SIZE);
+bool	CompactIndexesToUint16(std::vector<unsigned int> const& indexes, std::vector<unsigned short>& out_indexes16);	// False if any index is over 65535
@@ -0,0 +1,538 @@
+#include "Engine/Core/MeshSimplifier.hpp"
+#include "Engine/Core/MeshOptimizer.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <algorithm>
+#include <math.h>
+#include <unordered_map>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr double	BORDER_PLANE_WEIGHT				= 10.0;
+constexpr float		MIN_LOD_TRIANGLE_REDUCTION		= 0.9f;		// Stop the chain once a LOD keeps more than this fraction of the previous one
+constexpr float		MIN_COLLAPSE_NORMAL_COSINE		= 0.25f;	// A collapse may turn a triangle's normal by up to about 75 degrees
+constexpr float		MIN_COLLAPSE_TRIANGLE_QUALITY	= 0.02f;	// See GetTriangleQuality(); below this a moved triangle is a sliver
+
+
+//--------------------------------------------------------------------------------------------------
+enum SimplifierVertexKind : unsigned char
+{
+	SIMPLIFIER_VERTEX_MANIFOLD,		// Can collapse onto any neighbor
+	SIMPLIFIER_VERTEX_BORDER,		// Can only collapse along a border edge
+	SIMPLIFIER_VERTEX_LOCKED,		// Seams, non-manifold edges and corners where borders meet
+
+	SIMPLIFIER_VERTEX_KIND_COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Symmetric 4x4 error matrix: error(p) = p'Ap + 2b'p + c, summed over planes
+struct Quadric
+{
+	double m_a00 = 0.0, m_a01 = 0.0, m_a02 = 0.0, m_a11 = 0.0, m_a12 = 0.0, m_a22 = 0.0;
+	double m_b0 = 0.0, m_b1 = 0.0, m_b2 = 0.0;
+	double m_c = 0.0;
+	double m_weight = 0.0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct EdgeCollapse
+{
+	unsigned int	m_fromVert = 0;
+	unsigned int	m_toVert = 0;
+	unsigned int	m_toIndex = 0;		// The vert the collapsed triangles use in place of m_fromVert
+	double			m_cost = 0.0;
+
+	bool operator<(EdgeCollapse const& compare) const
+	{
+		return m_cost < compare.m_cost;
+	}
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static void AddPlaneToQuadric(Quadric& quadric, double normalX, double normalY, double normalZ, double distance, double weight)
+{
+	quadric.m_a00 += weight * normalX * normalX;
+	quadric.m_a01 += weight * normalX * normalY;
+	quadric.m_a02 += weight * normalX * normalZ;
+	quadric.m_a11 += weight * normalY * normalY;
+	quadric.m_a12 += weight * normalY * normalZ;
+	quadric.m_a22 += weight * normalZ * normalZ;
+	quadric.m_b0 += weight * normalX * distance;
+	quadric.m_b1 += weight * normalY * distance;
+	quadric.m_b2 += weight * normalZ * distance;
+	quadric.m_c += weight * distance * distance;
+	quadric.m_weight += weight;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Plane through point with the given (not necessarily unit) normal; degenerate normals add nothing
+static void AddPlaneToQuadric(Quadric& quadric, Vec3 const& point, Vec3 const& normal, double weight)
+{
+	double length = sqrt((double)normal.x * normal.x + (double)normal.y * normal.y + (double)normal.z * normal.z);
+	if (length <= 0.0)
+	{
+		return;
+	}
+
+	double normalX = normal.x / length;
+	double normalY = normal.y / length;
+	double normalZ = normal.z / length;
+	double distance = -(normalX * point.x + normalY * point.y + normalZ * point.z);
+	AddPlaneToQuadric(quadric, normalX, normalY, normalZ, distance, weight);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void AddQuadric(Quadric& quadric, Quadric const& other)
+{
+	quadric.m_a00 += other.m_a00;
+	quadric.m_a01 += other.m_a01;
+	quadric.m_a02 += other.m_a02;
+	quadric.m_a11 += other.m_a11;
+	quadric.m_a12 += other.m_a12;
+	quadric.m_a22 += other.m_a22;
+	quadric.m_b0 += other.m_b0;
+	quadric.m_b1 += other.m_b1;
+	quadric.m_b2 += other.m_b2;
+	quadric.m_c += other.m_c;
+	quadric.m_weight += other.m_weight;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Twice the area over the longest edge squared: about 0.87 for an equilateral triangle, 0 for a degenerate one
+static float GetTriangleQuality(Vec3 const* positions, Vec3 const& normal)
+{
+	float longestEdgeSquared = (positions[1] - positions[0]).GetLengthSquared();
+	float edgeSquared = (positions[2] - positions[1]).GetLengthSquared();
+	longestEdgeSquared = edgeSquared > longestEdgeSquared ? edgeSquared : longestEdgeSquared;
+	edgeSquared = (positions[0] - positions[2]).GetLengthSquared();
+	longestEdgeSquared = edgeSquared > longestEdgeSquared ? edgeSquared : longestEdgeSquared;
+	return longestEdgeSquared > 0.f ? normal.GetLength() / longestEdgeSquared : 0.f;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// A triangle that keeps all three corners through a collapse must not flip, turn sharply, or thin
+// out into a sliver; triangles that were already slivers may stay that thin but not get thinner
+static bool IsTriangleDistortedByCollapse(Vec3 const* positions, Vec3 const* movedPositions)
+{
+	Vec3 normal = CrossProduct3D(positions[1] - positions[0], positions[2] - positions[0]);
+	Vec3 movedNormal = CrossProduct3D(movedPositions[1] - movedPositions[0], movedPositions[2] - movedPositions[0]);
+	float normalsDot = DotProduct3D(normal, movedNormal);
+	if (normalsDot <= 0.f || normalsDot < MIN_COLLAPSE_NORMAL_COSINE * normal.GetLength() * movedNormal.GetLength())
+	{
+		return true;
+	}
+
+	float movedQuality = GetTriangleQuality(movedPositions, movedNormal);
+	return movedQuality < MIN_COLLAPSE_TRIANGLE_QUALITY && movedQuality < GetTriangleQuality(positions, normal);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Weighted mean squared distance from point to the planes of both quadrics
+static double GetCollapseCost(Quadric const& fromQuadric, Quadric const& toQuadric, Vec3 const& point)
+{
+	Quadric quadric = fromQuadric;
+	AddQuadric(quadric, toQuadric);
+
+	double x = point.x;
+	double y = point.y;
+	double z = point.z;
+	double error = (quadric.m_a00 * x * x) + (quadric.m_a11 * y * y) + (quadric.m_a22 * z * z)
+		+ 2.0 * ((quadric.m_a01 * x * y) + (quadric.m_a02 * x * z) + (quadric.m_a12 * y * z))
+		+ 2.0 * ((quadric.m_b0 * x) + (quadric.m_b1 * y) + (quadric.m_b2 * z))
+		+ quadric.m_c;
+	error = error > 0.0 ? error : 0.0;
+	return quadric.m_weight > 0.0 ? error / quadric.m_weight : 0.0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static unsigned long long GetEdgeKey(unsigned int startVert, unsigned int endVert)
+{
+	return ((unsigned long long)startVert << 32) | endVert;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Maps every vert to the lowest-indexed vert at the same position
+static void BuildPositionRemap(std::vector<Vertex_PNCU> const& verts, std::vector<unsigned int>& out_remap)
+{
+	int numVerts = (int)verts.size();
+	std::vector<unsigned int> sortedVerts(numVerts);
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		sortedVerts[vertIndex] = (unsigned int)vertIndex;
+	}
+
+	auto IsPositionLess = [&verts](unsigned int vertA, unsigned int vertB)
+	{
+		Vec3 const& positionA = verts[vertA].m_position;
+		Vec3 const& positionB = verts[vertB].m_position;
+		if (positionA.x != positionB.x)
+		{
+			return positionA.x < positionB.x;
+		}
+		if (positionA.y != positionB.y)
+		{
+			return positionA.y < positionB.y;
+		}
+		if (positionA.z != positionB.z)
+		{
+			return positionA.z < positionB.z;
+		}
+		return vertA < vertB;
+	};
+	std::sort(sortedVerts.begin(), sortedVerts.end(), IsPositionLess);
+
+	out_remap.resize(numVerts);
+	unsigned int groupVert = 0;
+	for (int sortedIndex = 0; sortedIndex < numVerts; ++sortedIndex)
+	{
+		unsigned int vert = sortedVerts[sortedIndex];
+		if (sortedIndex == 0 || verts[vert].m_position != verts[groupVert].m_position)
+		{
+			groupVert = vert;
+		}
+		out_remap[vert] = groupVert;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// A position shared by verts that differ in anything else is a seam
+static void LockSeamVerts(std::vector<Vertex_PNCU> const& verts, std::vector<unsigned int> const& remap, std::vector<unsigned char>& isLocked)
+{
+	for (int vertIndex = 0; vertIndex < (int)verts.size(); ++vertIndex)
+	{
+		unsigned int groupVert = remap[vertIndex];
+		if (groupVert == (unsigned int)vertIndex)
+		{
+			continue;
+		}
+
+		Vertex_PNCU const& vert = verts[vertIndex];
+		Vertex_PNCU const& groupFirst = verts[groupVert];
+		bool isSameVertex = vert.m_normal == groupFirst.m_normal && vert.m_uvTexCoords == groupFirst.m_uvTexCoords
+			&& vert.m_color.r == groupFirst.m_color.r && vert.m_color.g == groupFirst.m_color.g
+			&& vert.m_color.b == groupFirst.m_color.b && vert.m_color.a == groupFirst.m_color.a;
+		if (!isSameVertex)
+		{
+			isLocked[groupVert] = 1;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float SimplifyMesh(std::vector<Vertex_PNCU> const& verts, std::vector<unsigned int> const& indexes, int targetNumIndexes, std::vector<unsigned int>& out_indexes, float maxError)
+{
+	int numVerts = (int)verts.size();
+	std::vector<unsigned int> remap;
+	BuildPositionRemap(verts, remap);
+
+	// Triangles use the grouped verts from here on, so identical verts at one position act as one;
+	// seam verts keep their own index since they will never move
+	out_indexes.resize(indexes.size());
+	std::vector<unsigned char> isLocked(numVerts, 0);
+	LockSeamVerts(verts, remap, isLocked);
+	for (int indexIndex = 0; indexIndex < (int)indexes.size(); ++indexIndex)
+	{
+		unsigned int vert = indexes[indexIndex];
+		out_indexes[indexIndex] = isLocked[remap[vert]] ? vert : remap[vert];
+	}
+	if ((int)out_indexes.size() <= targetNumIndexes)
+	{
+		return 0.f;
+	}
+
+	std::unordered_map<unsigned long long, int> edgeCounts;
+	for (int triangleStart = 0; triangleStart + 2 < (int)out_indexes.size(); triangleStart += 3)
+	{
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			++edgeCounts[GetEdgeKey(remap[out_indexes[triangleStart + corner]], remap[out_indexes[triangleStart + ((corner + 1) % 3)]])];
+		}
+	}
+
+	std::vector<Quadric> quadrics(numVerts);
+	for (int triangleStart = 0; triangleStart + 2 < (int)out_indexes.size(); triangleStart += 3)
+	{
+		unsigned int triangleVerts[3];
+		Vec3 positions[3];
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			triangleVerts[corner] = remap[out_indexes[triangleStart + corner]];
+			positions[corner] = verts[triangleVerts[corner]].m_position;
+		}
+
+		Vec3 normal = CrossProduct3D(positions[1] - positions[0], positions[2] - positions[0]);
+		double area = 0.5 * normal.GetLength();
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			AddPlaneToQuadric(quadrics[triangleVerts[corner]], positions[0], normal, area);
+		}
+
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			unsigned int startVert = triangleVerts[corner];
+			unsigned int endVert = triangleVerts[(corner + 1) % 3];
+			if (edgeCounts.count(GetEdgeKey(endVert, startVert)) != 0)
+			{
+				continue;
+			}
+
+			Vec3 edge = positions[(corner + 1) % 3] - positions[corner];
+			Vec3 borderNormal = CrossProduct3D(edge, normal);
+			double edgeLengthSquared = (double)edge.GetLengthSquared();
+			AddPlaneToQuadric(quadrics[startVert], positions[corner], borderNormal, BORDER_PLANE_WEIGHT * edgeLengthSquared);
+			AddPlaneToQuadric(quadrics[endVert], positions[corner], borderNormal, BORDER_PLANE_WEIGHT * edgeLengthSquared);
+		}
+	}
+
+	double maxCost = (double)maxError * (double)maxError;
+	double reachedCost = 0.0;
+	std::vector<unsigned char> kinds(numVerts);
+	std::vector<unsigned char> isTouched(numVerts);
+	std::vector<unsigned int> collapseTargets(numVerts);
+	std::vector<int> firstVertTriangles(numVerts + 1);
+	std::vector<int> vertTriangles;
+	std::vector<EdgeCollapse> collapses;
+
+	while ((int)out_indexes.size() > targetNumIndexes)
+	{
+		int numTriangles = (int)out_indexes.size() / 3;
+
+		// Borders move as the mesh shrinks, so edge counts, kinds and adjacency are rebuilt each pass
+		edgeCounts.clear();
+		std::fill(firstVertTriangles.begin(), firstVertTriangles.end(), 0);
+		for (int indexIndex = 0; indexIndex < numTriangles * 3; ++indexIndex)
+		{
+			int triangleStart = indexIndex - (indexIndex % 3);
+			unsigned int startVert = remap[out_indexes[indexIndex]];
+			unsigned int endVert = remap[out_indexes[triangleStart + ((indexIndex + 1) % 3)]];
+			++edgeCounts[GetEdgeKey(startVert, endVert)];
+			++firstVertTriangles[startVert + 1];
+		}
+		for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+		{
+			firstVertTriangles[vertIndex + 1] += firstVertTriangles[vertIndex];
+		}
+		vertTriangles.resize(numTriangles * 3);
+		std::vector<int> nextVertTriangles(firstVertTriangles.begin(), firstVertTriangles.end() - 1);
+		for (int indexIndex = 0; indexIndex < numTriangles * 3; ++indexIndex)
+		{
+			vertTriangles[nextVertTriangles[remap[out_indexes[indexIndex]]]++] = indexIndex / 3;
+		}
+
+		std::vector<int> numBorderEdges(numVerts, 0);
+		for (auto const& edgeCount : edgeCounts)
+		{
+			unsigned int startVert = (unsigned int)(edgeCount.first >> 32);
+			unsigned int endVert = (unsigned int)(edgeCount.first & 0xffffffff);
+			auto reverseEdge = edgeCounts.find(GetEdgeKey(endVert, startVert));
+			int reverseCount = reverseEdge == edgeCounts.end() ? 0 : reverseEdge->second;
+			if (edgeCount.second > 1 || reverseCount > 1)
+			{
+				isLocked[startVert] = 1;
+				isLocked[endVert] = 1;
+			}
+			else if (reverseCount == 0)
+			{
+				++numBorderEdges[startVert];
+				++numBorderEdges[endVert];
+			}
+		}
+		for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+		{
+			if (isLocked[vertIndex] || numBorderEdges[vertIndex] > 2)
+			{
+				kinds[vertIndex] = SIMPLIFIER_VERTEX_LOCKED;
+			}
+			else
+			{
+				kinds[vertIndex] = numBorderEdges[vertIndex] > 0 ? SIMPLIFIER_VERTEX_BORDER : SIMPLIFIER_VERTEX_MANIFOLD;
+			}
+		}
+
+		collapses.clear();
+		for (int indexIndex = 0; indexIndex < numTriangles * 3; ++indexIndex)
+		{
+			int triangleStart = indexIndex - (indexIndex % 3);
+			unsigned int fromVert = remap[out_indexes[indexIndex]];
+			unsigned int toIndex = out_indexes[triangleStart + ((indexIndex + 1) % 3)];
+			unsigned int toVert = remap[toIndex];
+			bool isBorderEdge = edgeCounts.count(GetEdgeKey(toVert, fromVert)) == 0 || edgeCounts.count(GetEdgeKey(fromVert, toVert)) == 0;
+			for (int direction = 0; direction < 2; ++direction)
+			{
+				bool canCollapse = kinds[fromVert] == SIMPLIFIER_VERTEX_MANIFOLD || (kinds[fromVert] == SIMPLIFIER_VERTEX_BORDER && isBorderEdge);
+				if (canCollapse)
+				{
+					EdgeCollapse collapse;
+					collapse.m_fromVert = fromVert;
+					collapse.m_toVert = toVert;
+					collapse.m_toIndex = toIndex;
+					collapse.m_cost = GetCollapseCost(quadrics[fromVert], quadrics[toVert], verts[toVert].m_position);
+					collapses.push_back(collapse);
+				}
+
+				unsigned int swapVert = fromVert;
+				fromVert = toVert;
+				toVert = swapVert;
+				toIndex = out_indexes[indexIndex];
+			}
+		}
+		std::sort(collapses.begin(), collapses.end());
+
+		// Collapse cheapest first, at most once around any vert per pass so every distortion check sees the
+		// triangles as they really are
+		std::fill(isTouched.begin(), isTouched.end(), 0);
+		int numTrianglesToRemove = numTriangles - (targetNumIndexes / 3);
+		int numTrianglesRemoved = 0;
+		int numCollapses = 0;
+		for (int collapseIndex = 0; collapseIndex < (int)collapses.size() && numTrianglesRemoved < numTrianglesToRemove; ++collapseIndex)
+		{
+			EdgeCollapse const& collapse = collapses[collapseIndex];
+			if (collapse.m_cost > maxCost)
+			{
+				break;
+			}
+			if (isTouched[collapse.m_fromVert] || isTouched[collapse.m_toVert])
+			{
+				continue;
+			}
+
+			Vec3 const& toPosition = verts[collapse.m_toVert].m_position;
+			bool distortsTriangle = false;
+			int numTrianglesCollapsed = 0;
+			for (int adjacentIndex = firstVertTriangles[collapse.m_fromVert]; adjacentIndex < firstVertTriangles[collapse.m_fromVert + 1]; ++adjacentIndex)
+			{
+				int triangleStart = vertTriangles[adjacentIndex] * 3;
+				Vec3 positions[3];
+				Vec3 movedPositions[3];
+				bool hasToVert = false;
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					unsigned int vert = remap[out_indexes[triangleStart + corner]];
+					hasToVert = hasToVert || vert == collapse.m_toVert;
+					positions[corner] = verts[vert].m_position;
+					movedPositions[corner] = vert == collapse.m_fromVert ? toPosition : positions[corner];
+				}
+				if (hasToVert)
+				{
+					++numTrianglesCollapsed;
+					continue;
+				}
+
+				if (IsTriangleDistortedByCollapse(positions, movedPositions))
+				{
+					distortsTriangle = true;
+					break;
+				}
+			}
+			if (distortsTriangle)
+			{
+				continue;
+			}
+
+			collapseTargets[collapse.m_fromVert] = collapse.m_toIndex;
+			AddQuadric(quadrics[collapse.m_toVert], quadrics[collapse.m_fromVert]);
+			for (int adjacentIndex = firstVertTriangles[collapse.m_fromVert]; adjacentIndex < firstVertTriangles[collapse.m_fromVert + 1]; ++adjacentIndex)
+			{
+				int triangleStart = vertTriangles[adjacentIndex] * 3;
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					isTouched[remap[out_indexes[triangleStart + corner]]] = 1;
+				}
+			}
+			kinds[collapse.m_fromVert] = SIMPLIFIER_VERTEX_KIND_COUNT;	// Marks the vert as collapsed
+			numTrianglesRemoved += numTrianglesCollapsed;
+			reachedCost = collapse.m_cost > reachedCost ? collapse.m_cost : reachedCost;
+			++numCollapses;
+		}
+
+		if (numCollapses == 0)
+		{
+			break;
+		}
+
+		int numKeptIndexes = 0;
+		for (int triangleStart = 0; triangleStart < numTriangles * 3; triangleStart += 3)
+		{
+			unsigned int triangle[3];
+			for (int corner = 0; corner < 3; ++corner)
+			{
+				unsigned int vert = out_indexes[triangleStart + corner];
+				triangle[corner] = kinds[remap[vert]] == SIMPLIFIER_VERTEX_KIND_COUNT ? collapseTargets[remap[vert]] : vert;
+			}
+			if (remap[triangle[0]] == remap[triangle[1]] || remap[triangle[1]] == remap[triangle[2]] || remap[triangle[2]] == remap[triangle[0]])
+			{
+				continue;
+			}
+
+			out_indexes[numKeptIndexes++] = triangle[0];
+			out_indexes[numKeptIndexes++] = triangle[1];
+			out_indexes[numKeptIndexes++] = triangle[2];
+		}
+		out_indexes.resize(numKeptIndexes);
+	}
+
+	return (float)sqrt(reachedCost);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Each LOD is simplified from the one before it, so its error adds onto the previous LOD's
+void BuildMeshLODChain(std::vector<Vertex_PNCU> const& verts, std::vector<unsigned int> const& indexes, std::vector<MeshLOD>& out_lods, int maxNumLODs, float triangleRatioPerLOD)
+{
+	out_lods.clear();
+	out_lods.emplace_back();
+	out_lods[0].m_indexes = indexes;
+
+	while ((int)out_lods.size() < maxNumLODs)
+	{
+		int previousNumIndexes = (int)out_lods.back().m_indexes.size();
+		float previousError = out_lods.back().m_error;
+		int targetNumIndexes = (int)((float)(previousNumIndexes / 3) * triangleRatioPerLOD) * 3;
+
+		MeshLOD lod;
+		float error = SimplifyMesh(verts, out_lods.back().m_indexes, targetNumIndexes, lod.m_indexes);
+		if (lod.m_indexes.empty() || (float)lod.m_indexes.size() > MIN_LOD_TRIANGLE_REDUCTION * (float)previousNumIndexes)
+		{
+			break;
+		}
+
+		lod.m_error = previousError + error;
+		OptimizeVertexCache(lod.m_indexes, (int)verts.size());
+		out_lods.push_back(lod);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The coarsest LOD whose error stays under maxErrorPixels once the mesh is scaled to screenRadiusPixels
+int SelectMeshLOD(std::vector<MeshLOD> const& lods, float screenRadiusPixels, float meshRadius, float maxErrorPixels)
+{
+	if (meshRadius <= 0.f)
+	{
+		return 0;
+	}
+
+	float pixelsPerUnit = screenRadiusPixels / meshRadius;
+	int selectedLOD = 0;
+	for (int lodIndex = 1; lodIndex < (int)lods.size(); ++lodIndex)
+	{
+		if (lods[lodIndex].m_error * pixelsPerUnit > maxErrorPixels)
+		{
+			break;
+		}
+		selectedLOD = lodIndex;
+	}
+	return selectedLOD;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "Engine/Core/Vertex_PNCU.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+
+#include <float.h>
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int	DEFAULT_MAX_MESH_LODS			= 4;
+constexpr float	DEFAULT_LOD_TRIANGLE_RATIO		= 0.5f;		// Each LOD aims for this fraction of the previous LOD's triangles
+
+
+//--------------------------------------------------------------------------------------------------
+struct MeshLOD
+{
+	std::vector<unsigned int>	m_indexes;
+	float						m_error = 0.f;	// Roughly how far the surface has moved from the full mesh, in mesh units
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Quadric error simplification (Garland-Heckbert) for indexed Vertex_PNCU triangle lists. Each
+// vertex accumulates the planes of its triangles, weighted by area, plus planes standing up along
+// open edges so borders hold their shape. Edges are collapsed cheapest first onto one of their own
+// vertices, so every LOD is just a new index list over the original verts and the whole chain can
+// share one vertex buffer. Collapses that would flip, sharply turn or thin out a triangle are skipped.
+//
+// Verts sharing a position with verts of different normals or UVs (seams) are never moved, and
+// border verts only slide along their border. The error only measures positions; normals and UVs
+// come along with the vertex the edge collapses onto.
+//--------------------------------------------------------------------------------------------------
+float	SimplifyMesh(std::vector<Vertex_PNCU> const& verts, std::vector<unsigned int> const& indexes, int targetNumIndexes, std::vector<unsigned int>& out_indexes, float maxError = FLT_MAX);	// Returns the error reached
+void	BuildMeshLODChain(std::vector<Vertex_PNCU> const& verts, std::vector<unsigned int> const& indexes, std::vector<MeshLOD>& out_lods, int maxNumLODs = DEFAULT_MAX_MESH_LODS, float triangleRatioPerLOD = DEFAULT_LOD_TRIANGLE_RATIO);
+int		SelectMeshLOD(std::vector<MeshLOD> const& lods, float screenRadiusPixels, float meshRadius, float maxErrorPixels = DEFAULT_LOD_MAX_ERROR_PIXELS);
@@ -0,0 +1,220 @@
+#include "Engine/Core/ParallelMeshBuilder.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------------------------
+class MeshPartBuildJob : public Job
+{
+public:
+	MeshPartBuildJob(MeshBuilder& part, MeshPartBuildFunc const& buildPart, int firstItem, int numItems) :
+		m_part(part),
+		m_buildPart(buildPart),
+		m_firstItem(firstItem),
+		m_numItems(numItems)
+	{};
+	virtual void Execute() override
+	{
+		m_buildPart(m_part, m_firstItem, m_numItems);
+	}
+
+	MeshBuilder&				m_part;
+	MeshPartBuildFunc const&	m_buildPart;
+	int							m_firstItem = 0;
+	int							m_numItems = 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+class MeshPartMergeJob : public Job
+{
+public:
+	MeshPartMergeJob(ParallelMeshBuilder& builder, int partIndex) :
+		m_builder(builder),
+		m_partIndex(partIndex)
+	{};
+	virtual void Execute() override
+	{
+		m_builder.MergePart(m_partIndex);
+	}
+
+	ParallelMeshBuilder&	m_builder;
+	int						m_partIndex = 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+ParallelMeshBuilder::ParallelMeshBuilder(MeshIndexFormat indexFormat)
+	: m_indexFormat(indexFormat)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The final arrays are resized rather than cleared so only verts past the last build's count get
+// constructed; every element is then overwritten by a merge job.
+void ParallelMeshBuilder::Build(int numItems, MeshPartBuildFunc const& buildPart, bool useJobSystem, int itemsPerJob)
+{
+	GUARANTEE_OR_DIE(itemsPerJob > 0, "Mesh parts need at least one item per job");
+	m_numParts = (numItems + itemsPerJob - 1) / itemsPerJob;
+	while ((int)m_parts.size() < m_numParts)
+	{
+		m_parts.emplace_back(m_indexFormat);
+	}
+
+	std::vector<Job*> jobs;
+	jobs.reserve(m_numParts);
+	for (int partIndex = 0; partIndex < m_numParts; ++partIndex)
+	{
+		int firstItem = partIndex * itemsPerJob;
+		int numPartItems = numItems - firstItem < itemsPerJob ? numItems - firstItem : itemsPerJob;
+		m_parts[partIndex].Clear();
+		jobs.push_back(new MeshPartBuildJob(m_parts[partIndex], buildPart, firstItem, numPartItems));
+	}
+	RunJobs(jobs, useJobSystem);
+
+	m_firstVertIndexes.resize(m_numParts);
+	m_firstIndexIndexes.resize(m_numParts);
+	int numVerts = 0;
+	int numIndexes = 0;
+	for (int partIndex = 0; partIndex < m_numParts; ++partIndex)
+	{
+		m_firstVertIndexes[partIndex] = numVerts;
+		m_firstIndexIndexes[partIndex] = numIndexes;
+		numVerts += m_parts[partIndex].GetNumVerts();
+		numIndexes += m_parts[partIndex].GetNumIndexes();
+	}
+
+	m_verts.resize(numVerts);
+	if (m_indexFormat == MESH_INDEX_FORMAT_UINT16)
+	{
+		GUARANTEE_OR_DIE(numVerts <= MAX_VERTS_FOR_UINT16_INDEXES, "Too many verts for a mesh with 16-bit indexes");
+		m_indexes16.resize(numIndexes);
+	}
+	else
+	{
+		m_indexes32.resize(numIndexes);
+	}
+
+	jobs.clear();
+	for (int partIndex = 0; partIndex < m_numParts; ++partIndex)
+	{
+		jobs.push_back(new MeshPartMergeJob(*this, partIndex));
+	}
+	RunJobs(jobs, useJobSystem);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ParallelMeshBuilder::Clear()
+{
+	for (int partIndex = 0; partIndex < (int)m_parts.size(); ++partIndex)
+	{
+		m_parts[partIndex].Clear();
+	}
+	m_numParts = 0;
+	m_verts.clear();
+	m_indexes32.clear();
+	m_indexes16.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshIndexFormat ParallelMeshBuilder::GetIndexFormat() const
+{
+	return m_indexFormat;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ParallelMeshBuilder::GetNumVerts() const
+{
+	return (int)m_verts.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ParallelMeshBuilder::GetNumIndexes() const
+{
+	return m_indexFormat == MESH_INDEX_FORMAT_UINT16 ? (int)m_indexes16.size() : (int)m_indexes32.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCU> const& ParallelMeshBuilder::GetVerts() const
+{
+	return m_verts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<unsigned int> const& ParallelMeshBuilder::GetIndexes32() const
+{
+	return m_indexes32;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<unsigned short> const& ParallelMeshBuilder::GetIndexes16() const
+{
+	return m_indexes16;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ParallelMeshBuilder::RunJobs(std::vector<Job*> const& jobs, bool useJobSystem)
+{
+	if (useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0 && jobs.size() > 1)
+	{
+		g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+	}
+	else
+	{
+		for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+		{
+			jobs[jobIndex]->Execute();
+		}
+	}
+
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ParallelMeshBuilder::MergePart(int partIndex)
+{
+	MeshBuilder const& part = m_parts[partIndex];
+	int firstVertIndex = m_firstVertIndexes[partIndex];
+	int firstIndex = m_firstIndexIndexes[partIndex];
+	int numVerts = part.GetNumVerts();
+	int numIndexes = part.GetNumIndexes();
+
+	if (numVerts > 0)
+	{
+		std::copy(part.GetVerts().begin(), part.GetVerts().end(), m_verts.begin() + firstVertIndex);
+	}
+
+	if (m_indexFormat == MESH_INDEX_FORMAT_UINT16)
+	{
+		unsigned short const* partIndexes = part.GetIndexes16().data();
+		unsigned short* indexes = m_indexes16.data() + firstIndex;
+		for (int indexIndex = 0; indexIndex < numIndexes; ++indexIndex)
+		{
+			indexes[indexIndex] = (unsigned short)(partIndexes[indexIndex] + firstVertIndex);
+		}
+	}
+	else
+	{
+		unsigned int const* partIndexes = part.GetIndexes32().data();
+		unsigned int* indexes = m_indexes32.data() + firstIndex;
+		for (int indexIndex = 0; indexIndex < numIndexes; ++indexIndex)
+		{
+			indexes[indexIndex] = partIndexes[indexIndex] + (unsigned int)firstVertIndex;
+		}
+	}
+}
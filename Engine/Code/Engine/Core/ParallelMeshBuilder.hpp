@@ -0,0 +1,59 @@
+#pragma once
+#include "Engine/Core/MeshBuilder.hpp"
+
+#include <functional>
+#include <vector>
+
+class Job;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int MESH_PART_ITEMS_PER_JOB = 4096;
+
+
+//--------------------------------------------------------------------------------------------------
+typedef std::function<void(MeshBuilder& out_part, int firstItem, int numItems)> MeshPartBuildFunc;
+
+
+//--------------------------------------------------------------------------------------------------
+// Builds one big mesh on all the JobSystem workers. The items are split into parts in submission
+// order and each part job adds its items to its own MeshBuilder, so no two jobs touch the same
+// arrays. A prefix sum over the parts' vert and index counts then gives every part its place in the
+// final arrays, and a second set of jobs copies the verts there and rebases the indexes. The result
+// is identical to building every item in order on one thread.
+//
+// The parts live as long as the builder and Build() only clears them, so a builder kept across
+// frames settles at zero allocations once the parts have grown to fit.
+//--------------------------------------------------------------------------------------------------
+class ParallelMeshBuilder
+{
+public:
+	explicit ParallelMeshBuilder(MeshIndexFormat indexFormat = MESH_INDEX_FORMAT_UINT32);
+	~ParallelMeshBuilder() {}
+
+	void	Build(int numItems, MeshPartBuildFunc const& buildPart, bool useJobSystem = true, int itemsPerJob = MESH_PART_ITEMS_PER_JOB);
+	void	Clear();
+
+	MeshIndexFormat						GetIndexFormat() const;
+	int									GetNumVerts() const;
+	int									GetNumIndexes() const;
+	std::vector<Vertex_PCU> const&		GetVerts() const;
+	std::vector<unsigned int> const&	GetIndexes32() const;	// Only filled for MESH_INDEX_FORMAT_UINT32
+	std::vector<unsigned short> const&	GetIndexes16() const;	// Only filled for MESH_INDEX_FORMAT_UINT16
+
+private:
+	void	RunJobs(std::vector<Job*> const& jobs, bool useJobSystem);
+	void	MergePart(int partIndex);
+
+	friend class MeshPartMergeJob;
+
+private:
+	MeshIndexFormat				m_indexFormat = MESH_INDEX_FORMAT_UINT32;
+	std::vector<MeshBuilder>	m_parts;
+	std::vector<int>			m_firstVertIndexes;		// Per part, the prefix sums of the part vert counts
+	std::vector<int>			m_firstIndexIndexes;	// Per part, the prefix sums of the part index counts
+	int							m_numParts = 0;			// Parts used by the last Build(); m_parts may hold more
+	std::vector<Vertex_PCU>		m_verts;
+	std::vector<unsigned int>	m_indexes32;
+	std::vector<unsigned short>	m_indexes16;
+};
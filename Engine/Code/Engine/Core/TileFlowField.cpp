@@ -0,0 +1,424 @@
+#include "Engine/Core/TileFlowField.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Game/EngineBuildPreferences.hpp"
+
+#include <queue>
+#include <functional>
+
+
+//--------------------------------------------------------------------------------------------------
+// Neighbor offsets in FlowDirection order, starting at FLOW_DIRECTION_EAST
+static IntVec2 const FLOW_DIRECTION_OFFSETS[FLOW_DIRECTION_COUNT - 1] =
+{
+	IntVec2(1, 0), IntVec2(0, 1), IntVec2(-1, 0), IntVec2(0, -1),
+	IntVec2(1, 1), IntVec2(-1, 1), IntVec2(-1, -1), IntVec2(1, -1),
+};
+
+
+//--------------------------------------------------------------------------------------------------
+class FlowFieldDirectionsJob : public Job
+{
+public:
+	FlowFieldDirectionsJob(TileFlowField& flowField, int firstRow, int numRows) :
+		m_flowField(flowField),
+		m_firstRow(firstRow),
+		m_numRows(numRows)
+	{};
+	virtual void Execute() override
+	{
+		m_flowField.UpdateDirectionsForRows(m_firstRow, m_numRows);
+	}
+
+	TileFlowField&	m_flowField;
+	int				m_firstRow = 0;
+	int				m_numRows = 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+TileFlowField::TileFlowField(IntVec2 const& dimensions)
+	: m_dimensions(dimensions)
+	, m_integrationField(dimensions, FLOW_FIELD_UNREACHABLE_COST)
+{
+	m_tileStepCosts.resize(dimensions.x * dimensions.y, 1);
+	m_directions.resize(dimensions.x * dimensions.y, FLOW_DIRECTION_NONE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The integration field still reflects the old cost until Update(), which the repair relies on
+void TileFlowField::SetTileStepCost(IntVec2 const& tileCoords, unsigned char stepCost)
+{
+	GUARANTEE_OR_DIE(tileCoords.x >= 0 && tileCoords.y >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y < m_dimensions.y, "Tile coords are outside the flow field");
+	PendingTileChange change;
+	change.m_tileIndex = tileCoords.x + (tileCoords.y * m_dimensions.x);
+	change.m_stepCost = stepCost;
+	m_pendingChanges.push_back(change);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TileFlowField::SetAllTileStepCosts(std::vector<unsigned char> const& tileStepCosts)
+{
+	GUARANTEE_OR_DIE(tileStepCosts.size() == m_tileStepCosts.size(), "Tile step cost list must match the flow field's dimensions");
+	m_tileStepCosts = tileStepCosts;
+	m_pendingChanges.clear();
+	m_needsRebuild = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TileFlowField::SetGoalTiles(std::vector<IntVec2> const& goalTiles)
+{
+	m_goalTiles = goalTiles;
+	m_needsRebuild = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TileFlowField::Update(bool useJobSystem)
+{
+	if (!m_needsRebuild && (int)m_pendingChanges.size() > MAX_FLOW_FIELD_CHANGES_FOR_REPAIR)
+	{
+		m_needsRebuild = true;
+	}
+
+	if (m_needsRebuild)
+	{
+		for (int changeIndex = 0; changeIndex < (int)m_pendingChanges.size(); ++changeIndex)
+		{
+			m_tileStepCosts[m_pendingChanges[changeIndex].m_tileIndex] = m_pendingChanges[changeIndex].m_stepCost;
+		}
+		m_pendingChanges.clear();
+		Rebuild(useJobSystem);
+		m_needsRebuild = false;
+	}
+	else if (!m_pendingChanges.empty())
+	{
+		Repair();
+		m_pendingChanges.clear();
+#if defined(ENGINE_VERIFY_FLOW_FIELD_REPAIRS)
+		VerifyMatchesRebuild();
+#endif
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+IntVec2 const& TileFlowField::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+FlowDirection TileFlowField::GetDirectionAt(IntVec2 const& tileCoords) const
+{
+	return (FlowDirection)m_directions[tileCoords.x + (tileCoords.y * m_dimensions.x)];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vec2 const TileFlowField::GetDirectionVectorAt(IntVec2 const& tileCoords) const
+{
+	return GetDirectionVector(GetDirectionAt(tileCoords));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float TileFlowField::GetCostToGoalAt(IntVec2 const& tileCoords) const
+{
+	return m_integrationField.GetHeatValueAt(tileCoords);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+TileHeatMap const& TileFlowField::GetIntegrationField() const
+{
+	return m_integrationField;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<unsigned char> const& TileFlowField::GetDirections() const
+{
+	return m_directions;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vec2 const TileFlowField::GetDirectionVector(FlowDirection direction)
+{
+	if (direction == FLOW_DIRECTION_NONE || direction >= FLOW_DIRECTION_COUNT)
+	{
+		return Vec2(0.f, 0.f);
+	}
+
+	IntVec2 const& offset = FLOW_DIRECTION_OFFSETS[direction - 1];
+	return Vec2((float)offset.x, (float)offset.y).GetNormalized();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The integration field is one sequential solve; the direction field splits into row jobs.
+// Blocked goal tiles are seeded too, so every goal stays at 0
+void TileFlowField::Rebuild(bool useJobSystem)
+{
+	m_integrationField.GenerateDistanceField(m_tileStepCosts, m_goalTiles, FLOW_FIELD_UNREACHABLE_COST, true);
+
+	if (!useJobSystem || !g_theJobSystem || g_theJobSystem->GetNumWorkers() == 0 || m_dimensions.y <= FLOW_FIELD_ROWS_PER_JOB)
+	{
+		UpdateDirectionsForRows(0, m_dimensions.y);
+		return;
+	}
+
+	std::vector<Job*> jobs;
+	for (int firstRow = 0; firstRow < m_dimensions.y; firstRow += FLOW_FIELD_ROWS_PER_JOB)
+	{
+		int numRows = m_dimensions.y - firstRow < FLOW_FIELD_ROWS_PER_JOB ? m_dimensions.y - firstRow : FLOW_FIELD_ROWS_PER_JOB;
+		jobs.push_back(new FlowFieldDirectionsJob(*this, firstRow, numRows));
+	}
+	g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// 1. Starting from the changed tiles, mark every tile whose cost could have come through one of them
+//    (cost == neighbor's cost + own step cost), using the old step costs.
+// 2. Apply the new step costs and reset the marked tiles.
+// 3. Re-solve with Dijkstra, seeding the marked tiles from their unmarked neighbors; improvements
+//    spread past the marked tiles too, which covers costs that went down.
+// 4. Recompute directions around every tile whose cost changed.
+void TileFlowField::Repair()
+{
+	std::vector<float>& costsToGoal = m_integrationField.m_values;
+	int numTiles = (int)costsToGoal.size();
+	auto GetNeighbors4 = [this](int tileIndex, int* out_neighborIndexes)
+	{
+		int tileX = tileIndex % m_dimensions.x;
+		int tileY = tileIndex / m_dimensions.x;
+		int numNeighbors = 0;
+		if (tileX + 1 < m_dimensions.x)	out_neighborIndexes[numNeighbors++] = tileIndex + 1;
+		if (tileX > 0)					out_neighborIndexes[numNeighbors++] = tileIndex - 1;
+		if (tileY + 1 < m_dimensions.y)	out_neighborIndexes[numNeighbors++] = tileIndex + m_dimensions.x;
+		if (tileY > 0)					out_neighborIndexes[numNeighbors++] = tileIndex - m_dimensions.x;
+		return numNeighbors;
+	};
+
+	// 1. Goal tiles stay at 0 whatever their step cost, as in Rebuild(), so they are never marked
+	std::vector<bool> isMarked(numTiles, false);
+	std::vector<int> markedTiles;
+	for (int changeIndex = 0; changeIndex < (int)m_pendingChanges.size(); ++changeIndex)
+	{
+		int tileIndex = m_pendingChanges[changeIndex].m_tileIndex;
+		if (!isMarked[tileIndex] && costsToGoal[tileIndex] != 0.f)
+		{
+			isMarked[tileIndex] = true;
+			markedTiles.push_back(tileIndex);
+		}
+	}
+
+	int neighborIndexes[4];
+	for (int markedIndex = 0; markedIndex < (int)markedTiles.size(); ++markedIndex)
+	{
+		int tileIndex = markedTiles[markedIndex];
+		if (costsToGoal[tileIndex] == FLOW_FIELD_UNREACHABLE_COST)
+		{
+			continue;
+		}
+
+		int numNeighbors = GetNeighbors4(tileIndex, neighborIndexes);
+		for (int neighborNum = 0; neighborNum < numNeighbors; ++neighborNum)
+		{
+			int neighborIndex = neighborIndexes[neighborNum];
+			unsigned char neighborStepCost = m_tileStepCosts[neighborIndex];
+			if (!isMarked[neighborIndex] && neighborStepCost != 0 && costsToGoal[neighborIndex] == costsToGoal[tileIndex] + (float)neighborStepCost)
+			{
+				isMarked[neighborIndex] = true;
+				markedTiles.push_back(neighborIndex);
+			}
+		}
+	}
+
+	// 2.
+	for (int changeIndex = 0; changeIndex < (int)m_pendingChanges.size(); ++changeIndex)
+	{
+		m_tileStepCosts[m_pendingChanges[changeIndex].m_tileIndex] = m_pendingChanges[changeIndex].m_stepCost;
+	}
+
+	std::vector<int> changedTiles = markedTiles;
+	for (int markedIndex = 0; markedIndex < (int)markedTiles.size(); ++markedIndex)
+	{
+		costsToGoal[markedTiles[markedIndex]] = FLOW_FIELD_UNREACHABLE_COST;
+	}
+
+	// 3.
+	typedef std::pair<float, int> CostAndTile;
+	std::priority_queue<CostAndTile, std::vector<CostAndTile>, std::greater<CostAndTile>> openTiles;
+	for (int markedIndex = 0; markedIndex < (int)markedTiles.size(); ++markedIndex)
+	{
+		int tileIndex = markedTiles[markedIndex];
+		unsigned char stepCost = m_tileStepCosts[tileIndex];
+		if (stepCost == 0)
+		{
+			continue;
+		}
+
+		float bestCost = FLOW_FIELD_UNREACHABLE_COST;
+		int numNeighbors = GetNeighbors4(tileIndex, neighborIndexes);
+		for (int neighborNum = 0; neighborNum < numNeighbors; ++neighborNum)
+		{
+			int neighborIndex = neighborIndexes[neighborNum];
+			if (!isMarked[neighborIndex] && costsToGoal[neighborIndex] != FLOW_FIELD_UNREACHABLE_COST && costsToGoal[neighborIndex] + (float)stepCost < bestCost)
+			{
+				bestCost = costsToGoal[neighborIndex] + (float)stepCost;
+			}
+		}
+
+		if (bestCost < FLOW_FIELD_UNREACHABLE_COST)
+		{
+			costsToGoal[tileIndex] = bestCost;
+			openTiles.push(CostAndTile(bestCost, tileIndex));
+		}
+	}
+
+	while (!openTiles.empty())
+	{
+		CostAndTile costAndTile = openTiles.top();
+		openTiles.pop();
+		if (costAndTile.first > costsToGoal[costAndTile.second])
+		{
+			continue;
+		}
+
+		int numNeighbors = GetNeighbors4(costAndTile.second, neighborIndexes);
+		for (int neighborNum = 0; neighborNum < numNeighbors; ++neighborNum)
+		{
+			int neighborIndex = neighborIndexes[neighborNum];
+			unsigned char neighborStepCost = m_tileStepCosts[neighborIndex];
+			float neighborCost = costAndTile.first + (float)neighborStepCost;
+			if (neighborStepCost != 0 && neighborCost < costsToGoal[neighborIndex])
+			{
+				if (!isMarked[neighborIndex])
+				{
+					isMarked[neighborIndex] = true;
+					changedTiles.push_back(neighborIndex);
+				}
+				costsToGoal[neighborIndex] = neighborCost;
+				openTiles.push(CostAndTile(neighborCost, neighborIndex));
+			}
+		}
+	}
+
+	m_integrationField.MarkValuesChanged();
+
+	// 4. A tile's direction depends on its own step cost and on its 8 neighbors' costs and step costs
+	for (int changeIndex = 0; changeIndex < (int)m_pendingChanges.size(); ++changeIndex)
+	{
+		changedTiles.push_back(m_pendingChanges[changeIndex].m_tileIndex);
+	}
+
+	std::vector<bool> isDirectionUpdated(numTiles, false);
+	for (int changedIndex = 0; changedIndex < (int)changedTiles.size(); ++changedIndex)
+	{
+		int changedX = changedTiles[changedIndex] % m_dimensions.x;
+		int changedY = changedTiles[changedIndex] / m_dimensions.x;
+		for (int tileY = changedY - 1; tileY <= changedY + 1; ++tileY)
+		{
+			for (int tileX = changedX - 1; tileX <= changedX + 1; ++tileX)
+			{
+				if (tileX < 0 || tileY < 0 || tileX >= m_dimensions.x || tileY >= m_dimensions.y)
+				{
+					continue;
+				}
+
+				int tileIndex = tileX + (tileY * m_dimensions.x);
+				if (!isDirectionUpdated[tileIndex])
+				{
+					isDirectionUpdated[tileIndex] = true;
+					UpdateDirectionAt(tileX, tileY);
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TileFlowField::UpdateDirectionsForRows(int firstRow, int numRows)
+{
+	for (int tileY = firstRow; tileY < firstRow + numRows; ++tileY)
+	{
+		for (int tileX = 0; tileX < m_dimensions.x; ++tileX)
+		{
+			UpdateDirectionAt(tileX, tileY);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Heads for the neighbor with the lowest cost to goal, if it is lower than this tile's; the first
+// direction wins ties, and diagonals are skipped when they would cut past a blocked corner
+void TileFlowField::UpdateDirectionAt(int tileX, int tileY)
+{
+	int tileIndex = tileX + (tileY * m_dimensions.x);
+	std::vector<float> const& costsToGoal = m_integrationField.m_values;
+	float bestCost = costsToGoal[tileIndex];
+	unsigned char bestDirection = FLOW_DIRECTION_NONE;
+	if (m_tileStepCosts[tileIndex] == 0 || bestCost == 0.f || bestCost == FLOW_FIELD_UNREACHABLE_COST)
+	{
+		m_directions[tileIndex] = FLOW_DIRECTION_NONE;
+		return;
+	}
+
+	auto IsTileOpen = [this](int x, int y)
+	{
+		return x >= 0 && y >= 0 && x < m_dimensions.x && y < m_dimensions.y && m_tileStepCosts[x + (y * m_dimensions.x)] != 0;
+	};
+
+	for (int direction = FLOW_DIRECTION_EAST; direction < FLOW_DIRECTION_COUNT; ++direction)
+	{
+		IntVec2 const& offset = FLOW_DIRECTION_OFFSETS[direction - 1];
+		int neighborX = tileX + offset.x;
+		int neighborY = tileY + offset.y;
+		bool isNeighborInBounds = neighborX >= 0 && neighborY >= 0 && neighborX < m_dimensions.x && neighborY < m_dimensions.y;
+		if (!isNeighborInBounds || (!IsTileOpen(neighborX, neighborY) && costsToGoal[neighborX + (neighborY * m_dimensions.x)] != 0.f))
+		{
+			continue; // Blocked goal tiles still cost 0, so they can be headed for like open ones
+		}
+
+		bool isDiagonal = offset.x != 0 && offset.y != 0;
+		if (isDiagonal && (!IsTileOpen(neighborX, tileY) || !IsTileOpen(tileX, neighborY)))
+		{
+			continue;
+		}
+
+		float neighborCost = costsToGoal[neighborX + (neighborY * m_dimensions.x)];
+		if (neighborCost < bestCost)
+		{
+			bestCost = neighborCost;
+			bestDirection = (unsigned char)direction;
+		}
+	}
+	m_directions[tileIndex] = bestDirection;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Rebuilds a copy from the current step costs and goals; a repair that disagrees with it is a bug
+void TileFlowField::VerifyMatchesRebuild() const
+{
+	TileFlowField rebuiltField(m_dimensions);
+	rebuiltField.SetAllTileStepCosts(m_tileStepCosts);
+	rebuiltField.SetGoalTiles(m_goalTiles);
+	rebuiltField.Update(false);
+	GUARANTEE_OR_DIE(rebuiltField.m_integrationField.m_values == m_integrationField.m_values, "Flow field repair left different costs than a full rebuild");
+	GUARANTEE_OR_DIE(rebuiltField.m_directions == m_directions, "Flow field repair left different directions than a full rebuild");
+}
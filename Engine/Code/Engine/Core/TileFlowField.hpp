@@ -0,0 +1,90 @@
+#pragma once
+#include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+enum FlowDirection : unsigned char
+{
+	FLOW_DIRECTION_NONE = 0,	// Goal, blocked or unreachable tiles
+
+	FLOW_DIRECTION_EAST,
+	FLOW_DIRECTION_NORTH,
+	FLOW_DIRECTION_WEST,
+	FLOW_DIRECTION_SOUTH,
+	FLOW_DIRECTION_NORTHEAST,
+	FLOW_DIRECTION_NORTHWEST,
+	FLOW_DIRECTION_SOUTHWEST,
+	FLOW_DIRECTION_SOUTHEAST,
+
+	FLOW_DIRECTION_COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr float FLOW_FIELD_UNREACHABLE_COST		= FLT_MAX;
+constexpr int	FLOW_FIELD_ROWS_PER_JOB			= 32;
+constexpr int	MAX_FLOW_FIELD_CHANGES_FOR_REPAIR	= 256;	// More pending tile changes than this and Update() rebuilds from scratch
+
+
+//--------------------------------------------------------------------------------------------------
+// Shared movement field toward a set of goal tiles, for any number of units. The integration field
+// holds each tile's path cost to the nearest goal (a TileHeatMap distance field over per-tile step
+// costs, 0 = blocked); the direction field stores, one byte per tile, which of the 8 neighbors is
+// cheapest to head for (diagonals only when both tiles beside them are open).
+//
+// Goal tiles always cost 0, even when blocked, and their neighbors can still head for them; a
+// blocked goal only has no direction of its own.
+//
+// Step cost changes are queued and applied by the next Update(). A few changes are repaired in
+// place: tiles whose cost may have depended on a changed tile are reset and re-solved from their
+// unchanged neighbors, and only their directions are recomputed. The results match a full rebuild;
+// define ENGINE_VERIFY_FLOW_FIELD_REPAIRS in EngineBuildPreferences.hpp to check every repair against one.
+//--------------------------------------------------------------------------------------------------
+class TileFlowField
+{
+public:
+	explicit TileFlowField(IntVec2 const& dimensions);
+	~TileFlowField() {}
+
+	void	SetTileStepCost(IntVec2 const& tileCoords, unsigned char stepCost);
+	void	SetAllTileStepCosts(std::vector<unsigned char> const& tileStepCosts);
+	void	SetGoalTiles(std::vector<IntVec2> const& goalTiles);
+	void	Update(bool useJobSystem = true);
+
+	IntVec2 const&						GetDimensions() const;
+	FlowDirection						GetDirectionAt(IntVec2 const& tileCoords) const;
+	Vec2 const							GetDirectionVectorAt(IntVec2 const& tileCoords) const;
+	float								GetCostToGoalAt(IntVec2 const& tileCoords) const;
+	TileHeatMap const&					GetIntegrationField() const;
+	std::vector<unsigned char> const&	GetDirections() const;
+
+	static Vec2 const GetDirectionVector(FlowDirection direction);
+
+private:
+	struct PendingTileChange
+	{
+		int				m_tileIndex = -1;
+		unsigned char	m_stepCost = 0;
+	};
+
+	void	Rebuild(bool useJobSystem);
+	void	Repair();
+	void	UpdateDirectionsForRows(int firstRow, int numRows);
+	void	UpdateDirectionAt(int tileX, int tileY);
+	void	VerifyMatchesRebuild() const;
+
+	friend class FlowFieldDirectionsJob;
+
+private:
+	IntVec2							m_dimensions;
+	TileHeatMap						m_integrationField;
+	std::vector<unsigned char>		m_tileStepCosts;
+	std::vector<unsigned char>		m_directions;
+	std::vector<IntVec2>			m_goalTiles;
+	std::vector<PendingTileChange>	m_pendingChanges;
+	bool							m_needsRebuild = true;
+};
@@ -0,0 +1,506 @@
+#include "Engine/Core/TilePathfinder.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+
+//--------------------------------------------------------------------------------------------------
+struct TileOpenNode
+{
+	int m_estimatedTotalCost	= 0;
+	int m_costSoFar				= 0;
+	int m_tileIndex				= -1;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Per-thread scratch space for searches, sized to the whole grid once. Tiles only count as visited
+// (or as targets) when their stamp matches the current search, so nothing needs clearing between searches.
+//--------------------------------------------------------------------------------------------------
+struct TilePathSearchContext
+{
+	explicit TilePathSearchContext(int numTiles);
+	void BeginSearch();
+
+	std::vector<int>			m_costsSoFar;
+	std::vector<int>			m_parentIndexes;
+	std::vector<unsigned int>	m_visitStamps;
+	std::vector<unsigned int>	m_targetStamps;
+	std::vector<int>			m_targetPathSteps;
+	std::vector<TileOpenNode>	m_openHeap;
+	unsigned int				m_currentStamp = 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+TilePathSearchContext::TilePathSearchContext(int numTiles)
+	: m_costsSoFar(numTiles, 0)
+	, m_parentIndexes(numTiles, -1)
+	, m_visitStamps(numTiles, 0)
+	, m_targetStamps(numTiles, 0)
+	, m_targetPathSteps(numTiles, -1)
+{
+	m_openHeap.reserve(numTiles);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TilePathSearchContext::BeginSearch()
+{
+	++m_currentStamp;
+	if (m_currentStamp == 0)
+	{
+		std::fill(m_visitStamps.begin(), m_visitStamps.end(), 0);
+		std::fill(m_targetStamps.begin(), m_targetStamps.end(), 0);
+		m_currentStamp = 1;
+	}
+	m_openHeap.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Orders the open heap so the lowest estimated total cost comes out first, preferring the node furthest along on ties
+static bool IsOpenNodeWorse(TileOpenNode const& a, TileOpenNode const& b)
+{
+	if (a.m_estimatedTotalCost != b.m_estimatedTotalCost)
+	{
+		return a.m_estimatedTotalCost > b.m_estimatedTotalCost;
+	}
+	return a.m_costSoFar < b.m_costSoFar;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// A* from startIndex to goalIndex, or Dijkstra to the nearest tile marked as a target when goalIndex is -1.
+// Only tiles within [boundsMins, boundsMaxs] are searched. Returns the tile reached, or -1 if there was none.
+static int SearchTiles(TilePathSearchContext& context, std::vector<unsigned char> const& tileStepCosts, IntVec2 const& dimensions, int startIndex, int goalIndex, IntVec2 const& boundsMins, IntVec2 const& boundsMaxs)
+{
+	IntVec2 goalCoords = goalIndex >= 0 ? IntVec2(goalIndex % dimensions.x, goalIndex / dimensions.x) : IntVec2(0, 0);
+	auto GetEstimatedCostToGoal = [goalIndex, goalCoords](int tileX, int tileY)
+	{
+		// Every step costs at least 1, so Manhattan distance never overestimates
+		return goalIndex < 0 ? 0 : abs(goalCoords.x - tileX) + abs(goalCoords.y - tileY);
+	};
+
+	unsigned int stamp = context.m_currentStamp;
+	context.m_visitStamps[startIndex] = stamp;
+	context.m_costsSoFar[startIndex] = 0;
+	context.m_parentIndexes[startIndex] = -1;
+	context.m_openHeap.push_back({ GetEstimatedCostToGoal(startIndex % dimensions.x, startIndex / dimensions.x), 0, startIndex });
+
+	while (!context.m_openHeap.empty())
+	{
+		std::pop_heap(context.m_openHeap.begin(), context.m_openHeap.end(), IsOpenNodeWorse);
+		TileOpenNode node = context.m_openHeap.back();
+		context.m_openHeap.pop_back();
+		if (node.m_costSoFar > context.m_costsSoFar[node.m_tileIndex])
+		{
+			continue; // Reopened since at a lower cost
+		}
+
+		int tileIndex = node.m_tileIndex;
+		if (goalIndex >= 0 ? tileIndex == goalIndex : context.m_targetStamps[tileIndex] == stamp)
+		{
+			return tileIndex;
+		}
+
+		int tileX = tileIndex % dimensions.x;
+		int tileY = tileIndex / dimensions.x;
+		IntVec2 const neighborCoords[4] = { IntVec2(tileX + 1, tileY), IntVec2(tileX - 1, tileY), IntVec2(tileX, tileY + 1), IntVec2(tileX, tileY - 1) };
+		for (int neighborNum = 0; neighborNum < 4; ++neighborNum)
+		{
+			IntVec2 const& neighbor = neighborCoords[neighborNum];
+			if (neighbor.x < boundsMins.x || neighbor.y < boundsMins.y || neighbor.x > boundsMaxs.x || neighbor.y > boundsMaxs.y)
+			{
+				continue;
+			}
+
+			int neighborIndex = neighbor.x + (neighbor.y * dimensions.x);
+			unsigned char stepCost = tileStepCosts[neighborIndex];
+			if (stepCost == 0)
+			{
+				continue;
+			}
+
+			int neighborCost = node.m_costSoFar + stepCost;
+			if (context.m_visitStamps[neighborIndex] != stamp || neighborCost < context.m_costsSoFar[neighborIndex])
+			{
+				context.m_visitStamps[neighborIndex] = stamp;
+				context.m_costsSoFar[neighborIndex] = neighborCost;
+				context.m_parentIndexes[neighborIndex] = tileIndex;
+				context.m_openHeap.push_back({ neighborCost + GetEstimatedCostToGoal(neighbor.x, neighbor.y), neighborCost, neighborIndex });
+				std::push_heap(context.m_openHeap.begin(), context.m_openHeap.end(), IsOpenNodeWorse);
+			}
+		}
+	}
+	return -1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Appends the searched path from its start to endIndex
+static void AppendSearchedPath(TilePathSearchContext const& context, IntVec2 const& dimensions, int endIndex, std::vector<IntVec2>& out_tiles)
+{
+	int firstNewTile = (int)out_tiles.size();
+	for (int tileIndex = endIndex; tileIndex >= 0; tileIndex = context.m_parentIndexes[tileIndex])
+	{
+		out_tiles.push_back(IntVec2(tileIndex % dimensions.x, tileIndex / dimensions.x));
+	}
+	std::reverse(out_tiles.begin() + firstNewTile, out_tiles.end());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+class TilePathJob : public Job
+{
+public:
+	TilePathJob(TilePathfinder const& pathfinder, TilePathSearchContext& context, std::vector<TilePathfinder::TilePathWork> const& workList, int firstWork, int numWork, std::vector<TilePath>& out_paths) :
+		m_pathfinder(pathfinder),
+		m_context(context),
+		m_workList(workList),
+		m_firstWork(firstWork),
+		m_numWork(numWork),
+		m_outPaths(out_paths)
+	{};
+	virtual void Execute() override
+	{
+		for (int workIndex = m_firstWork; workIndex < m_firstWork + m_numWork; ++workIndex)
+		{
+			TilePathfinder::TilePathWork const& work = m_workList[workIndex];
+			m_pathfinder.SolvePathWork(m_context, work, m_outPaths[work.m_requestIndex]);
+		}
+	}
+
+	TilePathfinder const&								m_pathfinder;
+	TilePathSearchContext&								m_context;
+	std::vector<TilePathfinder::TilePathWork> const&	m_workList;
+	int													m_firstWork = 0;
+	int													m_numWork = 0;
+	std::vector<TilePath>&								m_outPaths;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+TilePathfinder::TilePathfinder(IntVec2 const& dimensions, int cacheRegionSize)
+	: m_dimensions(dimensions)
+	, m_cacheRegionSize(cacheRegionSize)
+{
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0 && cacheRegionSize > 0, "TilePathfinder needs positive dimensions and cache region size");
+	m_numRegions = IntVec2((dimensions.x + cacheRegionSize - 1) / cacheRegionSize, (dimensions.y + cacheRegionSize - 1) / cacheRegionSize);
+	m_tileStepCosts.resize(dimensions.x * dimensions.y, 1);
+	m_regionVersions.resize(m_numRegions.x * m_numRegions.y, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+TilePathfinder::~TilePathfinder()
+{
+	for (int contextIndex = 0; contextIndex < (int)m_searchContexts.size(); ++contextIndex)
+	{
+		delete m_searchContexts[contextIndex];
+	}
+	m_searchContexts.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TilePathfinder::SetTileStepCost(IntVec2 const& tileCoords, unsigned char stepCost)
+{
+	GUARANTEE_OR_DIE(IsTileInBounds(tileCoords), "Tile coords are outside the pathfinder's grid");
+	int tileIndex = tileCoords.x + (tileCoords.y * m_dimensions.x);
+	unsigned char oldStepCost = m_tileStepCosts[tileIndex];
+	if (stepCost == oldStepCost)
+	{
+		return;
+	}
+
+	m_tileStepCosts[tileIndex] = stepCost;
+	bool isCheaper = stepCost != 0 && (oldStepCost == 0 || stepCost < oldStepCost);
+	if (isCheaper)
+	{
+		ClearPathCache();
+	}
+	else
+	{
+		++m_regionVersions[GetRegionIndexForTile(tileIndex)];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TilePathfinder::SetAllTileStepCosts(std::vector<unsigned char> const& tileStepCosts)
+{
+	GUARANTEE_OR_DIE(tileStepCosts.size() == m_tileStepCosts.size(), "Tile step cost list must match the pathfinder's dimensions");
+	m_tileStepCosts = tileStepCosts;
+	ClearPathCache();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned char TilePathfinder::GetTileStepCost(IntVec2 const& tileCoords) const
+{
+	return m_tileStepCosts[tileCoords.x + (tileCoords.y * m_dimensions.x)];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+IntVec2 const& TilePathfinder::GetDimensions() const
+{
+	return m_dimensions;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TilePathfinder::ClearPathCache()
+{
+	m_cachedPaths.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int TilePathfinder::GetNumCachedPaths() const
+{
+	return (int)m_cachedPaths.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool TilePathfinder::FindPath(IntVec2 const& start, IntVec2 const& goal, TilePath& out_path)
+{
+	std::vector<TilePathRequest> requests = { { start, goal } };
+	std::vector<TilePath> paths;
+	FindPaths(requests, paths, false);
+	out_path = std::move(paths[0]);
+	return out_path.m_isFound;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Cache lookups and insertions happen here on the calling thread; only the searches run as jobs.
+// Requests sharing an uncached key wait for the first of them to be solved, then reuse its path.
+void TilePathfinder::FindPaths(std::vector<TilePathRequest> const& requests, std::vector<TilePath>& out_paths, bool useJobSystem)
+{
+	out_paths.clear();
+	out_paths.resize(requests.size());
+
+	std::vector<TilePathWork> workList;
+	std::vector<TilePathWork> deferredWork;
+	std::unordered_set<unsigned long long> keysBeingSolved;
+	for (int requestIndex = 0; requestIndex < (int)requests.size(); ++requestIndex)
+	{
+		TilePathRequest const& request = requests[requestIndex];
+		if (!IsTileInBounds(request.m_start) || !IsTileInBounds(request.m_goal) || GetTileStepCost(request.m_goal) == 0)
+		{
+			continue;
+		}
+
+		TilePathWork work;
+		work.m_requestIndex = requestIndex;
+		work.m_startIndex = request.m_start.x + (request.m_start.y * m_dimensions.x);
+		work.m_goalIndex = request.m_goal.x + (request.m_goal.y * m_dimensions.x);
+		if (work.m_startIndex == work.m_goalIndex)
+		{
+			out_paths[requestIndex].m_tiles.push_back(request.m_start);
+			out_paths[requestIndex].m_isFound = true;
+			continue;
+		}
+
+		unsigned long long cacheKey = GetCacheKey(work.m_startIndex, work.m_goalIndex);
+		auto cachedPathIter = m_cachedPaths.find(cacheKey);
+		if (cachedPathIter != m_cachedPaths.end() && !IsCachedPathValid(cachedPathIter->second))
+		{
+			m_cachedPaths.erase(cachedPathIter);
+			cachedPathIter = m_cachedPaths.end();
+		}
+
+		if (cachedPathIter != m_cachedPaths.end())
+		{
+			work.m_cachedPath = &cachedPathIter->second;
+			workList.push_back(work);
+		}
+		else if (keysBeingSolved.insert(cacheKey).second)
+		{
+			workList.push_back(work);
+		}
+		else
+		{
+			deferredWork.push_back(work);
+		}
+	}
+
+	SolveWorkList(workList, out_paths, useJobSystem);
+	for (int workIndex = 0; workIndex < (int)workList.size(); ++workIndex)
+	{
+		TilePathWork const& work = workList[workIndex];
+		if (!work.m_cachedPath && out_paths[work.m_requestIndex].m_isFound)
+		{
+			AddPathToCache(work.m_startIndex, work.m_goalIndex, out_paths[work.m_requestIndex]);
+		}
+	}
+
+	if (deferredWork.empty())
+	{
+		return;
+	}
+
+	for (int workIndex = 0; workIndex < (int)deferredWork.size(); ++workIndex)
+	{
+		TilePathWork& work = deferredWork[workIndex];
+		auto cachedPathIter = m_cachedPaths.find(GetCacheKey(work.m_startIndex, work.m_goalIndex));
+		work.m_cachedPath = cachedPathIter != m_cachedPaths.end() ? &cachedPathIter->second : nullptr;
+	}
+	SolveWorkList(deferredWork, out_paths, useJobSystem);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool TilePathfinder::IsTileInBounds(IntVec2 const& tileCoords) const
+{
+	return tileCoords.x >= 0 && tileCoords.y >= 0 && tileCoords.x < m_dimensions.x && tileCoords.y < m_dimensions.y;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int TilePathfinder::GetRegionIndexForTile(int tileIndex) const
+{
+	int regionX = (tileIndex % m_dimensions.x) / m_cacheRegionSize;
+	int regionY = (tileIndex / m_dimensions.x) / m_cacheRegionSize;
+	return regionX + (regionY * m_numRegions.x);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned long long TilePathfinder::GetCacheKey(int startIndex, int goalIndex) const
+{
+	return ((unsigned long long)GetRegionIndexForTile(startIndex) << 32) | (unsigned long long)(unsigned int)goalIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool TilePathfinder::IsCachedPathValid(CachedTilePath const& cachedPath) const
+{
+	for (int regionNum = 0; regionNum < (int)cachedPath.m_regionIndexes.size(); ++regionNum)
+	{
+		if (m_regionVersions[cachedPath.m_regionIndexes[regionNum]] != cachedPath.m_regionVersionsWhenCached[regionNum])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TilePathfinder::AddPathToCache(int startIndex, int goalIndex, TilePath const& path)
+{
+	if ((int)m_cachedPaths.size() >= MAX_CACHED_TILE_PATHS)
+	{
+		ClearPathCache();
+	}
+
+	CachedTilePath& cachedPath = m_cachedPaths[GetCacheKey(startIndex, goalIndex)];
+	cachedPath.m_tileIndexes.clear();
+	cachedPath.m_regionIndexes.clear();
+	cachedPath.m_regionVersionsWhenCached.clear();
+	for (int stepIndex = 0; stepIndex < (int)path.m_tiles.size(); ++stepIndex)
+	{
+		int tileIndex = path.m_tiles[stepIndex].x + (path.m_tiles[stepIndex].y * m_dimensions.x);
+		cachedPath.m_tileIndexes.push_back(tileIndex);
+
+		int regionIndex = GetRegionIndexForTile(tileIndex);
+		if (std::find(cachedPath.m_regionIndexes.begin(), cachedPath.m_regionIndexes.end(), regionIndex) == cachedPath.m_regionIndexes.end())
+		{
+			cachedPath.m_regionIndexes.push_back(regionIndex);
+			cachedPath.m_regionVersionsWhenCached.push_back(m_regionVersions[regionIndex]);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Tries joining the cached path from within the start's region first, then falls back to a full search
+void TilePathfinder::SolvePathWork(TilePathSearchContext& context, TilePathWork const& work, TilePath& out_path) const
+{
+	if (work.m_cachedPath)
+	{
+		std::vector<int> const& cachedTiles = work.m_cachedPath->m_tileIndexes;
+		IntVec2 regionMins = IntVec2((work.m_startIndex % m_dimensions.x) / m_cacheRegionSize, (work.m_startIndex / m_dimensions.x) / m_cacheRegionSize);
+		regionMins = IntVec2(regionMins.x * m_cacheRegionSize, regionMins.y * m_cacheRegionSize);
+		IntVec2 regionMaxs = IntVec2(std::min(regionMins.x + m_cacheRegionSize, m_dimensions.x) - 1, std::min(regionMins.y + m_cacheRegionSize, m_dimensions.y) - 1);
+
+		context.BeginSearch();
+		for (int stepIndex = 0; stepIndex < (int)cachedTiles.size(); ++stepIndex)
+		{
+			int tileIndex = cachedTiles[stepIndex];
+			context.m_targetStamps[tileIndex] = context.m_currentStamp;
+			context.m_targetPathSteps[tileIndex] = stepIndex;
+		}
+
+		int joinIndex = SearchTiles(context, m_tileStepCosts, m_dimensions, work.m_startIndex, -1, regionMins, regionMaxs);
+		if (joinIndex >= 0)
+		{
+			AppendSearchedPath(context, m_dimensions, joinIndex, out_path.m_tiles);
+			for (int stepIndex = context.m_targetPathSteps[joinIndex] + 1; stepIndex < (int)cachedTiles.size(); ++stepIndex)
+			{
+				out_path.m_tiles.push_back(IntVec2(cachedTiles[stepIndex] % m_dimensions.x, cachedTiles[stepIndex] / m_dimensions.x));
+			}
+			out_path.m_isFound = true;
+			out_path.m_usedCache = true;
+			return;
+		}
+	}
+
+	context.BeginSearch();
+	int reachedIndex = SearchTiles(context, m_tileStepCosts, m_dimensions, work.m_startIndex, work.m_goalIndex, IntVec2(0, 0), m_dimensions - IntVec2(1, 1));
+	if (reachedIndex >= 0)
+	{
+		AppendSearchedPath(context, m_dimensions, reachedIndex, out_path.m_tiles);
+		out_path.m_isFound = true;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// One job (and search context) per worker plus the main thread, each taking an even share of the work
+void TilePathfinder::SolveWorkList(std::vector<TilePathWork> const& workList, std::vector<TilePath>& out_paths, bool useJobSystem)
+{
+	if (workList.empty())
+	{
+		return;
+	}
+
+	int numJobs = 1;
+	if (useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0)
+	{
+		int maxUsefulJobs = ((int)workList.size() + TILE_PATH_REQUESTS_PER_JOB - 1) / TILE_PATH_REQUESTS_PER_JOB;
+		numJobs = std::min(g_theJobSystem->GetNumWorkers() + 1, maxUsefulJobs);
+	}
+
+	while ((int)m_searchContexts.size() < numJobs)
+	{
+		m_searchContexts.push_back(new TilePathSearchContext(m_dimensions.x * m_dimensions.y));
+	}
+
+	if (numJobs == 1)
+	{
+		TilePathJob job(*this, *m_searchContexts[0], workList, 0, (int)workList.size(), out_paths);
+		job.Execute();
+		return;
+	}
+
+	std::vector<Job*> jobs;
+	for (int jobIndex = 0; jobIndex < numJobs; ++jobIndex)
+	{
+		int firstWork = (jobIndex * (int)workList.size()) / numJobs;
+		int endWork = ((jobIndex + 1) * (int)workList.size()) / numJobs;
+		jobs.push_back(new TilePathJob(*this, *m_searchContexts[jobIndex], workList, firstWork, endWork - firstWork, out_paths));
+	}
+	g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+#include <unordered_map>
+
+
+//--------------------------------------------------------------------------------------------------
+struct TilePathSearchContext;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int TILE_PATH_CACHE_REGION_SIZE	= 8;	// Tiles per side of a cache region
+constexpr int MAX_CACHED_TILE_PATHS			= 4096;	// The cache is emptied when it grows past this
+constexpr int TILE_PATH_REQUESTS_PER_JOB	= 32;
+
+
+//--------------------------------------------------------------------------------------------------
+struct TilePathRequest
+{
+	IntVec2 m_start;
+	IntVec2 m_goal;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct TilePath
+{
+	std::vector<IntVec2>	m_tiles;				// Start to goal, both included
+	bool					m_isFound		= false;
+	bool					m_usedCache		= false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// A* over a grid of per-tile step costs (the cost of entering a tile, 0 = blocked), moving 4-way.
+// Batches of requests are split across the JobSystem; each job searches with its own pooled
+// search context, so searches allocate nothing beyond their output paths.
+//
+// Found paths are cached by (start region, goal). A later request from anywhere in the same region
+// to the same goal only searches within its region until it joins the cached path, which makes the
+// result near-optimal rather than optimal. Raising a tile's cost or blocking it invalidates cached
+// paths through that tile's region; lowering a cost can open shortcuts anywhere, so it empties the cache.
+//--------------------------------------------------------------------------------------------------
+class TilePathfinder
+{
+	friend class TilePathJob;
+public:
+	explicit TilePathfinder(IntVec2 const& dimensions, int cacheRegionSize = TILE_PATH_CACHE_REGION_SIZE);
+	~TilePathfinder();
+
+	void			SetTileStepCost(IntVec2 const& tileCoords, unsigned char stepCost);
+	void			SetAllTileStepCosts(std::vector<unsigned char> const& tileStepCosts);
+	unsigned char	GetTileStepCost(IntVec2 const& tileCoords) const;
+	IntVec2 const&	GetDimensions() const;
+
+	void			ClearPathCache();
+	int				GetNumCachedPaths() const;
+
+	bool	FindPath(IntVec2 const& start, IntVec2 const& goal, TilePath& out_path);
+	void	FindPaths(std::vector<TilePathRequest> const& requests, std::vector<TilePath>& out_paths, bool useJobSystem = true);
+
+private:
+	struct CachedTilePath
+	{
+		std::vector<int>			m_tileIndexes;
+		std::vector<int>			m_regionIndexes;			// Every region the path passes through, once each
+		std::vector<unsigned int>	m_regionVersionsWhenCached;
+	};
+
+	struct TilePathWork
+	{
+		int						m_requestIndex	= -1;
+		int						m_startIndex	= -1;
+		int						m_goalIndex		= -1;
+		CachedTilePath const*	m_cachedPath	= nullptr;
+	};
+
+	bool				IsTileInBounds(IntVec2 const& tileCoords) const;
+	int					GetRegionIndexForTile(int tileIndex) const;
+	unsigned long long	GetCacheKey(int startIndex, int goalIndex) const;
+	bool				IsCachedPathValid(CachedTilePath const& cachedPath) const;
+	void				AddPathToCache(int startIndex, int goalIndex, TilePath const& path);
+	void				SolvePathWork(TilePathSearchContext& context, TilePathWork const& work, TilePath& out_path) const;
+	void				SolveWorkList(std::vector<TilePathWork> const& workList, std::vector<TilePath>& out_paths, bool useJobSystem);
+
+private:
+	IntVec2										m_dimensions;
+	int											m_cacheRegionSize	= TILE_PATH_CACHE_REGION_SIZE;
+	IntVec2										m_numRegions;
+	std::vector<unsigned char>					m_tileStepCosts;
+	std::vector<unsigned int>					m_regionVersions;
+	std::unordered_map<unsigned long long, CachedTilePath>	m_cachedPaths;
+	std::vector<TilePathSearchContext*>			m_searchContexts;
+};
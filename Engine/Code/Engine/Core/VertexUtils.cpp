@@ -3,6 +3,340 @@
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Mat44.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+#include <map>
+#include <math.h>
+#include <mutex>
+#include <shared_mutex>
+#include <string.h>
+#include <xmmintrin.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Round primitives only depend on their tessellation, so each one is built once as a unit mesh
+// (white, UVs across ZERO_TO_ONE) and every later call just transforms and tints a copy of it.
+//--------------------------------------------------------------------------------------------------
+enum UnitMeshShape : unsigned char
+{
+	UNIT_MESH_DISC_2D,				// Radius 1 around the origin, in XY
+	UNIT_MESH_UV_SPHERE_Z_3D,		// Radius 1 around the origin
+	UNIT_MESH_CYLINDER_X_3D,		// Radius 1, from x = 0 to x = 1
+	UNIT_MESH_CYLINDER_Z_3D,		// Radius 1, from z = 0 to z = 1
+	UNIT_MESH_CONE_X_3D,			// Radius 1 at x = 0, tip at x = 1
+
+	UNIT_MESH_SHAPE_COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct UnitMeshKey
+{
+	UnitMeshShape	m_shape = UNIT_MESH_DISC_2D;
+	float			m_numSlices = 0.f;
+	float			m_numStacks = 0.f;
+
+	bool operator<(UnitMeshKey const& compare) const
+	{
+		if (m_shape != compare.m_shape)
+		{
+			return m_shape < compare.m_shape;
+		}
+		if (m_numSlices != compare.m_numSlices)
+		{
+			return m_numSlices < compare.m_numSlices;
+		}
+		return m_numStacks < compare.m_numStacks;
+	}
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static std::map<UnitMeshKey, std::vector<Vertex_PCU>>	s_unitMeshes;
+static std::shared_mutex								s_unitMeshesMutex;
+
+
+//--------------------------------------------------------------------------------------------------
+static void BuildUnitDisc2D(std::vector<Vertex_PCU>& unitVerts, int numOfTriangles)
+{
+	float degreesPerSide = 360.f / (float)numOfTriangles;
+	float currentOrientation = 0.f;
+
+	for (int sideNum = 0; sideNum < numOfTriangles; ++sideNum)
+	{
+		Vec3 vertex1 = MakeFromPolarDegrees(currentOrientation, 1.f);
+		Vec3 vertex2 = MakeFromPolarDegrees(currentOrientation + degreesPerSide, 1.f);
+
+		unitVerts.push_back(Vertex_PCU(Vec3(0.f, 0.f, 0.f), Rgba8::WHITE, Vec2(0.5f, 0.5f)));
+		unitVerts.push_back(Vertex_PCU(vertex1, Rgba8::WHITE, Vec2(RangeMap(vertex1.x, -1.f, 1.f, 0.f, 1.f), RangeMap(vertex1.y, -1.f, 1.f, 0.f, 1.f))));
+		unitVerts.push_back(Vertex_PCU(vertex2, Rgba8::WHITE, Vec2(RangeMap(vertex2.x, -1.f, 1.f, 0.f, 1.f), RangeMap(vertex2.y, -1.f, 1.f, 0.f, 1.f))));
+
+		currentOrientation = currentOrientation + degreesPerSide;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Slices go around the yaw and stacks from pitch -90 to 90
+static void BuildUnitSphere3D(std::vector<Vertex_PCU>& unitVerts, float numSlices, float numStacks)
+{
+	float degreesPerSlice = 360.f / numSlices;
+	float degreesPerStack = 180.f / numStacks;
+	float currentYawDegrees = 0.f;
+
+	for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
+	{
+		float currentPitchDegrees = -90.0f;
+		for (int stackNum = 0; stackNum < numStacks; ++stackNum)
+		{
+			Vec3 TL = Vec3::MakeFromPolarDegrees(currentPitchDegrees, currentYawDegrees, 1.f);
+			Vec3 TR = Vec3::MakeFromPolarDegrees(currentPitchDegrees, currentYawDegrees + degreesPerSlice, 1.f);
+			Vec3 BR = Vec3::MakeFromPolarDegrees(currentPitchDegrees + degreesPerStack, currentYawDegrees + degreesPerSlice, 1.f);
+			Vec3 BL = Vec3::MakeFromPolarDegrees(currentPitchDegrees + degreesPerStack, currentYawDegrees, 1.f);
+
+			Vec2 uvBL;
+			uvBL.x = RangeMapClamped(currentYawDegrees, 0.f, 360.f, 0.f, 1.f);
+			uvBL.y = RangeMapClamped(currentPitchDegrees + degreesPerStack, -90.f, 90.f, 1.f, 0.f);
+
+			Vec2 uvTR;
+			uvTR.x = RangeMapClamped(currentYawDegrees + degreesPerSlice, 0.f, 360.f, 0.f, 1.f);
+			uvTR.y = RangeMapClamped(currentPitchDegrees, -90.f, 90.f, 1.f, 0.f);
+
+			AddVertsForQuad3D(unitVerts, BL, BR, TR, TL, Rgba8::WHITE, AABB2(uvBL.x, uvBL.y, uvTR.x, uvTR.y));
+
+			currentPitchDegrees += degreesPerStack;
+		}
+		currentYawDegrees += degreesPerSlice;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void BuildUnitCylinderZ3D(std::vector<Vertex_PCU>& unitVerts, float numSlices)
+{
+	Vec3 sectorMinTip = Vec3(0.f, 0.f, 0.f);
+	Vec3 sectorMaxTip = Vec3(0.f, 0.f, 1.f);
+	Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
+	float currentYawDegrees = 0.f;
+	float degreesPerYawSlice = 360.f / numSlices;
+
+	for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
+	{
+		Vec3 currentSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, 1.f);
+		Vec2 currentSectorVert1UV = Vec2(RangeMap(currentSectorVert1.x, -1.f, 1.f, 0.f, 1.f), RangeMap(currentSectorVert1.y, -1.f, 1.f, 0.f, 1.f));
+		Vec3 currentSectorVert2 = MakeFromPolarDegrees(currentYawDegrees + degreesPerYawSlice, 1.f);
+		Vec2 currentSectorVert2UV = Vec2(RangeMap(currentSectorVert2.x, -1.f, 1.f, 0.f, 1.f), RangeMap(currentSectorVert2.y, -1.f, 1.f, 0.f, 1.f));
+
+		Vec3 currentSectorMinVert1 = sectorMinTip + currentSectorVert1;
+		Vec3 currentSectorMinVert2 = sectorMinTip + currentSectorVert2;
+
+		unitVerts.push_back(Vertex_PCU(currentSectorMinVert2, Rgba8::WHITE, Vec2(currentSectorVert2UV.x, 1.f - currentSectorVert2UV.y)));
+		unitVerts.push_back(Vertex_PCU(currentSectorMinVert1, Rgba8::WHITE, Vec2(currentSectorVert1UV.x, 1.f - currentSectorVert1UV.y)));
+		unitVerts.push_back(Vertex_PCU(sectorMinTip, Rgba8::WHITE, sectorTipUV));
+
+		Vec3 currentSectorMaxVert1 = sectorMaxTip + currentSectorVert1;
+		Vec3 currentSectorMaxVert2 = sectorMaxTip + currentSectorVert2;
+
+		unitVerts.push_back(Vertex_PCU(currentSectorMaxVert1, Rgba8::WHITE, currentSectorVert1UV));
+		unitVerts.push_back(Vertex_PCU(currentSectorMaxVert2, Rgba8::WHITE, currentSectorVert2UV));
+		unitVerts.push_back(Vertex_PCU(sectorMaxTip, Rgba8::WHITE, sectorTipUV));
+
+		Vec2 currentCylinderUVBL = Vec2(RangeMapClamped(currentYawDegrees, 0.f, 360.f, 0.f, 1.f), 0.f);
+		Vec2 currentCylinderUVTR = Vec2(RangeMapClamped(currentYawDegrees + degreesPerYawSlice, 0.f, 360.f, 0.f, 1.f), 1.f);
+
+		AddVertsForQuad3D(unitVerts, currentSectorMinVert1, currentSectorMinVert2, currentSectorMaxVert2, currentSectorMaxVert1, Rgba8::WHITE, AABB2(currentCylinderUVBL, currentCylinderUVTR));
+
+		currentYawDegrees += degreesPerYawSlice;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void BuildUnitConeX3D(std::vector<Vertex_PCU>& unitVerts, float numSlices)
+{
+	Vec3 sectorMinTip = Vec3(0.f, 0.f, 0.f);
+	Vec3 sectorMaxTip = Vec3(1.f, 0.f, 0.f);
+	Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
+	float currentYawDegrees = 0.f;
+	float degreesPerYawSlice = 360.f / numSlices;
+
+	for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
+	{
+		Vec3 currentSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, 1.f);
+		currentSectorVert1.z = currentSectorVert1.x;
+		currentSectorVert1.x = 0.f;
+		Vec3 currentSectorVert2 = MakeFromPolarDegrees(currentYawDegrees + degreesPerYawSlice, 1.f);
+		currentSectorVert2.z = currentSectorVert2.x;
+		currentSectorVert2.x = 0.f;
+
+		Vec2 currentSectorVert1UV = Vec2(RangeMap(currentSectorVert1.z, -1.f, 1.f, 0.f, 1.f), RangeMap(currentSectorVert1.y, -1.f, 1.f, 0.f, 1.f));
+		Vec2 currentSectorVert2UV = Vec2(RangeMap(currentSectorVert2.z, -1.f, 1.f, 0.f, 1.f), RangeMap(currentSectorVert2.y, -1.f, 1.f, 0.f, 1.f));
+
+		unitVerts.push_back(Vertex_PCU(currentSectorVert1, Rgba8::WHITE, Vec2(currentSectorVert2UV.x, 1.f - currentSectorVert2UV.y)));
+		unitVerts.push_back(Vertex_PCU(currentSectorVert2, Rgba8::WHITE, Vec2(currentSectorVert2UV.x, 1.f - currentSectorVert2UV.y)));
+		unitVerts.push_back(Vertex_PCU(sectorMinTip, Rgba8::WHITE, sectorTipUV));
+
+		unitVerts.push_back(Vertex_PCU(sectorMaxTip, Rgba8::WHITE, sectorTipUV));
+		unitVerts.push_back(Vertex_PCU(currentSectorVert2, Rgba8::WHITE, currentSectorVert1UV));
+		unitVerts.push_back(Vertex_PCU(currentSectorVert1, Rgba8::WHITE, currentSectorVert2UV));
+
+		currentYawDegrees += degreesPerYawSlice;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Cached meshes are never removed, so the returned reference stays valid once the lock is released.
+// Lookups of built meshes share the lock, so threads only wait on each other while a mesh is built.
+static std::vector<Vertex_PCU> const& GetUnitMesh(UnitMeshShape shape, float numSlices = 0.f, float numStacks = 0.f)
+{
+	UnitMeshKey key;
+	key.m_shape = shape;
+	key.m_numSlices = numSlices;
+	key.m_numStacks = numStacks;
+
+	{
+		std::shared_lock<std::shared_mutex> sharedLock(s_unitMeshesMutex);
+		auto found = s_unitMeshes.find(key);
+		if (found != s_unitMeshes.end())
+		{
+			return found->second;
+		}
+	}
+
+	// Another thread may have built it between the two locks
+	std::unique_lock<std::shared_mutex> lock(s_unitMeshesMutex);
+	auto found = s_unitMeshes.find(key);
+	if (found != s_unitMeshes.end())
+	{
+		return found->second;
+	}
+
+	std::vector<Vertex_PCU>& unitVerts = s_unitMeshes[key];
+	switch (shape)
+	{
+	case UNIT_MESH_DISC_2D:				BuildUnitDisc2D(unitVerts, (int)numSlices);				break;
+	case UNIT_MESH_UV_SPHERE_Z_3D:		BuildUnitSphere3D(unitVerts, numSlices, numStacks);		break;
+	case UNIT_MESH_CYLINDER_X_3D:		AddVertsForUnitCylinderX3D(unitVerts, numSlices, Rgba8::WHITE);	break;
+	case UNIT_MESH_CYLINDER_Z_3D:		BuildUnitCylinderZ3D(unitVerts, numSlices);				break;
+	case UNIT_MESH_CONE_X_3D:			BuildUnitConeX3D(unitVerts, numSlices);					break;
+	default:							break;
+	}
+	return unitVerts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Writes unitVerts with positions transformed, colors set to tint, and UVs mapped from ZERO_TO_ONE
+// into UVs. Each position is transformed in one SSE register whose last lane is replaced by the
+// tint, so position and color go out together as a single 16-byte store.
+//--------------------------------------------------------------------------------------------------
+static void WriteVertsForTransformedUnitMesh(Vertex_PCU* out_verts, std::vector<Vertex_PCU> const& unitVerts, Mat44 const& transform, Rgba8 const& tint, AABB2 const& UVs)
+{
+	static_assert(sizeof(Vertex_PCU) == 24, "Vertex_PCU must be a position, then a color, then UVs");
+
+	int numUnitVerts = (int)unitVerts.size();
+
+	float const* matrixValues = transform.GetAsFloatArray();
+	__m128 iBasis = _mm_loadu_ps(matrixValues + Mat44::Ix);
+	__m128 jBasis = _mm_loadu_ps(matrixValues + Mat44::Jx);
+	__m128 kBasis = _mm_loadu_ps(matrixValues + Mat44::Kx);
+	__m128 translation = _mm_loadu_ps(matrixValues + Mat44::Tx);
+
+	float tintBits;
+	memcpy(&tintBits, &tint, sizeof(tintBits));
+	__m128 tintLanes = _mm_set1_ps(tintBits);
+
+	Vec2 uvMins = UVs.m_mins;
+	Vec2 uvScale = UVs.m_maxs - UVs.m_mins;
+
+	for (int vertIndex = 0; vertIndex < numUnitVerts; ++vertIndex)
+	{
+		Vertex_PCU const& unitVert = unitVerts[vertIndex];
+		Vertex_PCU& outVert = out_verts[vertIndex];
+
+		__m128 position = _mm_add_ps(_mm_mul_ps(iBasis, _mm_set1_ps(unitVert.m_position.x)), _mm_mul_ps(jBasis, _mm_set1_ps(unitVert.m_position.y)));
+		position = _mm_add_ps(position, _mm_add_ps(_mm_mul_ps(kBasis, _mm_set1_ps(unitVert.m_position.z)), translation));
+
+		// (x, y, z, tint): lanes 2 and 3 are gathered first since shuffles take two lanes from each source
+		__m128 zAndTint = _mm_shuffle_ps(position, tintLanes, _MM_SHUFFLE(0, 0, 2, 2));
+		__m128 positionAndTint = _mm_shuffle_ps(position, zAndTint, _MM_SHUFFLE(2, 0, 1, 0));
+		_mm_storeu_ps(&outVert.m_position.x, positionAndTint);
+
+		outVert.m_uvTexCoords.x = uvMins.x + (unitVert.m_uvTexCoords.x * uvScale.x);
+		outVert.m_uvTexCoords.y = uvMins.y + (unitVert.m_uvTexCoords.y * uvScale.y);
+	}
+}
+
+//--------------------------------------------------------------------------------------------------
+// Grows verts by numVerts in one step and returns where the new verts go
+static Vertex_PCU* AppendVerts(std::vector<Vertex_PCU>& verts, int numVerts)
+{
+	size_t firstVertIndex = verts.size();
+	verts.resize(firstVertIndex + numVerts);
+	return verts.data() + firstVertIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static unsigned int* AppendIndexes(std::vector<unsigned int>& indexes, int numIndexes)
+{
+	size_t firstIndex = indexes.size();
+	indexes.resize(firstIndex + numIndexes);
+	return indexes.data() + firstIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Turns 4-vert quads (BL, BR, TR, TL) into the 6-vert triangle lists the non-indexed functions add
+static void AddVertsForQuadsAsTriangles(std::vector<Vertex_PCU>& verts, Vertex_PCU const* quadVerts, int numQuads)
+{
+	Vertex_PCU* triangleVerts = AppendVerts(verts, numQuads * 6);
+	for (int quadIndex = 0; quadIndex < numQuads; ++quadIndex)
+	{
+		Vertex_PCU const* quad = quadVerts + (quadIndex * NUM_VERTS_PER_INDEXED_QUAD);
+		Vertex_PCU* triangles = triangleVerts + (quadIndex * 6);
+		triangles[0] = quad[0];
+		triangles[1] = quad[1];
+		triangles[2] = quad[2];
+		triangles[3] = quad[0];
+		triangles[4] = quad[2];
+		triangles[5] = quad[3];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void AddVertsForTransformedUnitMesh(std::vector<Vertex_PCU>& verts, std::vector<Vertex_PCU> const& unitVerts, Mat44 const& transform, Rgba8 const& tint, AABB2 const& UVs)
+{
+	WriteVertsForTransformedUnitMesh(AppendVerts(verts, (int)unitVerts.size()), unitVerts, transform, tint, UVs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Maps the unit X cylinder and cone from start to end, scaled out to radius
+static Mat44 GetTransformForShapeAlongX3D(Vec3 const& start, Vec3 const& end, float radius)
+{
+	Vec3 dispSE = (end - start);
+	Vec3 iForward = dispSE.GetNormalized();
+
+	Vec3 jLeft = CrossProduct3D(Vec3::Z_AXIS, iForward);
+	if (jLeft == Vec3::WORLD_ORIGIN)
+	{
+		jLeft = Vec3::Y_AXIS;
+	}
+	else
+	{
+		jLeft.Normalize();
+	}
+	Vec3 kUp = CrossProduct3D(iForward, jLeft);
+
+	Mat44 transformationMatrix;
+	float depth = dispSE.GetLength();
+	transformationMatrix.SetIJK3D(iForward * depth, jLeft * radius, kUp * radius);
+	transformationMatrix.SetTranslation3D(start);
+	return transformationMatrix;
+}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -28,7 +362,7 @@ void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, Mat44 transform)
 
 
 //--------------------------------------------------------------------------------------------------
-void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color)
+void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color, int numSlicesPerEnd)
 {
 	Vec2 dispFromBoneStartToBoneEnd = boneEnd - boneStart;
 	Vec2 dispFromBoneStartToBoneEndRotated90Degrees = dispFromBoneStartToBoneEnd.GetRotated90Degrees();
@@ -48,8 +382,7 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart,
 	verts.push_back(Vertex_PCU(Vec3(TL.x, TL.y), color));
 	verts.push_back(Vertex_PCU(Vec3(BL.x, BL.y), color));
 
-	int numOfTriangles = 18;
-	constexpr int vertsPerTriangle = 3;
+	int numOfTriangles = numSlicesPerEnd;
 	float degreesPerSide = 180.f / (float)numOfTriangles;
 
 	float currentOrientation = (TR - boneEnd).GetOrientationDegrees();
@@ -86,31 +419,10 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart,
 
 
 //--------------------------------------------------------------------------------------------------
-void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color)
+void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color, int numSlices)
 {
-	int numOfTriangles = 32;
-	float degreesPerSide = 360.f / (float)numOfTriangles;
-	float currentOrientation = 0.f;
-
-	for (int sideNum = 0; sideNum < numOfTriangles; ++sideNum)
-	{
-		Vec3 sectorTip = Vec3(center.x, center.y);
-		Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
-		Vec3 localVertex1 = MakeFromPolarDegrees(currentOrientation, radius);
-		Vec3 vertex1 = sectorTip + localVertex1;
-		float vertex1U = RangeMap(localVertex1.x, -radius, radius, 0.f, 1.f);
-		float vertex1V = RangeMap(localVertex1.y, -radius, radius, 0.f, 1.f);
-		Vec3 localVertex2 = MakeFromPolarDegrees(currentOrientation + degreesPerSide, radius);
-		Vec3 vertex2 = sectorTip + localVertex2;
-		float vertex2U = RangeMap(localVertex2.x, -radius, radius, 0.f, 1.f);
-		float vertex2V = RangeMap(localVertex2.y, -radius, radius, 0.f, 1.f);
-
-		verts.push_back(Vertex_PCU(sectorTip, color, sectorTipUV));
-		verts.push_back(Vertex_PCU(vertex1, color, Vec2(vertex1U, vertex1V)));
-		verts.push_back(Vertex_PCU(vertex2, color, Vec2(vertex2U, vertex2V)));
-
-		currentOrientation = currentOrientation + degreesPerSide;
-	}
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, 1.f), Vec3(center, 0.f));
+	AddVertsForTransformedUnitMesh(verts, GetUnitMesh(UNIT_MESH_DISC_2D, (float)numSlices), transform, color, AABB2::ZERO_TO_ONE);
 }
 
 
@@ -193,87 +505,16 @@ void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, Rgba8 const& color, AABB2 const& UVs, int numLatitudeSlices)
 {
 	int numLongitudeSlices = 2 * numLatitudeSlices;
-
-	float longitudeSliceAngle = 360.f / numLongitudeSlices;
-	float latitudeSliceAngle = 180.f / numLatitudeSlices;
-	float currentLongitudeAngle = 0.f;
-	float currentLatitudeAngle = -90.f;
-
-	Vec3 BL;
-	Vec3 BR;
-	Vec3 TR;
-	Vec3 TL;
-
-	Vec2 uvBL;
-	Vec2 uvBR;
-	Vec2 uvTR;
-	Vec2 uvTL;
-
-	for (int longitudeSlice = 0; longitudeSlice < numLongitudeSlices; ++longitudeSlice)
-	{
-		currentLatitudeAngle = -90.0f;
-		for (int latitudeSlice = 0; latitudeSlice < numLatitudeSlices; ++latitudeSlice)
-		{
-			TL = center + Vec3::MakeFromPolarDegrees(currentLatitudeAngle, currentLongitudeAngle, radius);
-			TR = center + Vec3::MakeFromPolarDegrees(currentLatitudeAngle, currentLongitudeAngle + (longitudeSliceAngle), radius);
-			BR = center + Vec3::MakeFromPolarDegrees(currentLatitudeAngle + (latitudeSliceAngle), currentLongitudeAngle + (longitudeSliceAngle), radius);
-			BL = center + Vec3::MakeFromPolarDegrees(currentLatitudeAngle + (latitudeSliceAngle), currentLongitudeAngle, radius);
-
-			uvBL.x = RangeMapClamped(currentLongitudeAngle, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-			uvBL.y = RangeMapClamped(currentLatitudeAngle + latitudeSliceAngle, -90.f, 90.f, UVs.m_maxs.y, UVs.m_mins.y);
-
-			uvTR.x = RangeMapClamped(currentLongitudeAngle + longitudeSliceAngle, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-			uvTR.y = RangeMapClamped(currentLatitudeAngle, -90.f, 90.f, UVs.m_maxs.y, UVs.m_mins.y);
-
-			AddVertsForQuad3D(verts, BL, BR, TR, TL, color, AABB2(uvBL.x, uvBL.y, uvTR.x, uvTR.y));
-
-			currentLatitudeAngle += latitudeSliceAngle;
-		}
-		currentLongitudeAngle += longitudeSliceAngle;
-	}
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), center);
+	AddVertsForTransformedUnitMesh(verts, GetUnitMesh(UNIT_MESH_UV_SPHERE_Z_3D, (float)numLongitudeSlices, (float)numLatitudeSlices), transform, color, UVs);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForUVSphereZ3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs)
 {
-	float degreesPerSlice = 360.f / numSlices;
-	float degreesPerStack = 180.f / numStacks;
-	float currentYawDegrees = 0.f;
-	float currentPitchDegrees = -90.f;
-
-	Vec3 BL;
-	Vec3 BR;
-	Vec3 TR;
-	Vec3 TL;
-
-	Vec2 uvBL;
-	Vec2 uvBR;
-	Vec2 uvTR;
-	Vec2 uvTL;
-
-	for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
-	{
-		currentPitchDegrees = -90.0f;
-		for (int stackNum = 0; stackNum < numStacks; ++stackNum)
-		{
-			TL = center + Vec3::MakeFromPolarDegrees(currentPitchDegrees, currentYawDegrees, radius);
-			TR = center + Vec3::MakeFromPolarDegrees(currentPitchDegrees, currentYawDegrees + (degreesPerSlice), radius);
-			BR = center + Vec3::MakeFromPolarDegrees(currentPitchDegrees + (degreesPerStack), currentYawDegrees + (degreesPerSlice), radius);
-			BL = center + Vec3::MakeFromPolarDegrees(currentPitchDegrees + (degreesPerStack), currentYawDegrees, radius);
-
-			uvBL.x = RangeMapClamped(currentYawDegrees, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-			uvBL.y = RangeMapClamped(currentPitchDegrees + degreesPerStack, -90.f, 90.f, UVs.m_maxs.y, UVs.m_mins.y);
-
-			uvTR.x = RangeMapClamped(currentYawDegrees + degreesPerSlice, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-			uvTR.y = RangeMapClamped(currentPitchDegrees, -90.f, 90.f, UVs.m_maxs.y, UVs.m_mins.y);
-
-			AddVertsForQuad3D(verts, BL, BR, TR, TL, tint, AABB2(uvBL.x, uvBL.y, uvTR.x, uvTR.y));
-
-			currentPitchDegrees += degreesPerStack;
-		}
-		currentYawDegrees += degreesPerSlice;
-	}
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), center);
+	AddVertsForTransformedUnitMesh(verts, GetUnitMesh(UNIT_MESH_UV_SPHERE_Z_3D, numSlices, numStacks), transform, tint, UVs);
 }
 
 
@@ -450,66 +691,25 @@ void AddVertsForUnitCylinderX3D(std::vector<Vertex_PCU>& verts, float numSlices,
 //--------------------------------------------------------------------------------------------------
 void AddVertsForCylinderZ3D(std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs)
 {
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, minMaxZ.m_max - minMaxZ.m_min), Vec3(centerXY, minMaxZ.m_min));
+	AddVertsForTransformedUnitMesh(verts, GetUnitMesh(UNIT_MESH_CYLINDER_Z_3D, numSlices), transform, tint, UVs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AddVertsForCylinderZ3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs)
+{
+	// // // MISC // // //
 	Vec3 sectorMinTip = Vec3(centerXY, minMaxZ.m_min);
 	Vec3 sectorMaxTip = Vec3(centerXY, minMaxZ.m_max);
 	Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
 	float currentYawDegrees = 0.f;
 	float degreesPerYawSlice = 360.f / numSlices;
 
-	for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
-	{
-		Vec3 currentSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, radius);
-		float currentSectorVert1U = RangeMap(currentSectorVert1.x, -radius, radius, UVs.m_mins.x, UVs.m_maxs.x);
-		float currentSectorVert1V = RangeMap(currentSectorVert1.y, -radius, radius, UVs.m_mins.y, UVs.m_maxs.y);
-		Vec2 currentSectorVert1UV = Vec2(currentSectorVert1U, currentSectorVert1V);
-		Vec3 currentSectorVert2 = MakeFromPolarDegrees(currentYawDegrees + degreesPerYawSlice, radius);
-		float currentSectorVert2U = RangeMap(currentSectorVert2.x, -radius, radius, UVs.m_mins.x, UVs.m_maxs.x);
-		float currentSectorVert2V = RangeMap(currentSectorVert2.y, -radius, radius, UVs.m_mins.y, UVs.m_maxs.y);
-		Vec2 currentSectorVert2UV = Vec2(currentSectorVert2U, currentSectorVert2V);
-
-		Vec3 currentSectorMinVert1 = sectorMinTip + currentSectorVert1;
-		Vec3 currentSectorMinVert2 = sectorMinTip + currentSectorVert2;
-
-		verts.push_back(Vertex_PCU(currentSectorMinVert2, tint, Vec2(currentSectorVert2UV.x, 1.f - currentSectorVert2UV.y)));
-		verts.push_back(Vertex_PCU(currentSectorMinVert1, tint, Vec2(currentSectorVert1UV.x, 1.f - currentSectorVert1UV.y)));
-		verts.push_back(Vertex_PCU(sectorMinTip, tint, sectorTipUV));
-
-		Vec3 currentSectorMaxVert1 = sectorMaxTip + currentSectorVert1;
-		Vec3 currentSectorMaxVert2 = sectorMaxTip + currentSectorVert2;
-
-		verts.push_back(Vertex_PCU(currentSectorMaxVert1, tint, currentSectorVert1UV));
-		verts.push_back(Vertex_PCU(currentSectorMaxVert2, tint, currentSectorVert2UV));
-		verts.push_back(Vertex_PCU(sectorMaxTip, tint, sectorTipUV));
-
-		Vec2 currentCylinderUVBL;
-		currentCylinderUVBL.x = RangeMapClamped(currentYawDegrees, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-		currentCylinderUVBL.y = UVs.m_mins.y;
-
-		Vec2 currentCylinderUVTR;
-		currentCylinderUVTR.x = RangeMapClamped(currentYawDegrees + degreesPerYawSlice, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-		currentCylinderUVTR.y = UVs.m_maxs.y;
-
-		AddVertsForQuad3D(verts, currentSectorMinVert1, currentSectorMinVert2, currentSectorMaxVert2, currentSectorMaxVert1, tint, AABB2(currentCylinderUVBL, currentCylinderUVTR));
-
-		currentYawDegrees += degreesPerYawSlice;
-	}
-}
-
-
-//--------------------------------------------------------------------------------------------------
-void AddVertsForCylinderZ3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint, AABB2 const& UVs)
-{
-	// // // MISC // // //
-	Vec3 sectorMinTip = Vec3(centerXY, minMaxZ.m_min);
-	Vec3 sectorMaxTip = Vec3(centerXY, minMaxZ.m_max);
-	Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
-	float currentYawDegrees = 0.f;
-	float degreesPerYawSlice = 360.f / numSlices;
-
-	Vec3 prevSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, radius);
-	float prevSectorVert1U = RangeMap(prevSectorVert1.x, -radius, radius, UVs.m_mins.x, UVs.m_maxs.x);
-	float prevSectorVert1V = RangeMap(prevSectorVert1.y, -radius, radius, UVs.m_mins.y, UVs.m_maxs.y);
-	Vec2 prevSectorVert1UV = Vec2(prevSectorVert1U, prevSectorVert1V);
+	Vec3 prevSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, radius);
+	float prevSectorVert1U = RangeMap(prevSectorVert1.x, -radius, radius, UVs.m_mins.x, UVs.m_maxs.x);
+	float prevSectorVert1V = RangeMap(prevSectorVert1.y, -radius, radius, UVs.m_mins.y, UVs.m_maxs.y);
+	Vec2 prevSectorVert1UV = Vec2(prevSectorVert1U, prevSectorVert1V);
 
 	Vec3 prevSectorMinVert1 = sectorMinTip + prevSectorVert1;
 	Vec3 prevSectorMaxVert1 = sectorMaxTip + prevSectorVert1;
@@ -660,166 +860,34 @@ void AddVertsForCylinderZWireframe3D(std::vector<Vertex_PCU>& verts, Vec2 const&
 //--------------------------------------------------------------------------------------------------
 void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
 {
-	Vec3 dispSE = (end - start);
-	Vec3 iForward = dispSE.GetNormalized();
-
-	Vec3 jLeft = CrossProduct3D(Vec3::Z_AXIS, iForward);
-	if (jLeft == Vec3::WORLD_ORIGIN)
-	{
-		jLeft = Vec3::Y_AXIS;
-	}
-	else
-	{
-		jLeft.Normalize();
-	}
-	Vec3 kUp = CrossProduct3D(iForward, jLeft);
-
-	Mat44 transformationMatrix;
-	float depth = dispSE.GetLength();
-	transformationMatrix.SetIJK3D(iForward * depth, jLeft * radius, kUp * radius);
-	transformationMatrix.SetTranslation3D(start);
-
-	AddVertsForUnitCylinderX3D(verts, (float)numSlices, tint, UVs);
-
-	TransformVertexArray3D(verts, transformationMatrix);
-
-	// transformationMatrix.SetTranslation3D(start);
-	// AddVertsForCylinderZ3D(verts, Vec2(0.f, 0.f), FloatRange(0.f, height.GetLength()), radius, (float)numSlices, tint, UVs);
-	// TransformVertexArray3D(verts, transformationMatrix);
-	// 
-	// 
-	// // transformationMatrix.SetTranslation3D(start);
-	// Mat44 minTransformedMat = transformationMatrix;
-	// 
-	// 
-	// // std::vector<Vertex_PCU> verts;
-	// AddVertsForCylinderZ3D(verts, Vec2(start.x, start.y), FloatRange(start.z, start.z + 20.f), radius, (float)numSlices, tint, UVs);
-	// for (int vertIndex = 0; vertIndex < verts.size(); ++vertIndex)
-	// {
-	// 	verts[vertIndex].m_position = minTransformedMat.TransformPosition3D(verts[vertIndex].m_position);
-	// }
-
-	// transformationMatrix.SetTranslation3D(end);
-	// Mat44 maxTransformedMat = transformationMatrix;
-	// 
-	// Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
-	// float currentYawDegrees = 0.f;
-	// float degreesPerYawSlice = 360.f / numSlices;
-	// 
-	// for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
-	// {
-	// 	Vec3 currentSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, radius);
-	// 	currentSectorVert1.z = currentSectorVert1.x;
-	// 	currentSectorVert1.x = 0.f;
-	// 	float currentSectorVert1U = RangeMap(currentSectorVert1.x, -radius, radius, UVs.m_mins.x, UVs.m_maxs.x);
-	// 	float currentSectorVert1V = RangeMap(currentSectorVert1.y, -radius, radius, UVs.m_mins.y, UVs.m_maxs.y);
-	// 	Vec2 currentSectorVert1UV = Vec2(currentSectorVert1U, currentSectorVert1V);
-	// 	Vec3 currentSectorVert2 = MakeFromPolarDegrees(currentYawDegrees + degreesPerYawSlice, radius);
-	// 	currentSectorVert2.z = currentSectorVert2.x;
-	// 	currentSectorVert2.x = 0.f;
-	// 	float currentSectorVert2U = RangeMap(currentSectorVert2.z, -radius, radius, UVs.m_mins.x, UVs.m_maxs.x);
-	// 	float currentSectorVert2V = RangeMap(currentSectorVert2.y, -radius, radius, UVs.m_mins.y, UVs.m_maxs.y);
-	// 	Vec2 currentSectorVert2UV = Vec2(currentSectorVert2U, currentSectorVert2V);
-	// 	
-	// 	Vec3 currentSectorMinVert1 = transformationMatrix.TransformPosition3D(currentSectorVert1);
-	// 	Vec3 currentSectorMinVert2 = transformationMatrix.TransformPosition3D(currentSectorVert2);
-	// 
-	// 	verts.push_back(Vertex_PCU(currentSectorMinVert2, tint, Vec2(currentSectorVert2UV.x, 1.f - currentSectorVert2UV.y)));
-	// 	verts.push_back(Vertex_PCU(currentSectorMinVert1, tint, Vec2(currentSectorVert1UV.x, 1.f - currentSectorVert1UV.y)));
-	// 	verts.push_back(Vertex_PCU(start, tint, sectorTipUV));
-	// 
-	// 	Vec3 currentSectorMaxVert1 = translationMatrix.TransformPosition3D(currentSectorVert1);
-	// 	Vec3 currentSectorMaxVert2 = translationMatrix.TransformPosition3D(currentSectorVert2);
-	// 
-	// 	verts.push_back(Vertex_PCU(currentSectorMaxVert1, tint, currentSectorVert1UV));
-	// 	verts.push_back(Vertex_PCU(currentSectorMaxVert2, tint, currentSectorVert2UV));
-	// 	verts.push_back(Vertex_PCU(end, tint, sectorTipUV));
-	// 
-	// 	Vec2 currentCylinderUVBL;
-	// 	currentCylinderUVBL.x = RangeMapClamped(currentYawDegrees, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-	// 	currentCylinderUVBL.y = UVs.m_mins.y;
-	// 	// 
-	// 	Vec2 currentCylinderUVTR;
-	// 	currentCylinderUVTR.x = RangeMapClamped(currentYawDegrees + degreesPerYawSlice, 0.f, 360.f, UVs.m_mins.x, UVs.m_maxs.x);
-	// 	currentCylinderUVTR.y = UVs.m_maxs.y;
-	// 
-	// 	AddVertsForQuad3D(verts, currentSectorMinVert1, currentSectorMinVert2, currentSectorMaxVert2, currentSectorMaxVert1, tint, AABB2(currentCylinderUVBL, currentCylinderUVTR));
-	// 
-	// 	currentYawDegrees += degreesPerYawSlice;
-	// }
+	AddVertsForTransformedUnitMesh(verts, GetUnitMesh(UNIT_MESH_CYLINDER_X_3D, (float)numSlices), GetTransformForShapeAlongX3D(start, end, radius), tint, UVs);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs)
 {
-	Vec3 BL = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0);
-	Vec3 BR = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0);
-	Vec3 TR = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0);
-	Vec3 TL = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0);
-
-	Vec2 uvBL = Vec2(UVs.m_mins.x, UVs.m_mins.y);
-	Vec2 uvBR = Vec2(UVs.m_maxs.x, UVs.m_mins.y);
-	Vec2 uvTR = Vec2(UVs.m_maxs.x, UVs.m_maxs.y);
-	Vec2 uvTL = Vec2(UVs.m_mins.x, UVs.m_maxs.y);
-
-	verts.push_back(Vertex_PCU(BL, color, uvBL));
-	verts.push_back(Vertex_PCU(BR, color, uvBR));
-	verts.push_back(Vertex_PCU(TR, color, uvTR));
-
-	verts.push_back(Vertex_PCU(BL, color, uvBL));
-	verts.push_back(Vertex_PCU(TR, color, uvTR));
-	verts.push_back(Vertex_PCU(TL, color, uvTL));
+	Vertex_PCU quadVerts[NUM_VERTS_PER_INDEXED_QUAD];
+	WriteVertsForAABB2D(quadVerts, bounds, color, UVs);
+	AddVertsForQuadsAsTriangles(verts, quadVerts, 1);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs)
 {
-	Vec3 BL = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0);
-	Vec3 BR = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0);
-	Vec3 TR = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0);
-	Vec3 TL = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0);
-
-	Vec2 uvBL = Vec2(UVs.m_mins.x, UVs.m_mins.y);
-	Vec2 uvBR = Vec2(UVs.m_maxs.x, UVs.m_mins.y);
-	Vec2 uvTR = Vec2(UVs.m_maxs.x, UVs.m_maxs.y);
-	Vec2 uvTL = Vec2(UVs.m_mins.x, UVs.m_maxs.y);
-
 	int startIndex = (int)verts.size();
-	verts.emplace_back(BL, color, uvBL);
-	verts.emplace_back(BR, color, uvBR);
-	verts.emplace_back(TR, color, uvTR);
-	verts.emplace_back(TL, color, uvTL);
-
-	indexes.emplace_back(startIndex);
-	indexes.emplace_back(startIndex + 1);
-	indexes.emplace_back(startIndex + 2);
-	indexes.emplace_back(startIndex);
-	indexes.emplace_back(startIndex + 2);
-	indexes.emplace_back(startIndex + 3);
+	WriteVertsForAABB2D(AppendVerts(verts, NUM_VERTS_PER_INDEXED_QUAD), bounds, color, UVs);
+	WriteIndexesForQuads(AppendIndexes(indexes, NUM_INDEXES_PER_QUAD), startIndex, 1);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& color, AABB2 const& UVs)
 {
-	Vec3 ESB = Vec3(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z);
-	Vec3 ENB = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_mins.z);
-	Vec3 ENT = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z);
-	Vec3 EST = Vec3(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_maxs.z);
-
-	Vec3 WNB = Vec3(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_mins.z);
-	Vec3 WSB = Vec3(bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z);
-	Vec3 WST = Vec3(bounds.m_mins.x, bounds.m_mins.y, bounds.m_maxs.z);
-	Vec3 WNT = Vec3(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_maxs.z);
-
-	AddVertsForQuad3D(verts, ESB, ENB, ENT, EST, color, UVs); // EAST FACE +X
-	AddVertsForQuad3D(verts, WNB, WSB, WST, WNT, color, UVs); // WEST FACE -X
-	AddVertsForQuad3D(verts, ENB, WNB, WNT, ENT, color, UVs); // NORTH FACE +Y
-	AddVertsForQuad3D(verts, WSB, ESB, EST, WST, color, UVs); // SOUTH FACE -Y
-	AddVertsForQuad3D(verts, WST, EST, ENT, WNT, color, UVs); // TOP FACE +Z
-	AddVertsForQuad3D(verts, WNB, ENB, ESB, WSB, color, UVs); // BOTTOM FACE -Z
+	Vertex_PCU quadVerts[NUM_QUADS_PER_AABB3 * NUM_VERTS_PER_INDEXED_QUAD];
+	WriteVertsForAABB3D(quadVerts, bounds, color, UVs);
+	AddVertsForQuadsAsTriangles(verts, quadVerts, NUM_QUADS_PER_AABB3);
 }
 
 
@@ -856,18 +924,9 @@ void AddVertsForAABBWireframe3D(std::vector<Vertex_PCU>& verts, AABB3 const& bou
 //--------------------------------------------------------------------------------------------------
 void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color, AABB2 const& UVs)
 {
-	Vec2 uvBL = Vec2(UVs.m_mins.x, UVs.m_mins.y);
-	Vec2 uvBR = Vec2(UVs.m_maxs.x, UVs.m_mins.y);
-	Vec2 uvTR = Vec2(UVs.m_maxs.x, UVs.m_maxs.y);
-	Vec2 uvTL = Vec2(UVs.m_mins.x, UVs.m_maxs.y);
-
-	verts.push_back(Vertex_PCU(bottomLeft, color, uvBL));
-	verts.push_back(Vertex_PCU(bottomRight, color, uvBR));
-	verts.push_back(Vertex_PCU(topRight, color, uvTR));
-
-	verts.push_back(Vertex_PCU(bottomLeft, color, uvBL));
-	verts.push_back(Vertex_PCU(topRight, color, uvTR));
-	verts.push_back(Vertex_PCU(topLeft, color, uvTL));
+	Vertex_PCU quadVerts[NUM_VERTS_PER_INDEXED_QUAD];
+	WriteVertsForQuad3D(quadVerts, bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+	AddVertsForQuadsAsTriangles(verts, quadVerts, 1);
 }
 
 
@@ -875,23 +934,8 @@ void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, Vec3 const& bottomLeft, V
 void AddVertsForQuad3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color, AABB2 const& UVs)
 {
 	int startIndex = (int)verts.size();
-	Vec2 uvBL = Vec2(UVs.m_mins.x, UVs.m_mins.y);
-	Vec2 uvBR = Vec2(UVs.m_maxs.x, UVs.m_mins.y);
-	Vec2 uvTR = Vec2(UVs.m_maxs.x, UVs.m_maxs.y);
-	Vec2 uvTL = Vec2(UVs.m_mins.x, UVs.m_maxs.y);
-
-	verts.push_back(Vertex_PCU(bottomLeft, color, uvBL));
-	verts.push_back(Vertex_PCU(bottomRight, color, uvBR));
-	verts.push_back(Vertex_PCU(topRight, color, uvTR));
-	verts.push_back(Vertex_PCU(topLeft, color, uvTL));
-
-	indexes.push_back(startIndex);
-	indexes.push_back(startIndex + 1);
-	indexes.push_back(startIndex + 2);
-
-	indexes.push_back(startIndex);
-	indexes.push_back(startIndex + 2);
-	indexes.push_back(startIndex + 3);
+	WriteVertsForQuad3D(AppendVerts(verts, NUM_VERTS_PER_INDEXED_QUAD), bottomLeft, bottomRight, topRight, topLeft, color, UVs);
+	WriteIndexesForQuads(AppendIndexes(indexes, NUM_INDEXES_PER_QUAD), startIndex, 1);
 }
 
 
@@ -979,52 +1023,18 @@ void AddVertsForRoundedQuad3D(std::vector<Vertex_PNCU>& verts, std::vector<unsig
 //--------------------------------------------------------------------------------------------------
 void AddVertsForOBB2D(std::vector<Vertex_PCU>& verts, OBB2 const& box, Rgba8 const& color)
 {
-	Vec2 jBasisNormal = box.m_iBasisNormal.GetRotated90Degrees();
-	Vec2 scalediBasis = box.m_iBasisNormal * box.m_halfDimensions.x;
-	Vec2 scaledjBasis = jBasisNormal * box.m_halfDimensions.y;
-
-	Vec2 BR = box.m_center + scalediBasis - scaledjBasis; // BottomRight
-	Vec2 TR = box.m_center + scalediBasis + scaledjBasis;
-	Vec2 TL = box.m_center - scalediBasis + scaledjBasis;
-	Vec2 BL = box.m_center - scalediBasis - scaledjBasis; // BottomLeft
-
-	Vec2 uvBL = Vec2(0.f, 0.f);
-	Vec2 uvBR = Vec2(1.f, 0.f);
-	Vec2 uvTR = Vec2(1.f, 1.f);
-	Vec2 uvTL = Vec2(0.f, 1.f);
-
-	verts.push_back(Vertex_PCU(Vec3(BR.x, BR.y), color, uvBR));
-	verts.push_back(Vertex_PCU(Vec3(TR.x, TR.y), color, uvTR));
-	verts.push_back(Vertex_PCU(Vec3(TL.x, TL.y), color, uvTL));
-
-	verts.push_back(Vertex_PCU(Vec3(BR.x, BR.y), color, uvBR));
-	verts.push_back(Vertex_PCU(Vec3(TL.x, TL.y), color, uvTL));
-	verts.push_back(Vertex_PCU(Vec3(BL.x, BL.y), color, uvBL));
+	Vertex_PCU quadVerts[NUM_VERTS_PER_INDEXED_QUAD];
+	WriteVertsForOBB2D(quadVerts, box, color);
+	AddVertsForQuadsAsTriangles(verts, quadVerts, 1);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color)
 {
-	Vec2 dispFromStartToEnd = end - start;
-	Vec2 normalizedDispSE = dispFromStartToEnd.GetNormalized();
-	Vec2 perpendicular = normalizedDispSE.GetRotated90Degrees();
-	float halfThickness = thickness * 0.5f;
-	Vec2 scaledDisp = normalizedDispSE * halfThickness;
-	Vec2 scaledPerpendicular = perpendicular * halfThickness;
-
-	Vec2 BR = start - scaledPerpendicular - scaledDisp;
-	Vec2 TR = end - scaledPerpendicular + scaledDisp;
-	Vec2 TL = end + scaledPerpendicular + scaledDisp;
-	Vec2 BL = start + scaledPerpendicular - scaledDisp;
-
-	verts.push_back(Vertex_PCU(Vec3(BR.x, BR.y), color));
-	verts.push_back(Vertex_PCU(Vec3(TR.x, TR.y), color));
-	verts.push_back(Vertex_PCU(Vec3(TL.x, TL.y), color));
-
-	verts.push_back(Vertex_PCU(Vec3(BR.x, BR.y), color));
-	verts.push_back(Vertex_PCU(Vec3(TL.x, TL.y), color));
-	verts.push_back(Vertex_PCU(Vec3(BL.x, BL.y), color));
+	Vertex_PCU quadVerts[NUM_VERTS_PER_INDEXED_QUAD];
+	WriteVertsForLineSegment2D(quadVerts, start, end, thickness, color);
+	AddVertsForQuadsAsTriangles(verts, quadVerts, 1);
 }
 
 
@@ -1090,6 +1100,40 @@ void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transfo
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// A chord across 2pi/n of a circle with radius r sits r(1 - cos(pi/n)) inside the arc at its middle
+int GetNumSlicesForScreenRadius(float screenRadiusPixels, float maxErrorPixels, int minSlices, int maxSlices)
+{
+	static int const SLICE_COUNT_LADDER[] = { 4, 6, 8, 12, 16, 24, 32, 48, 64, 96, 128 };
+	constexpr int NUM_SLICE_COUNTS = (int)(sizeof(SLICE_COUNT_LADDER) / sizeof(SLICE_COUNT_LADDER[0]));
+
+	int numSlices = maxSlices;
+	if (maxErrorPixels >= screenRadiusPixels)
+	{
+		numSlices = minSlices;
+	}
+	else if (maxErrorPixels > 0.f)
+	{
+		float maxHalfAngleRadians = acosf(1.f - (maxErrorPixels / screenRadiusPixels));
+		float exactNumSlices = PI / maxHalfAngleRadians;
+		for (int ladderIndex = 0; ladderIndex < NUM_SLICE_COUNTS; ++ladderIndex)
+		{
+			if ((float)SLICE_COUNT_LADDER[ladderIndex] >= exactNumSlices)
+			{
+				numSlices = SLICE_COUNT_LADDER[ladderIndex];
+				break;
+			}
+		}
+	}
+
+	if (numSlices < minSlices)
+	{
+		return minSlices;
+	}
+	return numSlices > maxSlices ? maxSlices : numSlices;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 AABB2 GetVertexBounds2D(std::vector<Vertex_PCU> const& verts)
 {
@@ -1126,65 +1170,193 @@ AABB2 GetVertexBounds2D(std::vector<Vertex_PCU> const& verts)
 //--------------------------------------------------------------------------------------------------
 void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
 {
-	Vec3 dispSE = (end - start);
-	Vec3 iForward = dispSE.GetNormalized();
+	AddVertsForTransformedUnitMesh(verts, GetUnitMesh(UNIT_MESH_CONE_X_3D, (float)numSlices), GetTransformForShapeAlongX3D(start, end, radius), tint, UVs);
+}
 
-	Vec3 jLeft = CrossProduct3D(Vec3::Z_AXIS, iForward);
-	if (jLeft == Vec3::WORLD_ORIGIN)
-	{
-		jLeft = Vec3::Y_AXIS;
-	}
-	else
-	{
-		jLeft.Normalize();
-	}
-	Vec3 kUp = CrossProduct3D(iForward, jLeft);
 
-	Mat44 transformationMatrix;
-	transformationMatrix.SetIJK3D(iForward, jLeft, kUp);
-	transformationMatrix.SetTranslation3D(start);
+//--------------------------------------------------------------------------------------------------
+// The unit mesh builders loop while an int counter is below the (float) slice or stack count
+static int GetNumLoopSteps(float count)
+{
+	return count > 0.f ? (int)ceilf(count) : 0;
+}
 
-	Vec3 sectorMinTip = Vec3(0.f, 0.f, 0.f);
-	sectorMinTip = transformationMatrix.TransformPosition3D(sectorMinTip);
-	float depth = dispSE.GetLength();
-	Vec3 sectorMaxTip = Vec3(depth, 0.f, 0.f);
-	sectorMaxTip = transformationMatrix.TransformPosition3D(sectorMaxTip);
-	Vec2 sectorTipUV = Vec2(0.5f, 0.5f);
 
-	float currentYawDegrees = 0.f;
-	float degreesPerYawSlice = 360.f / numSlices;
+//--------------------------------------------------------------------------------------------------
+// One triangle per slice
+int GetNumVertsForDisc2D(int numSlices)
+{
+	return 3 * GetNumLoopSteps((float)numSlices);
+}
 
-	for (int sliceNum = 0; sliceNum < numSlices; ++sliceNum)
-	{
-		Vec3 currentSectorVert1 = MakeFromPolarDegrees(currentYawDegrees, radius);
-		currentSectorVert1.z = currentSectorVert1.x;
-		currentSectorVert1.x = 0.f;
-		Vec3 currentSectorVert2 = MakeFromPolarDegrees(currentYawDegrees + degreesPerYawSlice, radius);
-		currentSectorVert2.z = currentSectorVert2.x;
-		currentSectorVert2.x = 0.f;
 
-		float currentSectorVert1U = RangeMap(currentSectorVert1.z, -1.f, 1.f, UVs.m_mins.x, UVs.m_maxs.x);
-		float currentSectorVert1V = RangeMap(currentSectorVert1.y, -1.f, 1.f, UVs.m_mins.y, UVs.m_maxs.y);
-		Vec2 currentSectorVert1UV = Vec2(currentSectorVert1U, currentSectorVert1V);
+//--------------------------------------------------------------------------------------------------
+// One quad per slice and stack
+int GetNumVertsForUVSphereZ3D(float numSlices, float numStacks)
+{
+	return 6 * GetNumLoopSteps(numSlices) * GetNumLoopSteps(numStacks);
+}
 
-		float currentSectorVert2U = RangeMap(currentSectorVert2.z, -1.f, 1.f, UVs.m_mins.x, UVs.m_maxs.x);
-		float currentSectorVert2V = RangeMap(currentSectorVert2.y, -1.f, 1.f, UVs.m_mins.y, UVs.m_maxs.y);
-		Vec2 currentSectorVert2UV = Vec2(currentSectorVert2U, currentSectorVert2V);
 
-		Vec3 currentSectorMinVert1 = currentSectorVert1;
-		Vec3 currentSectorMinVert2 = currentSectorVert2;
+//--------------------------------------------------------------------------------------------------
+// Two cap triangles and one side quad per slice
+int GetNumVertsForCylinder3D(int numSlices)
+{
+	return 12 * GetNumLoopSteps((float)numSlices);
+}
+
 
-		currentSectorMinVert1 = transformationMatrix.TransformPosition3D(currentSectorMinVert1);
-		currentSectorMinVert2 = transformationMatrix.TransformPosition3D(currentSectorMinVert2);
+//--------------------------------------------------------------------------------------------------
+// One base triangle and one side triangle per slice
+int GetNumVertsForCone3D(int numSlices)
+{
+	return 6 * GetNumLoopSteps((float)numSlices);
+}
 
-		verts.push_back(Vertex_PCU(currentSectorMinVert1, tint, Vec2(currentSectorVert2U, 1.f - currentSectorVert2V)));
-		verts.push_back(Vertex_PCU(currentSectorMinVert2, tint, Vec2(currentSectorVert2U, 1.f - currentSectorVert2V)));
-		verts.push_back(Vertex_PCU(sectorMinTip, tint, sectorTipUV));
 
-		verts.push_back(Vertex_PCU(sectorMaxTip, tint, sectorTipUV));
-		verts.push_back(Vertex_PCU(currentSectorMinVert2, tint, currentSectorVert1UV));
-		verts.push_back(Vertex_PCU(currentSectorMinVert1, tint, currentSectorVert2UV));
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForQuad3D(Vertex_PCU* out_verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color, AABB2 const& UVs)
+{
+	out_verts[0] = Vertex_PCU(bottomLeft, color, Vec2(UVs.m_mins.x, UVs.m_mins.y));
+	out_verts[1] = Vertex_PCU(bottomRight, color, Vec2(UVs.m_maxs.x, UVs.m_mins.y));
+	out_verts[2] = Vertex_PCU(topRight, color, Vec2(UVs.m_maxs.x, UVs.m_maxs.y));
+	out_verts[3] = Vertex_PCU(topLeft, color, Vec2(UVs.m_mins.x, UVs.m_maxs.y));
+}
 
-		currentYawDegrees += degreesPerYawSlice;
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForAABB2D(Vertex_PCU* out_verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+	Vec3 BL = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.f);
+	Vec3 BR = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0.f);
+	Vec3 TR = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.f);
+	Vec3 TL = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0.f);
+	WriteVertsForQuad3D(out_verts, BL, BR, TR, TL, color, UVs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForAABB3D(Vertex_PCU* out_verts, AABB3 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+	Vec3 ESB = Vec3(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_mins.z);
+	Vec3 ENB = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_mins.z);
+	Vec3 ENT = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z);
+	Vec3 EST = Vec3(bounds.m_maxs.x, bounds.m_mins.y, bounds.m_maxs.z);
+
+	Vec3 WNB = Vec3(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_mins.z);
+	Vec3 WSB = Vec3(bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z);
+	Vec3 WST = Vec3(bounds.m_mins.x, bounds.m_mins.y, bounds.m_maxs.z);
+	Vec3 WNT = Vec3(bounds.m_mins.x, bounds.m_maxs.y, bounds.m_maxs.z);
+
+	WriteVertsForQuad3D(out_verts, ESB, ENB, ENT, EST, color, UVs);		// EAST FACE +X
+	WriteVertsForQuad3D(out_verts + 4, WNB, WSB, WST, WNT, color, UVs);	// WEST FACE -X
+	WriteVertsForQuad3D(out_verts + 8, ENB, WNB, WNT, ENT, color, UVs);	// NORTH FACE +Y
+	WriteVertsForQuad3D(out_verts + 12, WSB, ESB, EST, WST, color, UVs);	// SOUTH FACE -Y
+	WriteVertsForQuad3D(out_verts + 16, WST, EST, ENT, WNT, color, UVs);	// TOP FACE +Z
+	WriteVertsForQuad3D(out_verts + 20, WNB, ENB, ESB, WSB, color, UVs);	// BOTTOM FACE -Z
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForOBB2D(Vertex_PCU* out_verts, OBB2 const& box, Rgba8 const& color)
+{
+	Vec2 jBasisNormal = box.m_iBasisNormal.GetRotated90Degrees();
+	Vec2 scalediBasis = box.m_iBasisNormal * box.m_halfDimensions.x;
+	Vec2 scaledjBasis = jBasisNormal * box.m_halfDimensions.y;
+
+	Vec2 BR = box.m_center + scalediBasis - scaledjBasis;
+	Vec2 TR = box.m_center + scalediBasis + scaledjBasis;
+	Vec2 TL = box.m_center - scalediBasis + scaledjBasis;
+	Vec2 BL = box.m_center - scalediBasis - scaledjBasis;
+
+	out_verts[0] = Vertex_PCU(Vec3(BR.x, BR.y), color, Vec2(1.f, 0.f));
+	out_verts[1] = Vertex_PCU(Vec3(TR.x, TR.y), color, Vec2(1.f, 1.f));
+	out_verts[2] = Vertex_PCU(Vec3(TL.x, TL.y), color, Vec2(0.f, 1.f));
+	out_verts[3] = Vertex_PCU(Vec3(BL.x, BL.y), color, Vec2(0.f, 0.f));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForLineSegment2D(Vertex_PCU* out_verts, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color)
+{
+	Vec2 dispFromStartToEnd = end - start;
+	Vec2 normalizedDispSE = dispFromStartToEnd.GetNormalized();
+	Vec2 perpendicular = normalizedDispSE.GetRotated90Degrees();
+	float halfThickness = thickness * 0.5f;
+	Vec2 scaledDisp = normalizedDispSE * halfThickness;
+	Vec2 scaledPerpendicular = perpendicular * halfThickness;
+
+	Vec2 BR = start - scaledPerpendicular - scaledDisp;
+	Vec2 TR = end - scaledPerpendicular + scaledDisp;
+	Vec2 TL = end + scaledPerpendicular + scaledDisp;
+	Vec2 BL = start + scaledPerpendicular - scaledDisp;
+
+	out_verts[0] = Vertex_PCU(Vec3(BR.x, BR.y), color);
+	out_verts[1] = Vertex_PCU(Vec3(TR.x, TR.y), color);
+	out_verts[2] = Vertex_PCU(Vec3(TL.x, TL.y), color);
+	out_verts[3] = Vertex_PCU(Vec3(BL.x, BL.y), color);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForDisc2D(Vertex_PCU* out_verts, Vec2 const& center, float radius, Rgba8 const& color, int numSlices)
+{
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, 1.f), Vec3(center, 0.f));
+	WriteVertsForTransformedUnitMesh(out_verts, GetUnitMesh(UNIT_MESH_DISC_2D, (float)numSlices), transform, color, AABB2::ZERO_TO_ONE);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForUVSphereZ3D(Vertex_PCU* out_verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs)
+{
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), center);
+	WriteVertsForTransformedUnitMesh(out_verts, GetUnitMesh(UNIT_MESH_UV_SPHERE_Z_3D, numSlices, numStacks), transform, tint, UVs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForCylinder3D(Vertex_PCU* out_verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
+{
+	WriteVertsForTransformedUnitMesh(out_verts, GetUnitMesh(UNIT_MESH_CYLINDER_X_3D, (float)numSlices), GetTransformForShapeAlongX3D(start, end, radius), tint, UVs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForCone3D(Vertex_PCU* out_verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
+{
+	WriteVertsForTransformedUnitMesh(out_verts, GetUnitMesh(UNIT_MESH_CONE_X_3D, (float)numSlices), GetTransformForShapeAlongX3D(start, end, radius), tint, UVs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteIndexesForQuads(unsigned int* out_indexes, int firstVertIndex, int numQuads)
+{
+	for (int quadIndex = 0; quadIndex < numQuads; ++quadIndex)
+	{
+		unsigned int quadStartIndex = (unsigned int)(firstVertIndex + (quadIndex * NUM_VERTS_PER_INDEXED_QUAD));
+		unsigned int* quadIndexes = out_indexes + (quadIndex * NUM_INDEXES_PER_QUAD);
+		quadIndexes[0] = quadStartIndex;
+		quadIndexes[1] = quadStartIndex + 1;
+		quadIndexes[2] = quadStartIndex + 2;
+		quadIndexes[3] = quadStartIndex;
+		quadIndexes[4] = quadStartIndex + 2;
+		quadIndexes[5] = quadStartIndex + 3;
 	}
-}
\ No newline at end of file
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void WriteIndexesForQuads(unsigned short* out_indexes, int firstVertIndex, int numQuads)
+{
+	for (int quadIndex = 0; quadIndex < numQuads; ++quadIndex)
+	{
+		unsigned short quadStartIndex = (unsigned short)(firstVertIndex + (quadIndex * NUM_VERTS_PER_INDEXED_QUAD));
+		unsigned short* quadIndexes = out_indexes + (quadIndex * NUM_INDEXES_PER_QUAD);
+		quadIndexes[0] = quadStartIndex;
+		quadIndexes[1] = (unsigned short)(quadStartIndex + 1);
+		quadIndexes[2] = (unsigned short)(quadStartIndex + 2);
+		quadIndexes[3] = quadStartIndex;
+		quadIndexes[4] = (unsigned short)(quadStartIndex + 2);
+		quadIndexes[5] = (unsigned short)(quadStartIndex + 3);
+	}
+}
@@ -17,14 +17,18 @@ struct Vec3;
 struct Rgba8;
 struct Mat44;
 
+//--------------------------------------------------------------------------------------------------
+constexpr int	DEFAULT_DISC_2D_SLICES				= 32;
+constexpr int	DEFAULT_CAPSULE_2D_SLICES_PER_END	= 18;
+
 //--------------------------------------------------------------------------------------------------
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float scaleXY, float rotationDegreesAboutZ, Vec2 const& tranlationXY);
 void TransformVertexArray3D(int numVerts, Vertex_PCU* verts, Mat44 transform);
 void TransformVertexArray3D(std::vector<Vertex_PCU>& verts, Mat44 const& transform);
 
 //--------------------------------------------------------------------------------------------------
-void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color);
-void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color);
+void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color, int numSlicesPerEnd = DEFAULT_CAPSULE_2D_SLICES_PER_END);
+void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color, int numSlices = DEFAULT_DISC_2D_SLICES);
 void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec2 const& center, float radius, float thickness, Rgba8 const& color);
 void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color);
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE, int numLatitudeSlices = 8);
@@ -51,5 +55,43 @@ void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& verts, Vec3 const& start,
 void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 const& tailPos, Vec2 const& tipPos, float arrowSize, float lineThickness, Rgba8 const& color = Rgba8(0, 255, 0));
 void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
 
+//--------------------------------------------------------------------------------------------------
+// Exact sizes for the Write functions below, so a whole batch of shapes can be allocated up front.
+// Quads are written as 4 verts and indexed with WriteIndexesForQuads.
+//--------------------------------------------------------------------------------------------------
+constexpr int NUM_VERTS_PER_INDEXED_QUAD	= 4;
+constexpr int NUM_INDEXES_PER_QUAD			= 6;
+constexpr int NUM_QUADS_PER_AABB3			= 6;
+
+int GetNumVertsForDisc2D(int numSlices = DEFAULT_DISC_2D_SLICES);
+int GetNumVertsForUVSphereZ3D(float numSlices, float numStacks);
+int GetNumVertsForCylinder3D(int numSlices = 8);
+int GetNumVertsForCone3D(int numSlices = 8);
+
+//--------------------------------------------------------------------------------------------------
+void WriteVertsForQuad3D(Vertex_PCU* out_verts, Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void WriteVertsForAABB2D(Vertex_PCU* out_verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void WriteVertsForAABB3D(Vertex_PCU* out_verts, AABB3 const& bounds, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void WriteVertsForOBB2D(Vertex_PCU* out_verts, OBB2 const& box, Rgba8 const& color);
+void WriteVertsForLineSegment2D(Vertex_PCU* out_verts, Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
+void WriteVertsForDisc2D(Vertex_PCU* out_verts, Vec2 const& center, float radius, Rgba8 const& color, int numSlices = DEFAULT_DISC_2D_SLICES);
+void WriteVertsForUVSphereZ3D(Vertex_PCU* out_verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void WriteVertsForCylinder3D(Vertex_PCU* out_verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void WriteVertsForCone3D(Vertex_PCU* out_verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void WriteIndexesForQuads(unsigned int* out_indexes, int firstVertIndex, int numQuads);
+void WriteIndexesForQuads(unsigned short* out_indexes, int firstVertIndex, int numQuads);
+
+//--------------------------------------------------------------------------------------------------
+// Level of detail for the round shapes: the fewest slices around a full circle whose chords stay
+// within maxErrorPixels of the true outline at the given projected radius (see
+// Camera::GetProjectedRadius). Counts snap to a short fixed ladder so only a handful of unit meshes
+// ever get cached. For AddVertsForSphere3D pass half the count as numLatitudeSlices.
+//--------------------------------------------------------------------------------------------------
+constexpr float	DEFAULT_LOD_MAX_ERROR_PIXELS	= 0.5f;
+constexpr int	MIN_LOD_SLICES					= 4;
+constexpr int	MAX_LOD_SLICES					= 64;
+
+int GetNumSlicesForScreenRadius(float screenRadiusPixels, float maxErrorPixels = DEFAULT_LOD_MAX_ERROR_PIXELS, int minSlices = MIN_LOD_SLICES, int maxSlices = MAX_LOD_SLICES);
+
 //--------------------------------------------------------------------------------------------------
 AABB2 GetVertexBounds2D(std::vector<Vertex_PCU> const& verts);
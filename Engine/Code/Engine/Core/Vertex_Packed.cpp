@@ -0,0 +1,328 @@
+#include "Engine/Core/Vertex_Packed.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+#include <math.h>
+#include <string.h>
+#include <emmintrin.h>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int	PACK_BATCH_SIZE		= 4;
+constexpr float	UNORM16_MAX			= 65535.f;
+constexpr float	SNORM16_MAX			= 32767.f;
+
+
+//--------------------------------------------------------------------------------------------------
+// Four floats to four halves (in the low 16 bits of each lane), rounding to nearest even. Values too
+// big for a half become infinity, NaNs stay NaNs and tiny values become half denormals. The sign is
+// smeared over the high 16 bits so _mm_packs_epi32 narrows every lane without saturating.
+static __m128i FloatToHalf4(__m128 values)
+{
+	__m128i const signMask			= _mm_set1_epi32(0x80000000);
+	__m128i const firstInfinity		= _mm_set1_epi32((127 + 16) << 23);			// Smallest float that rounds to a half infinity
+	__m128i const firstNormal		= _mm_set1_epi32((127 - 14) << 23);			// Smallest float that stays a normal half
+	__m128i const denormalMagic		= _mm_set1_epi32((127 - 1) << 23);			// 0.5f, which lines the half denormal bits up with the float mantissa LSBs
+	__m128i const normalBias		= _mm_set1_epi32(0xfff - ((127 - 15) << 23));	// Rebiases the exponent and adds half an LSB for rounding
+	__m128i const halfInfinity		= _mm_set1_epi32(0x7c00);
+	__m128i const halfQuietNaNBit	= _mm_set1_epi32(0x200);
+
+	__m128	sign		= _mm_and_ps(values, _mm_castsi128_ps(signMask));
+	__m128	absValues	= _mm_xor_ps(values, sign);
+	__m128i absBits		= _mm_castps_si128(absValues);
+
+	__m128i isNaN		= _mm_castps_si128(_mm_cmpunord_ps(absValues, absValues));
+	__m128i isFinite	= _mm_cmpgt_epi32(firstInfinity, absBits);
+	__m128i isDenormal	= _mm_cmpgt_epi32(firstNormal, absBits);
+	__m128i special		= _mm_or_si128(_mm_and_si128(isNaN, halfQuietNaNBit), halfInfinity);
+
+	__m128i denormal	= _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValues, _mm_castsi128_ps(denormalMagic))), denormalMagic);
+
+	__m128i isOdd		= _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);	// -1 where the half mantissa LSB will be set
+	__m128i normal		= _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), isOdd), 13);
+
+	__m128i finite		= _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+	__m128i halves		= _mm_or_si128(_mm_and_si128(isFinite, finite), _mm_andnot_si128(isFinite, special));
+	return _mm_or_si128(halves, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Octahedral encoding: project onto the octahedron |x| + |y| + |z| = 1, fold the lower half over the
+// diagonals into the outer triangles of the square, and keep x and y. Returns the encoded normals
+// as interleaved snorm16 pairs.
+static __m128i EncodeOctahedralNormals4(__m128 x, __m128 y, __m128 z)
+{
+	__m128 const signMask	= _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	__m128 const zero		= _mm_setzero_ps();
+	__m128 const one		= _mm_set1_ps(1.f);
+
+	__m128 absX			= _mm_andnot_ps(signMask, x);
+	__m128 absY			= _mm_andnot_ps(signMask, y);
+	__m128 absSum		= _mm_add_ps(_mm_add_ps(absX, absY), _mm_andnot_ps(signMask, z));
+	__m128 hasLength	= _mm_cmpgt_ps(absSum, zero);
+	__m128 scale		= _mm_and_ps(hasLength, _mm_div_ps(one, _mm_or_ps(absSum, _mm_andnot_ps(hasLength, one))));
+
+	__m128 u			= _mm_mul_ps(x, scale);
+	__m128 v			= _mm_mul_ps(y, scale);
+	__m128 foldedU		= _mm_or_ps(_mm_sub_ps(one, _mm_mul_ps(absY, scale)), _mm_and_ps(u, signMask));
+	__m128 foldedV		= _mm_or_ps(_mm_sub_ps(one, _mm_mul_ps(absX, scale)), _mm_and_ps(v, signMask));
+	__m128 isLowerHalf	= _mm_cmplt_ps(z, zero);
+	u					= _mm_or_ps(_mm_and_ps(isLowerHalf, foldedU), _mm_andnot_ps(isLowerHalf, u));
+	v					= _mm_or_ps(_mm_and_ps(isLowerHalf, foldedV), _mm_andnot_ps(isLowerHalf, v));
+
+	__m128 const snormMax = _mm_set1_ps(SNORM16_MAX);
+	__m128i encodedU	= _mm_cvtps_epi32(_mm_mul_ps(u, snormMax));
+	__m128i encodedV	= _mm_cvtps_epi32(_mm_mul_ps(v, snormMax));
+	return _mm_unpacklo_epi16(_mm_packs_epi32(encodedU, encodedU), _mm_packs_epi32(encodedV, encodedV));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Unorm16 xyz of one position, with w = 65535. Lanes are rounded to nearest and packed unsigned by
+// shifting into the signed range and back, since _mm_packus_epi32 needs SSE4.1.
+static void WriteQuantizedPosition(unsigned short* out_position, Vec3 const& position, __m128 mins, __m128 scale)
+{
+	__m128 quantized = _mm_mul_ps(_mm_sub_ps(_mm_set_ps(1.f, position.z, position.y, position.x), mins), scale);
+	quantized = _mm_min_ps(_mm_max_ps(quantized, _mm_setzero_ps()), _mm_set1_ps(UNORM16_MAX));
+
+	__m128i const signedBias = _mm_set1_epi32(32768);
+	__m128i rounded = _mm_sub_epi32(_mm_cvttps_epi32(_mm_add_ps(quantized, _mm_set1_ps(0.5f))), signedBias);
+	__m128i packed = _mm_xor_si128(_mm_packs_epi32(rounded, rounded), _mm_set1_epi16((short)0x8000));
+	_mm_storel_epi64((__m128i*)out_position, packed);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template<typename PACKED_VERTEX, typename VERTEX>
+static void WritePackedUVs(PACKED_VERTEX* out_verts, VERTEX const* verts, int numVerts)
+{
+	for (int firstVertIndex = 0; firstVertIndex < numVerts; firstVertIndex += PACK_BATCH_SIZE)
+	{
+		int numInBatch = numVerts - firstVertIndex < PACK_BATCH_SIZE ? numVerts - firstVertIndex : PACK_BATCH_SIZE;
+		float uvs[2 * PACK_BATCH_SIZE] = {};
+		for (int batchIndex = 0; batchIndex < numInBatch; ++batchIndex)
+		{
+			uvs[2 * batchIndex] = verts[firstVertIndex + batchIndex].m_uvTexCoords.x;
+			uvs[2 * batchIndex + 1] = verts[firstVertIndex + batchIndex].m_uvTexCoords.y;
+		}
+
+		unsigned short halves[2 * PACK_BATCH_SIZE];
+		_mm_storeu_si128((__m128i*)halves, _mm_packs_epi32(FloatToHalf4(_mm_loadu_ps(uvs)), FloatToHalf4(_mm_loadu_ps(uvs + 4))));
+		for (int batchIndex = 0; batchIndex < numInBatch; ++batchIndex)
+		{
+			memcpy(out_verts[firstVertIndex + batchIndex].m_uvTexCoords, &halves[2 * batchIndex], sizeof(halves[0]) * 2);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template<typename PACKED_VERTEX>
+static void WritePackedNormals(PACKED_VERTEX* out_verts, Vertex_PNCU const* verts, int numVerts)
+{
+	for (int firstVertIndex = 0; firstVertIndex < numVerts; firstVertIndex += PACK_BATCH_SIZE)
+	{
+		int numInBatch = numVerts - firstVertIndex < PACK_BATCH_SIZE ? numVerts - firstVertIndex : PACK_BATCH_SIZE;
+		float x[PACK_BATCH_SIZE] = {};
+		float y[PACK_BATCH_SIZE] = {};
+		float z[PACK_BATCH_SIZE] = {};
+		for (int batchIndex = 0; batchIndex < numInBatch; ++batchIndex)
+		{
+			Vec3 const& normal = verts[firstVertIndex + batchIndex].m_normal;
+			x[batchIndex] = normal.x;
+			y[batchIndex] = normal.y;
+			z[batchIndex] = normal.z;
+		}
+
+		short encoded[2 * PACK_BATCH_SIZE];
+		_mm_storeu_si128((__m128i*)encoded, EncodeOctahedralNormals4(_mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z)));
+		for (int batchIndex = 0; batchIndex < numInBatch; ++batchIndex)
+		{
+			memcpy(out_verts[firstVertIndex + batchIndex].m_normal, &encoded[2 * batchIndex], sizeof(encoded[0]) * 2);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Axes with no extent quantize to 0 and dequantize back to the min.
+template<typename QUANTIZED_VERTEX, typename VERTEX>
+static void WriteQuantizedPositions(QUANTIZED_VERTEX* out_verts, VERTEX const* verts, int numVerts, AABB3 const& bounds)
+{
+	Vec3 dimensions = bounds.GetDimensions();
+	float scaleX = dimensions.x > 0.f ? UNORM16_MAX / dimensions.x : 0.f;
+	float scaleY = dimensions.y > 0.f ? UNORM16_MAX / dimensions.y : 0.f;
+	float scaleZ = dimensions.z > 0.f ? UNORM16_MAX / dimensions.z : 0.f;
+	__m128 mins = _mm_set_ps(0.f, bounds.m_mins.z, bounds.m_mins.y, bounds.m_mins.x);
+	__m128 scale = _mm_set_ps(UNORM16_MAX, scaleZ, scaleY, scaleX);
+
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		WriteQuantizedPosition(out_verts[vertIndex].m_position, verts[vertIndex].m_position, mins, scale);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template<typename VERTEX>
+static AABB3 GetVertexBounds3DImpl(VERTEX const* verts, int numVerts)
+{
+	if (numVerts <= 0)
+	{
+		return AABB3(0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+	}
+
+	Vec3 const& firstPosition = verts[0].m_position;
+	__m128 mins = _mm_set_ps(0.f, firstPosition.z, firstPosition.y, firstPosition.x);
+	__m128 maxs = mins;
+	for (int vertIndex = 1; vertIndex < numVerts; ++vertIndex)
+	{
+		Vec3 const& position = verts[vertIndex].m_position;
+		__m128 point = _mm_set_ps(0.f, position.z, position.y, position.x);
+		mins = _mm_min_ps(mins, point);
+		maxs = _mm_max_ps(maxs, point);
+	}
+
+	float minValues[4];
+	float maxValues[4];
+	_mm_storeu_ps(minValues, mins);
+	_mm_storeu_ps(maxValues, maxs);
+	return AABB3(minValues[0], minValues[1], minValues[2], maxValues[0], maxValues[1], maxValues[2]);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void PackVerts(Vertex_PCUPacked* out_verts, Vertex_PCU const* verts, int numVerts)
+{
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		out_verts[vertIndex].m_position = verts[vertIndex].m_position;
+		out_verts[vertIndex].m_color = verts[vertIndex].m_color;
+	}
+	WritePackedUVs(out_verts, verts, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void PackVerts(Vertex_PNCUPacked* out_verts, Vertex_PNCU const* verts, int numVerts)
+{
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		out_verts[vertIndex].m_position = verts[vertIndex].m_position;
+		out_verts[vertIndex].m_color = verts[vertIndex].m_color;
+	}
+	WritePackedNormals(out_verts, verts, numVerts);
+	WritePackedUVs(out_verts, verts, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void QuantizeVerts(Vertex_PCUQuantized* out_verts, Vertex_PCU const* verts, int numVerts, AABB3 const& bounds)
+{
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		out_verts[vertIndex].m_color = verts[vertIndex].m_color;
+	}
+	WriteQuantizedPositions(out_verts, verts, numVerts, bounds);
+	WritePackedUVs(out_verts, verts, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void QuantizeVerts(Vertex_PNCUQuantized* out_verts, Vertex_PNCU const* verts, int numVerts, AABB3 const& bounds)
+{
+	for (int vertIndex = 0; vertIndex < numVerts; ++vertIndex)
+	{
+		out_verts[vertIndex].m_color = verts[vertIndex].m_color;
+	}
+	WriteQuantizedPositions(out_verts, verts, numVerts, bounds);
+	WritePackedNormals(out_verts, verts, numVerts);
+	WritePackedUVs(out_verts, verts, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3 GetVertexBounds3D(Vertex_PCU const* verts, int numVerts)
+{
+	return GetVertexBounds3DImpl(verts, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3 GetVertexBounds3D(Vertex_PNCU const* verts, int numVerts)
+{
+	return GetVertexBounds3DImpl(verts, numVerts);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The shader reads a unorm16 position as 0..1 per axis, so the bounds' extents and mins turn it back
+// into a mesh-space position.
+Mat44 GetDequantizationTransform(AABB3 const& bounds)
+{
+	Mat44 transform = Mat44::CreateTranslation3D(bounds.m_mins);
+	transform.AppendScaleNonUniform3D(bounds.GetDimensions());
+	return transform;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned short FloatToHalf(float value)
+{
+	return (unsigned short)(_mm_cvtsi128_si32(FloatToHalf4(_mm_set1_ps(value))) & 0xffff);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float HalfToFloat(unsigned short half)
+{
+	unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+	unsigned int exponent = (half >> 10) & 0x1f;
+	unsigned int mantissa = half & 0x3ff;
+
+	unsigned int bits;
+	if (exponent == 0)
+	{
+		float denormal = (float)mantissa * (1.f / 16777216.f);
+		memcpy(&bits, &denormal, sizeof(bits));
+		bits |= sign;
+	}
+	else if (exponent == 0x1f)
+	{
+		bits = sign | 0x7f800000 | (mantissa << 13);
+	}
+	else
+	{
+		bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	}
+
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void EncodeOctahedralNormal(Vec3 const& normal, short out_encoded[2])
+{
+	short encoded[2 * PACK_BATCH_SIZE];
+	_mm_storeu_si128((__m128i*)encoded, EncodeOctahedralNormals4(_mm_set1_ps(normal.x), _mm_set1_ps(normal.y), _mm_set1_ps(normal.z)));
+	out_encoded[0] = encoded[0];
+	out_encoded[1] = encoded[1];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vec3 DecodeOctahedralNormal(short const encoded[2])
+{
+	float u = fmaxf((float)encoded[0] / SNORM16_MAX, -1.f);
+	float v = fmaxf((float)encoded[1] / SNORM16_MAX, -1.f);
+	Vec3 normal(u, v, 1.f - fabsf(u) - fabsf(v));
+	if (normal.z < 0.f)
+	{
+		normal.x = (1.f - fabsf(v)) * (u >= 0.f ? 1.f : -1.f);
+		normal.y = (1.f - fabsf(u)) * (v >= 0.f ? 1.f : -1.f);
+	}
+	return normal.GetNormalized();
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PNCU.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+struct AABB3;
+struct Mat44;
+
+
+//--------------------------------------------------------------------------------------------------
+// Compact versions of Vertex_PCU and Vertex_PNCU for meshes that are built once and drawn often.
+// UVs are half floats (so tiling UVs outside 0..1 still work) and normals are octahedral-encoded
+// into two snorm16s. The Quantized versions also store the position as unorm16s relative to the
+// mesh's bounds; draw them with GetDequantizationTransform(bounds) appended to the model matrix and
+// the shader sees the original positions.
+//
+// The renderer's "DefaultPackedLit" shader (CreateOrGetShader with VERTEX_TYPE_PNCU_PACKED or
+// VERTEX_TYPE_PNCU_QUANTIZED) reads both PNCU formats. In a custom shader an octahedral normal
+// arrives as a float2 and is decoded with:
+//		float3 n = float3(e.x, e.y, 1 - abs(e.x) - abs(e.y));
+//		float t = saturate(-n.z);
+//		n.xy += (n.xy >= 0) ? -t : t;
+//		n = normalize(n);
+//--------------------------------------------------------------------------------------------------
+struct Vertex_PCUPacked				// 20 bytes, was 24
+{
+	Vec3			m_position;
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2];
+};
+
+struct Vertex_PCUQuantized			// 16 bytes, was 24
+{
+	unsigned short	m_position[4];	// w is always 65535 so the position also reads as a float4 with w = 1
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2];
+};
+
+struct Vertex_PNCUPacked			// 24 bytes, was 36
+{
+	Vec3			m_position;
+	short			m_normal[2];
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2];
+};
+
+struct Vertex_PNCUQuantized			// 20 bytes, was 36
+{
+	unsigned short	m_position[4];
+	short			m_normal[2];
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2];
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Bulk conversions from the full formats, four UVs/normals at a time with SSE2.
+void PackVerts(Vertex_PCUPacked* out_verts, Vertex_PCU const* verts, int numVerts);
+void PackVerts(Vertex_PNCUPacked* out_verts, Vertex_PNCU const* verts, int numVerts);
+void QuantizeVerts(Vertex_PCUQuantized* out_verts, Vertex_PCU const* verts, int numVerts, AABB3 const& bounds);
+void QuantizeVerts(Vertex_PNCUQuantized* out_verts, Vertex_PNCU const* verts, int numVerts, AABB3 const& bounds);
+
+AABB3 GetVertexBounds3D(Vertex_PCU const* verts, int numVerts);
+AABB3 GetVertexBounds3D(Vertex_PNCU const* verts, int numVerts);
+Mat44 GetDequantizationTransform(AABB3 const& bounds);
+
+//--------------------------------------------------------------------------------------------------
+unsigned short	FloatToHalf(float value);
+float			HalfToFloat(unsigned short half);
+void			EncodeOctahedralNormal(Vec3 const& normal, short out_encoded[2]);	// Normal need not be unit length
+Vec3			DecodeOctahedralNormal(short const encoded[2]);
@@ -21,6 +21,13 @@ AABB3::AABB3(Vec3 const& mins, Vec3 const& maxs):
 {
 }
 
+bool AABB3::IsPointInside(Vec3 const& point) const
+{
+	return m_mins.x < point.x && m_maxs.x > point.x &&
+		   m_mins.y < point.y && m_maxs.y > point.y &&
+		   m_mins.z < point.z && m_maxs.z > point.z;
+}
+
 Vec3 AABB3::GetCenter() const
 {
 	float centerX = (m_maxs.x + m_mins.x) * 0.5f;
@@ -29,6 +36,20 @@ Vec3 AABB3::GetCenter() const
 
 	return Vec3(centerX, centerY, centerZ);
 }
+
+Vec3 AABB3::GetDimensions() const
+{
+	return m_maxs - m_mins;
+}
+
+Vec3 AABB3::GetNearestPoint(Vec3 const& referencePosition) const
+{
+	float nearestX = referencePosition.x < m_mins.x ? m_mins.x : (referencePosition.x > m_maxs.x ? m_maxs.x : referencePosition.x);
+	float nearestY = referencePosition.y < m_mins.y ? m_mins.y : (referencePosition.y > m_maxs.y ? m_maxs.y : referencePosition.y);
+	float nearestZ = referencePosition.z < m_mins.z ? m_mins.z : (referencePosition.z > m_maxs.z ? m_maxs.z : referencePosition.z);
+
+	return Vec3(nearestX, nearestY, nearestZ);
+}
 void AABB3::SetDimensions(float width, float height, float depth)
 {
 	float halfWidth = width * 0.5f;
@@ -56,4 +77,14 @@ void AABB3::Translate(Vec3 const& translationToApply)
 {
 	m_mins += translationToApply;
 	m_maxs += translationToApply;
+}
+
+void AABB3::StretchToIncludePoint(Vec3 const& point)
+{
+	m_mins.x = point.x < m_mins.x ? point.x : m_mins.x;
+	m_mins.y = point.y < m_mins.y ? point.y : m_mins.y;
+	m_mins.z = point.z < m_mins.z ? point.z : m_mins.z;
+	m_maxs.x = point.x > m_maxs.x ? point.x : m_maxs.x;
+	m_maxs.y = point.y > m_maxs.y ? point.y : m_maxs.y;
+	m_maxs.z = point.z > m_maxs.z ? point.z : m_maxs.z;
 }
\ No newline at end of file
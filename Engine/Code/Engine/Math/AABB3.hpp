@@ -16,8 +16,12 @@ public:
 	explicit AABB3(float minX, float minY, float minZ, float maxX, float maxY, float maxZ);
 	explicit AABB3(Vec3 const& mins, Vec3 const& maxs);
 
+	bool IsPointInside(Vec3 const& point) const;
 	Vec3 GetCenter() const;
+	Vec3 GetDimensions() const;
+	Vec3 GetNearestPoint(Vec3 const& referencePosition) const;
 	void SetDimensions(float width, float height, float depth);
 	void SetCenter(Vec3 const& newCenter);
 	void Translate(Vec3 const& translationToApply);
+	void StretchToIncludePoint(Vec3 const& point);
 };
\ No newline at end of file
@@ -0,0 +1,861 @@
+#include "Engine/Math/BVH2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------------------------
+static void StretchBoundsToIncludeBounds(AABB2& bounds, AABB2 const& boundsToInclude)
+{
+	bounds.m_mins.x = bounds.m_mins.x < boundsToInclude.m_mins.x ? bounds.m_mins.x : boundsToInclude.m_mins.x;
+	bounds.m_mins.y = bounds.m_mins.y < boundsToInclude.m_mins.y ? bounds.m_mins.y : boundsToInclude.m_mins.y;
+	bounds.m_maxs.x = bounds.m_maxs.x > boundsToInclude.m_maxs.x ? bounds.m_maxs.x : boundsToInclude.m_maxs.x;
+	bounds.m_maxs.y = bounds.m_maxs.y > boundsToInclude.m_maxs.y ? bounds.m_maxs.y : boundsToInclude.m_maxs.y;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static AABB2 GetEmptyBounds()
+{
+	return AABB2(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The 2D equivalent of surface area for the SAH is the perimeter; half of it is enough for comparing costs
+static float GetHalfPerimeter(AABB2 const& bounds)
+{
+	if (bounds.m_maxs.x < bounds.m_mins.x || bounds.m_maxs.y < bounds.m_mins.y)
+	{
+		return 0.f;
+	}
+	return (bounds.m_maxs.x - bounds.m_mins.x) + (bounds.m_maxs.y - bounds.m_mins.y);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static float GetDistanceSquaredToBounds(Vec2 const& referencePos, AABB2 const& bounds)
+{
+	float deltaX = 0.f;
+	float deltaY = 0.f;
+	if		(referencePos.x < bounds.m_mins.x)	deltaX = bounds.m_mins.x - referencePos.x;
+	else if (referencePos.x > bounds.m_maxs.x)	deltaX = referencePos.x - bounds.m_maxs.x;
+	if		(referencePos.y < bounds.m_mins.y)	deltaY = bounds.m_mins.y - referencePos.y;
+	else if (referencePos.y > bounds.m_maxs.y)	deltaY = referencePos.y - bounds.m_maxs.y;
+	return (deltaX * deltaX) + (deltaY * deltaY);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Slab test against a node's bounds; out_enterDist is the distance along the ray where it enters the bounds
+static bool DoesRayOverlapBounds(Vec2 const& startPos, Vec2 const& fwdNormal, Vec2 const& inverseFwdNormal, float maxDist, AABB2 const& bounds, float& out_enterDist)
+{
+	float enterDist = 0.f;
+	float exitDist = maxDist;
+
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		float start			= axis == 0 ? startPos.x		: startPos.y;
+		float fwd			= axis == 0 ? fwdNormal.x		: fwdNormal.y;
+		float inverseFwd	= axis == 0 ? inverseFwdNormal.x : inverseFwdNormal.y;
+		float boundsMin		= axis == 0 ? bounds.m_mins.x	: bounds.m_mins.y;
+		float boundsMax		= axis == 0 ? bounds.m_maxs.x	: bounds.m_maxs.y;
+
+		// Ray is parallel to this slab, so it either always or never overlaps it
+		if (fwd == 0.f)
+		{
+			if (start < boundsMin || start > boundsMax)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float slabEnterDist = (boundsMin - start) * inverseFwd;
+		float slabExitDist = (boundsMax - start) * inverseFwd;
+		if (slabEnterDist > slabExitDist)
+		{
+			SwapFloatValues(slabEnterDist, slabExitDist);
+		}
+
+		enterDist = slabEnterDist > enterDist ? slabEnterDist : enterDist;
+		exitDist = slabExitDist < exitDist ? slabExitDist : exitDist;
+		if (enterDist > exitDist)
+		{
+			return false;
+		}
+	}
+
+	out_enterDist = enterDist;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool DoesCapsuleOverlapAABB2D(Vec2 const& boneStart, Vec2 const& boneEnd, float radius, AABB2 const& box)
+{
+	// If the bone passes through the box they overlap regardless of radius
+	Vec2 dispFromBoneStartToEnd = boneEnd - boneStart;
+	float boneLength = dispFromBoneStartToEnd.GetLength();
+	if (boneLength > 0.f)
+	{
+		Vec2 boneDirection = dispFromBoneStartToEnd / boneLength;
+		Vec2 inverseBoneDirection = Vec2(boneDirection.x != 0.f ? 1.f / boneDirection.x : 0.f, boneDirection.y != 0.f ? 1.f / boneDirection.y : 0.f);
+		float enterDist = 0.f;
+		if (DoesRayOverlapBounds(boneStart, boneDirection, inverseBoneDirection, boneLength, box, enterDist))
+		{
+			return true;
+		}
+	}
+
+	// Otherwise the closest pair of features is a bone end vs the box, or a box corner vs the bone
+	float radiusSquared = radius * radius;
+	if (GetDistanceSquared2D(GetNearestPointOnAABB2D(boneStart, box), boneStart) <= radiusSquared ||
+		GetDistanceSquared2D(GetNearestPointOnAABB2D(boneEnd, box), boneEnd) <= radiusSquared)
+	{
+		return true;
+	}
+
+	Vec2 boxCorners[4] =
+	{
+		box.m_mins,
+		Vec2(box.m_maxs.x, box.m_mins.y),
+		box.m_maxs,
+		Vec2(box.m_mins.x, box.m_maxs.y),
+	};
+	for (int cornerIndex = 0; cornerIndex < 4; ++cornerIndex)
+	{
+		Vec2 nearestPointOnBone = GetNearestPointOnLineSegment2D(boxCorners[cornerIndex], boneStart, boneEnd);
+		if (GetDistanceSquared2D(nearestPointOnBone, boxCorners[cornerIndex]) <= radiusSquared)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool DoesOBBOverlapAABB2D(OBB2 const& orientedBox, AABB2 const& orientedBoxBounds, AABB2 const& box)
+{
+	// Separating axis test; the world axes are already covered by the OBB's own bounds
+	if (!DoAABBsOverlap2D(orientedBoxBounds, box))
+	{
+		return false;
+	}
+
+	Vec2 boxCenter = box.GetCenter();
+	Vec2 boxHalfDimensions = box.GetDimensions() * 0.5f;
+	Vec2 dispFromOBBCenterToBoxCenter = boxCenter - orientedBox.m_center;
+	Vec2 orientedBoxAxes[2] = { orientedBox.m_iBasisNormal, orientedBox.m_iBasisNormal.GetRotated90Degrees() };
+	float orientedBoxHalfExtents[2] = { orientedBox.m_halfDimensions.x, orientedBox.m_halfDimensions.y };
+
+	for (int axisIndex = 0; axisIndex < 2; ++axisIndex)
+	{
+		Vec2 const& axis = orientedBoxAxes[axisIndex];
+		float boxProjectedRadius = (ABS_FLOAT(axis.x) * boxHalfDimensions.x) + (ABS_FLOAT(axis.y) * boxHalfDimensions.y);
+		float centerSeparation = ABS_FLOAT(DotProduct2D(dispFromOBBCenterToBoxCenter, axis));
+		if (centerSeparation > boxProjectedRadius + orientedBoxHalfExtents[axisIndex])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BVHShape2D const BVHShape2D::MakeDisc(Vec2 const& discCenter, float discRadius)
+{
+	BVHShape2D shape;
+	shape.m_type = BVHShapeType2D::DISC;
+	shape.m_pointA = discCenter;
+	shape.m_radius = discRadius;
+	return shape;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BVHShape2D const BVHShape2D::MakeAABB(AABB2 const& box)
+{
+	BVHShape2D shape;
+	shape.m_type = BVHShapeType2D::AABB;
+	shape.m_pointA = box.m_mins;
+	shape.m_pointB = box.m_maxs;
+	return shape;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BVHShape2D const BVHShape2D::MakeOBB(OBB2 const& orientedBox)
+{
+	BVHShape2D shape;
+	shape.m_type = BVHShapeType2D::OBB;
+	shape.m_pointA = orientedBox.m_center;
+	shape.m_pointB = orientedBox.m_iBasisNormal;
+	shape.m_halfDimensions = orientedBox.m_halfDimensions;
+	return shape;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BVHShape2D const BVHShape2D::MakeCapsule(Vec2 const& boneStart, Vec2 const& boneEnd, float radius)
+{
+	BVHShape2D shape;
+	shape.m_type = BVHShapeType2D::CAPSULE;
+	shape.m_pointA = boneStart;
+	shape.m_pointB = boneEnd;
+	shape.m_radius = radius;
+	return shape;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static OBB2 GetOBBForShape(BVHShape2D const& shape)
+{
+	OBB2 orientedBox;
+	orientedBox.m_center = shape.m_pointA;
+	orientedBox.m_iBasisNormal = shape.m_pointB;
+	orientedBox.m_halfDimensions = shape.m_halfDimensions;
+	return orientedBox;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB2 BVHShape2D::GetBounds() const
+{
+	switch (m_type)
+	{
+		case BVHShapeType2D::DISC:
+		{
+			return AABB2(m_pointA.x - m_radius, m_pointA.y - m_radius, m_pointA.x + m_radius, m_pointA.y + m_radius);
+		}
+		case BVHShapeType2D::AABB:
+		{
+			return AABB2(m_pointA, m_pointB);
+		}
+		case BVHShapeType2D::OBB:
+		{
+			Vec2 const& iBasisNormal = m_pointB;
+			Vec2 jBasisNormal = iBasisNormal.GetRotated90Degrees();
+			float halfExtentX = (ABS_FLOAT(iBasisNormal.x) * m_halfDimensions.x) + (ABS_FLOAT(jBasisNormal.x) * m_halfDimensions.y);
+			float halfExtentY = (ABS_FLOAT(iBasisNormal.y) * m_halfDimensions.x) + (ABS_FLOAT(jBasisNormal.y) * m_halfDimensions.y);
+			return AABB2(m_pointA.x - halfExtentX, m_pointA.y - halfExtentY, m_pointA.x + halfExtentX, m_pointA.y + halfExtentY);
+		}
+		case BVHShapeType2D::CAPSULE:
+		{
+			float minX = m_pointA.x < m_pointB.x ? m_pointA.x : m_pointB.x;
+			float minY = m_pointA.y < m_pointB.y ? m_pointA.y : m_pointB.y;
+			float maxX = m_pointA.x > m_pointB.x ? m_pointA.x : m_pointB.x;
+			float maxY = m_pointA.y > m_pointB.y ? m_pointA.y : m_pointB.y;
+			return AABB2(minX - m_radius, minY - m_radius, maxX + m_radius, maxY + m_radius);
+		}
+		default:
+		{
+			ERROR_AND_DIE("Invalid BVH shape type");
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool BVHShape2D::IsPointInside(Vec2 const& point) const
+{
+	switch (m_type)
+	{
+		case BVHShapeType2D::DISC:		return IsPointInsideDisc2D(point, m_pointA, m_radius);
+		case BVHShapeType2D::AABB:		return IsPointInsideAABB2D(point, AABB2(m_pointA, m_pointB));
+		case BVHShapeType2D::OBB:		return IsPointInsideOBB2D(point, GetOBBForShape(*this));
+		case BVHShapeType2D::CAPSULE:	return IsPointInsideCapsule2D(point, m_pointA, m_pointB, m_radius);
+		default:						ERROR_AND_DIE("Invalid BVH shape type");
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool BVHShape2D::IsOverlappingAABB(AABB2 const& box) const
+{
+	switch (m_type)
+	{
+		case BVHShapeType2D::DISC:
+		{
+			Vec2 nearestPointOnBox = GetNearestPointOnAABB2D(m_pointA, box);
+			return GetDistanceSquared2D(nearestPointOnBox, m_pointA) <= m_radius * m_radius;
+		}
+		case BVHShapeType2D::AABB:		return DoAABBsOverlap2D(AABB2(m_pointA, m_pointB), box);
+		case BVHShapeType2D::OBB:		return DoesOBBOverlapAABB2D(GetOBBForShape(*this), GetBounds(), box);
+		case BVHShapeType2D::CAPSULE:	return DoesCapsuleOverlapAABB2D(m_pointA, m_pointB, m_radius, box);
+		default:						ERROR_AND_DIE("Invalid BVH shape type");
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vec2 const BVHShape2D::GetNearestPoint(Vec2 const& referencePos) const
+{
+	switch (m_type)
+	{
+		case BVHShapeType2D::DISC:		return GetNearestPointOnDisc2D(referencePos, m_pointA, m_radius);
+		case BVHShapeType2D::AABB:		return GetNearestPointOnAABB2D(referencePos, AABB2(m_pointA, m_pointB));
+		case BVHShapeType2D::OBB:		return GetNearestPointOnOBB2D(referencePos, GetOBBForShape(*this));
+		case BVHShapeType2D::CAPSULE:	return GetNearestPointOnCapsule2D(referencePos, m_pointA, m_pointB, m_radius);
+		default:						ERROR_AND_DIE("Invalid BVH shape type");
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RaycastResult2D BVHShape2D::Raycast(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist) const
+{
+	switch (m_type)
+	{
+		case BVHShapeType2D::DISC:		return RaycastVsDisc2D(startPos, fwdNormal, maxDist, m_pointA, m_radius);
+		case BVHShapeType2D::AABB:		return RaycastVsAABB2D(startPos, fwdNormal, maxDist, AABB2(m_pointA, m_pointB));
+		case BVHShapeType2D::OBB:		return RaycastVsOBB2D(startPos, fwdNormal, maxDist, GetOBBForShape(*this));
+		case BVHShapeType2D::CAPSULE:	return RaycastVsCapsule2D(startPos, fwdNormal, maxDist, m_pointA, m_pointB, m_radius);
+		default:						ERROR_AND_DIE("Invalid BVH shape type");
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::AddShape(BVHShape2D const& shape)
+{
+	int shapeIndex = (int)m_shapes.size();
+	m_shapes.push_back(shape);
+	m_shapeBounds.push_back(shape.GetBounds());
+	m_isBuilt = false;
+	return shapeIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::AddDisc(Vec2 const& discCenter, float discRadius)
+{
+	return AddShape(BVHShape2D::MakeDisc(discCenter, discRadius));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::AddAABB(AABB2 const& box)
+{
+	return AddShape(BVHShape2D::MakeAABB(box));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::AddOBB(OBB2 const& orientedBox)
+{
+	return AddShape(BVHShape2D::MakeOBB(orientedBox));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::AddCapsule(Vec2 const& boneStart, Vec2 const& boneEnd, float radius)
+{
+	return AddShape(BVHShape2D::MakeCapsule(boneStart, boneEnd, radius));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::Clear()
+{
+	m_shapes.clear();
+	m_shapeBounds.clear();
+	m_shapeOrder.clear();
+	m_leafIndexForShape.clear();
+	m_nodes.clear();
+	m_isBuilt = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::Build()
+{
+	int numShapes = (int)m_shapes.size();
+	m_nodes.clear();
+	m_shapeOrder.resize(numShapes);
+	m_leafIndexForShape.resize(numShapes);
+	m_isBuilt = true;
+	if (numShapes == 0)
+	{
+		return;
+	}
+
+	std::vector<Vec2> shapeCentroids;
+	shapeCentroids.resize(numShapes);
+	for (int shapeIndex = 0; shapeIndex < numShapes; ++shapeIndex)
+	{
+		m_shapeOrder[shapeIndex] = shapeIndex;
+		shapeCentroids[shapeIndex] = m_shapeBounds[shapeIndex].GetCenter();
+	}
+
+	// A binary tree with at least one shape per leaf never has more than 2N - 1 nodes
+	m_nodes.reserve(2 * numShapes);
+	m_nodes.emplace_back();
+	BuildNode(0, 0, numShapes, 0, shapeCentroids);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::BuildNode(int nodeIndex, int firstShape, int numShapes, int depth, std::vector<Vec2> const& shapeCentroids)
+{
+	AABB2 nodeBounds = GetEmptyBounds();
+	AABB2 centroidBounds = GetEmptyBounds();
+	for (int orderIndex = firstShape; orderIndex < firstShape + numShapes; ++orderIndex)
+	{
+		int shapeIndex = m_shapeOrder[orderIndex];
+		StretchBoundsToIncludeBounds(nodeBounds, m_shapeBounds[shapeIndex]);
+		StretchBoundsToIncludeBounds(centroidBounds, AABB2(shapeCentroids[shapeIndex], shapeCentroids[shapeIndex]));
+	}
+	m_nodes[nodeIndex].m_bounds = nodeBounds;
+
+	auto MakeLeaf = [&]()
+	{
+		m_nodes[nodeIndex].m_firstChildOrShape = firstShape;
+		m_nodes[nodeIndex].m_numShapes = numShapes;
+		for (int orderIndex = firstShape; orderIndex < firstShape + numShapes; ++orderIndex)
+		{
+			m_leafIndexForShape[m_shapeOrder[orderIndex]] = nodeIndex;
+		}
+	};
+
+	if (numShapes <= BVH2D_MAX_SHAPES_PER_LEAF)
+	{
+		MakeLeaf();
+		return;
+	}
+
+	Vec2 centroidExtents = centroidBounds.m_maxs - centroidBounds.m_mins;
+	int splitAxis = centroidExtents.x >= centroidExtents.y ? 0 : 1;
+	float axisMin = splitAxis == 0 ? centroidBounds.m_mins.x : centroidBounds.m_mins.y;
+	float axisExtent = splitAxis == 0 ? centroidExtents.x : centroidExtents.y;
+	int* shapeOrderBegin = m_shapeOrder.data() + firstShape;
+	int* shapeOrderEnd = shapeOrderBegin + numShapes;
+	int numShapesOnLeft = 0;
+
+	if (axisExtent > 0.f && depth < BVH2D_MAX_SAH_DEPTH)
+	{
+		// Binned SAH: bucket the centroids along the split axis and evaluate a split at every bin boundary
+		int		binCounts[BVH2D_NUM_SAH_BINS] = {};
+		AABB2	binBounds[BVH2D_NUM_SAH_BINS];
+		for (int binIndex = 0; binIndex < BVH2D_NUM_SAH_BINS; ++binIndex)
+		{
+			binBounds[binIndex] = GetEmptyBounds();
+		}
+
+		float binsPerUnit = (float)BVH2D_NUM_SAH_BINS / axisExtent;
+		auto GetBinIndex = [&](int shapeIndex) -> int
+		{
+			Vec2 const& centroid = shapeCentroids[shapeIndex];
+			float centroidOnAxis = splitAxis == 0 ? centroid.x : centroid.y;
+			int binIndex = (int)((centroidOnAxis - axisMin) * binsPerUnit);
+			return binIndex < BVH2D_NUM_SAH_BINS ? binIndex : BVH2D_NUM_SAH_BINS - 1;
+		};
+
+		for (int orderIndex = firstShape; orderIndex < firstShape + numShapes; ++orderIndex)
+		{
+			int shapeIndex = m_shapeOrder[orderIndex];
+			int binIndex = GetBinIndex(shapeIndex);
+			binCounts[binIndex] += 1;
+			StretchBoundsToIncludeBounds(binBounds[binIndex], m_shapeBounds[shapeIndex]);
+		}
+
+		float	costOnRight[BVH2D_NUM_SAH_BINS] = {};
+		int		countOnRight = 0;
+		AABB2	boundsOnRight = GetEmptyBounds();
+		for (int binIndex = BVH2D_NUM_SAH_BINS - 1; binIndex > 0; --binIndex)
+		{
+			countOnRight += binCounts[binIndex];
+			StretchBoundsToIncludeBounds(boundsOnRight, binBounds[binIndex]);
+			costOnRight[binIndex] = (float)countOnRight * GetHalfPerimeter(boundsOnRight);
+		}
+
+		float	bestCost = FLT_MAX;
+		int		bestSplitBin = -1;
+		int		countOnLeft = 0;
+		AABB2	boundsOnLeft = GetEmptyBounds();
+		for (int binIndex = 0; binIndex < BVH2D_NUM_SAH_BINS - 1; ++binIndex)
+		{
+			countOnLeft += binCounts[binIndex];
+			StretchBoundsToIncludeBounds(boundsOnLeft, binBounds[binIndex]);
+			if (countOnLeft == 0 || countOnLeft == numShapes)
+			{
+				continue;
+			}
+
+			float cost = ((float)countOnLeft * GetHalfPerimeter(boundsOnLeft)) + costOnRight[binIndex + 1];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestSplitBin = binIndex;
+			}
+		}
+
+		if (bestSplitBin >= 0)
+		{
+			int* splitPoint = std::partition(shapeOrderBegin, shapeOrderEnd, [&](int shapeIndex) { return GetBinIndex(shapeIndex) <= bestSplitBin; });
+			numShapesOnLeft = (int)(splitPoint - shapeOrderBegin);
+		}
+	}
+
+	// Coincident centroids, or the tree is getting too deep; split by count so the depth stays logarithmic
+	if (numShapesOnLeft == 0 || numShapesOnLeft == numShapes)
+	{
+		numShapesOnLeft = numShapes / 2;
+		std::nth_element(shapeOrderBegin, shapeOrderBegin + numShapesOnLeft, shapeOrderEnd, [&](int shapeIndexA, int shapeIndexB)
+		{
+			Vec2 const& centroidA = shapeCentroids[shapeIndexA];
+			Vec2 const& centroidB = shapeCentroids[shapeIndexB];
+			return splitAxis == 0 ? centroidA.x < centroidB.x : centroidA.y < centroidB.y;
+		});
+	}
+
+	// Children are always allocated as a pair after their parent, which Refit() relies on
+	int leftChildIndex = (int)m_nodes.size();
+	m_nodes.emplace_back();
+	m_nodes.emplace_back();
+	m_nodes[nodeIndex].m_firstChildOrShape = leftChildIndex;
+	m_nodes[nodeIndex].m_numShapes = 0;
+	m_nodes[leftChildIndex].m_parentIndex = nodeIndex;
+	m_nodes[leftChildIndex + 1].m_parentIndex = nodeIndex;
+
+	BuildNode(leftChildIndex, firstShape, numShapesOnLeft, depth + 1, shapeCentroids);
+	BuildNode(leftChildIndex + 1, firstShape + numShapesOnLeft, numShapes - numShapesOnLeft, depth + 1, shapeCentroids);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::RefitNode(int nodeIndex)
+{
+	BVHNode2D& node = m_nodes[nodeIndex];
+	if (node.IsLeaf())
+	{
+		node.m_bounds = GetEmptyBounds();
+		for (int orderIndex = node.m_firstChildOrShape; orderIndex < node.m_firstChildOrShape + node.m_numShapes; ++orderIndex)
+		{
+			StretchBoundsToIncludeBounds(node.m_bounds, m_shapeBounds[m_shapeOrder[orderIndex]]);
+		}
+	}
+	else
+	{
+		node.m_bounds = m_nodes[node.m_firstChildOrShape].m_bounds;
+		StretchBoundsToIncludeBounds(node.m_bounds, m_nodes[node.m_firstChildOrShape + 1].m_bounds);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::Refit()
+{
+	if (!m_isBuilt)
+	{
+		Build();
+		return;
+	}
+
+	// Children always live after their parent, so a reverse sweep updates every child before its parent
+	for (int nodeIndex = (int)m_nodes.size() - 1; nodeIndex >= 0; --nodeIndex)
+	{
+		RefitNode(nodeIndex);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::UpdateShape(int shapeIndex, BVHShape2D const& shape)
+{
+	GUARANTEE_OR_DIE(shapeIndex >= 0 && shapeIndex < (int)m_shapes.size(), "BVH2D::UpdateShape() was given an invalid shape index");
+
+	m_shapes[shapeIndex] = shape;
+	m_shapeBounds[shapeIndex] = shape.GetBounds();
+	if (!m_isBuilt)
+	{
+		return;
+	}
+
+	// Walk up from the shape's leaf, stopping as soon as a node's bounds come out unchanged
+	int nodeIndex = m_leafIndexForShape[shapeIndex];
+	while (nodeIndex >= 0)
+	{
+		AABB2 previousBounds = m_nodes[nodeIndex].m_bounds;
+		RefitNode(nodeIndex);
+		if (m_nodes[nodeIndex].m_bounds == previousBounds)
+		{
+			break;
+		}
+		nodeIndex = m_nodes[nodeIndex].m_parentIndex;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::GetNumShapes() const
+{
+	return (int)m_shapes.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::GetNumNodes() const
+{
+	return (int)m_nodes.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BVHShape2D const& BVH2D::GetShape(int shapeIndex) const
+{
+	return m_shapes[shapeIndex];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB2 const BVH2D::GetBounds() const
+{
+	if (m_nodes.empty())
+	{
+		return AABB2::INVALID;
+	}
+	return m_nodes[0].m_bounds;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::GetShapesContainingPoint(Vec2 const& point, std::vector<int>& out_shapeIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH2D was queried before Build() was called");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int nodeStack[BVH2D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode2D const& node = m_nodes[nodeStack[--stackSize]];
+		if (GetDistanceSquaredToBounds(point, node.m_bounds) > 0.f)
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_firstChildOrShape;
+			nodeStack[stackSize++] = node.m_firstChildOrShape + 1;
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrShape; orderIndex < node.m_firstChildOrShape + node.m_numShapes; ++orderIndex)
+		{
+			int shapeIndex = m_shapeOrder[orderIndex];
+			if (m_shapes[shapeIndex].IsPointInside(point))
+			{
+				out_shapeIndexes.push_back(shapeIndex);
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH2D::GetShapesOverlappingAABB(AABB2 const& box, std::vector<int>& out_shapeIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH2D was queried before Build() was called");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int nodeStack[BVH2D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode2D const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoAABBsOverlap2D(node.m_bounds, box))
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_firstChildOrShape;
+			nodeStack[stackSize++] = node.m_firstChildOrShape + 1;
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrShape; orderIndex < node.m_firstChildOrShape + node.m_numShapes; ++orderIndex)
+		{
+			int shapeIndex = m_shapeOrder[orderIndex];
+			if (DoAABBsOverlap2D(m_shapeBounds[shapeIndex], box) && m_shapes[shapeIndex].IsOverlappingAABB(box))
+			{
+				out_shapeIndexes.push_back(shapeIndex);
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH2D::GetNearestShape(Vec2 const& referencePos, Vec2* out_nearestPoint, float maxDist) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH2D was queried before Build() was called");
+	if (m_nodes.empty())
+	{
+		return -1;
+	}
+
+	int		nearestShapeIndex = -1;
+	Vec2	nearestPoint;
+	float	nearestDistSquared = maxDist < FLT_MAX ? maxDist * maxDist : FLT_MAX;
+
+	int nodeStack[BVH2D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode2D const& node = m_nodes[nodeStack[--stackSize]];
+		if (GetDistanceSquaredToBounds(referencePos, node.m_bounds) > nearestDistSquared)
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			// Push the farther child first so the nearer one is visited first and tightens the search radius sooner
+			int leftChildIndex = node.m_firstChildOrShape;
+			int rightChildIndex = leftChildIndex + 1;
+			float leftDistSquared = GetDistanceSquaredToBounds(referencePos, m_nodes[leftChildIndex].m_bounds);
+			float rightDistSquared = GetDistanceSquaredToBounds(referencePos, m_nodes[rightChildIndex].m_bounds);
+			if (leftDistSquared < rightDistSquared)
+			{
+				nodeStack[stackSize++] = rightChildIndex;
+				nodeStack[stackSize++] = leftChildIndex;
+			}
+			else
+			{
+				nodeStack[stackSize++] = leftChildIndex;
+				nodeStack[stackSize++] = rightChildIndex;
+			}
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrShape; orderIndex < node.m_firstChildOrShape + node.m_numShapes; ++orderIndex)
+		{
+			int shapeIndex = m_shapeOrder[orderIndex];
+			if (GetDistanceSquaredToBounds(referencePos, m_shapeBounds[shapeIndex]) > nearestDistSquared)
+			{
+				continue;
+			}
+
+			Vec2 nearestPointOnShape = m_shapes[shapeIndex].GetNearestPoint(referencePos);
+			float distSquared = GetDistanceSquared2D(referencePos, nearestPointOnShape);
+			if (distSquared <= nearestDistSquared)
+			{
+				nearestDistSquared = distSquared;
+				nearestShapeIndex = shapeIndex;
+				nearestPoint = nearestPointOnShape;
+			}
+		}
+	}
+
+	if (out_nearestPoint && nearestShapeIndex >= 0)
+	{
+		*out_nearestPoint = nearestPoint;
+	}
+	return nearestShapeIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RaycastResult2D BVH2D::Raycast(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, int* out_shapeIndex, bool anyHit) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH2D was queried before Build() was called");
+
+	RaycastResult2D nearestResult;
+	int nearestShapeIndex = -1;
+	if (m_nodes.empty())
+	{
+		if (out_shapeIndex)
+		{
+			*out_shapeIndex = nearestShapeIndex;
+		}
+		return nearestResult;
+	}
+
+	Vec2 inverseFwdNormal = Vec2(fwdNormal.x != 0.f ? 1.f / fwdNormal.x : 0.f, fwdNormal.y != 0.f ? 1.f / fwdNormal.y : 0.f);
+	float nearestDist = maxDist;
+
+	int nodeStack[BVH2D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode2D const& node = m_nodes[nodeStack[--stackSize]];
+		float enterDist = 0.f;
+		if (!DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, node.m_bounds, enterDist))
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			// Visit the child the ray enters first
+			int leftChildIndex = node.m_firstChildOrShape;
+			int rightChildIndex = leftChildIndex + 1;
+			float leftEnterDist = FLT_MAX;
+			float rightEnterDist = FLT_MAX;
+			bool isLeftHit = DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, m_nodes[leftChildIndex].m_bounds, leftEnterDist);
+			bool isRightHit = DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, m_nodes[rightChildIndex].m_bounds, rightEnterDist);
+			if (isLeftHit && isRightHit)
+			{
+				nodeStack[stackSize++] = leftEnterDist < rightEnterDist ? rightChildIndex : leftChildIndex;
+				nodeStack[stackSize++] = leftEnterDist < rightEnterDist ? leftChildIndex : rightChildIndex;
+			}
+			else if (isLeftHit)
+			{
+				nodeStack[stackSize++] = leftChildIndex;
+			}
+			else if (isRightHit)
+			{
+				nodeStack[stackSize++] = rightChildIndex;
+			}
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrShape; orderIndex < node.m_firstChildOrShape + node.m_numShapes; ++orderIndex)
+		{
+			int shapeIndex = m_shapeOrder[orderIndex];
+			RaycastResult2D result = m_shapes[shapeIndex].Raycast(startPos, fwdNormal, nearestDist);
+			if (!result.m_didImpact || result.m_impactDist > nearestDist)
+			{
+				continue;
+			}
+
+			nearestResult = result;
+			nearestShapeIndex = shapeIndex;
+			nearestDist = result.m_impactDist;
+			if (anyHit)
+			{
+				stackSize = 0;
+				break;
+			}
+		}
+	}
+
+	if (out_shapeIndex)
+	{
+		*out_shapeIndex = nearestShapeIndex;
+	}
+	return nearestResult;
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+#include <vector>
+#include <float.h>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int BVH2D_MAX_SHAPES_PER_LEAF		= 4;
+constexpr int BVH2D_NUM_SAH_BINS			= 16;
+constexpr int BVH2D_MAX_SAH_DEPTH			= 64;	// Deeper than this and the build falls back to median splits
+constexpr int BVH2D_MAX_TRAVERSAL_DEPTH		= 128;
+
+
+//--------------------------------------------------------------------------------------------------
+enum class BVHShapeType2D : unsigned char
+{
+	DISC,
+	AABB,
+	OBB,
+	CAPSULE,
+
+	COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct BVHShape2D
+{
+public:
+	static BVHShape2D const MakeDisc(Vec2 const& discCenter, float discRadius);
+	static BVHShape2D const MakeAABB(AABB2 const& box);
+	static BVHShape2D const MakeOBB(OBB2 const& orientedBox);
+	static BVHShape2D const MakeCapsule(Vec2 const& boneStart, Vec2 const& boneEnd, float radius);
+
+	AABB2 GetBounds() const;
+	bool IsPointInside(Vec2 const& point) const;
+	bool IsOverlappingAABB(AABB2 const& box) const;
+	Vec2 const GetNearestPoint(Vec2 const& referencePos) const;
+	RaycastResult2D Raycast(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist) const;
+
+public:
+	// Disc:	m_pointA = center
+	// AABB:	m_pointA = mins, m_pointB = maxs
+	// OBB:		m_pointA = center, m_pointB = iBasisNormal, m_halfDimensions
+	// Capsule:	m_pointA = boneStart, m_pointB = boneEnd
+	BVHShapeType2D	m_type = BVHShapeType2D::DISC;
+	Vec2			m_pointA;
+	Vec2			m_pointB;
+	Vec2			m_halfDimensions;
+	float			m_radius = 0.f;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct BVHNode2D
+{
+	AABB2	m_bounds;
+	int		m_firstChildOrShape = -1;	// Interior: index of the left child (right child is +1); Leaf: first index into the shape order
+	int		m_numShapes			= 0;	// Zero for interior nodes
+	int		m_parentIndex		= -1;
+
+	bool IsLeaf() const { return m_numShapes > 0; }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Bounding volume hierarchy over mixed 2D shapes, built with a binned surface area heuristic.
+// Shapes are referred to by the index returned from AddShape(). Moving shapes can be updated
+// in place with UpdateShape() (walks up from the shape's leaf) or all at once with Refit();
+// refitting keeps the tree topology, so call Build() again once shapes have moved far.
+// Queries are const and safe to run from multiple threads at once.
+//--------------------------------------------------------------------------------------------------
+class BVH2D
+{
+public:
+	BVH2D() {}
+	~BVH2D() {}
+
+	int		AddShape(BVHShape2D const& shape);
+	int		AddDisc(Vec2 const& discCenter, float discRadius);
+	int		AddAABB(AABB2 const& box);
+	int		AddOBB(OBB2 const& orientedBox);
+	int		AddCapsule(Vec2 const& boneStart, Vec2 const& boneEnd, float radius);
+	void	Clear();
+
+	void	Build();
+	void	Refit();
+	void	UpdateShape(int shapeIndex, BVHShape2D const& shape);
+
+	int					GetNumShapes() const;
+	int					GetNumNodes() const;
+	BVHShape2D const&	GetShape(int shapeIndex) const;
+	AABB2 const			GetBounds() const;
+
+	// Each of these appends the matching shape indexes to the output list
+	void	GetShapesContainingPoint(Vec2 const& point, std::vector<int>& out_shapeIndexes) const;
+	void	GetShapesOverlappingAABB(AABB2 const& box, std::vector<int>& out_shapeIndexes) const;
+
+	// Returns -1 if there is no shape within maxDist
+	int		GetNearestShape(Vec2 const& referencePos, Vec2* out_nearestPoint = nullptr, float maxDist = FLT_MAX) const;
+
+	// Returns the nearest impact along the ray; when anyHit is true, returns the first impact found instead
+	RaycastResult2D Raycast(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, int* out_shapeIndex = nullptr, bool anyHit = false) const;
+
+private:
+	void	BuildNode(int nodeIndex, int firstShape, int numShapes, int depth, std::vector<Vec2> const& shapeCentroids);
+	void	RefitNode(int nodeIndex);
+
+private:
+	std::vector<BVHShape2D>	m_shapes;
+	std::vector<AABB2>		m_shapeBounds;
+	std::vector<int>		m_shapeOrder;
+	std::vector<int>		m_leafIndexForShape;
+	std::vector<BVHNode2D>	m_nodes;
+	bool					m_isBuilt = false;
+};
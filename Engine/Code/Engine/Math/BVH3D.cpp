@@ -0,0 +1,688 @@
+#include "Engine/Math/BVH3D.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/JobSystem.hpp"
+
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------------------------
+static void StretchBoundsToIncludeBounds(AABB3& bounds, AABB3 const& boundsToInclude)
+{
+	bounds.m_mins.x = bounds.m_mins.x < boundsToInclude.m_mins.x ? bounds.m_mins.x : boundsToInclude.m_mins.x;
+	bounds.m_mins.y = bounds.m_mins.y < boundsToInclude.m_mins.y ? bounds.m_mins.y : boundsToInclude.m_mins.y;
+	bounds.m_mins.z = bounds.m_mins.z < boundsToInclude.m_mins.z ? bounds.m_mins.z : boundsToInclude.m_mins.z;
+	bounds.m_maxs.x = bounds.m_maxs.x > boundsToInclude.m_maxs.x ? bounds.m_maxs.x : boundsToInclude.m_maxs.x;
+	bounds.m_maxs.y = bounds.m_maxs.y > boundsToInclude.m_maxs.y ? bounds.m_maxs.y : boundsToInclude.m_maxs.y;
+	bounds.m_maxs.z = bounds.m_maxs.z > boundsToInclude.m_maxs.z ? bounds.m_maxs.z : boundsToInclude.m_maxs.z;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static AABB3 GetEmptyBounds()
+{
+	return AABB3(FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool AreBoundsEqual(AABB3 const& boundsA, AABB3 const& boundsB)
+{
+	return boundsA.m_mins.x == boundsB.m_mins.x && boundsA.m_mins.y == boundsB.m_mins.y && boundsA.m_mins.z == boundsB.m_mins.z &&
+		   boundsA.m_maxs.x == boundsB.m_maxs.x && boundsA.m_maxs.y == boundsB.m_maxs.y && boundsA.m_maxs.z == boundsB.m_maxs.z;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Half the surface area is enough for comparing SAH costs
+static float GetHalfSurfaceArea(AABB3 const& bounds)
+{
+	if (bounds.m_maxs.x < bounds.m_mins.x || bounds.m_maxs.y < bounds.m_mins.y || bounds.m_maxs.z < bounds.m_mins.z)
+	{
+		return 0.f;
+	}
+	float sizeX = bounds.m_maxs.x - bounds.m_mins.x;
+	float sizeY = bounds.m_maxs.y - bounds.m_mins.y;
+	float sizeZ = bounds.m_maxs.z - bounds.m_mins.z;
+	return (sizeX * sizeY) + (sizeY * sizeZ) + (sizeZ * sizeX);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static float GetAxisValue(Vec3 const& vector, int axis)
+{
+	return axis == 0 ? vector.x : (axis == 1 ? vector.y : vector.z);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Slab test against a node's bounds; out_enterDist is the distance along the ray where it enters the bounds
+static bool DoesRayOverlapBounds(Vec3 const& startPos, Vec3 const& fwdNormal, Vec3 const& inverseFwdNormal, float maxDist, AABB3 const& bounds, float& out_enterDist)
+{
+	float enterDist = 0.f;
+	float exitDist = maxDist;
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		float start			= GetAxisValue(startPos, axis);
+		float fwd			= GetAxisValue(fwdNormal, axis);
+		float inverseFwd	= GetAxisValue(inverseFwdNormal, axis);
+		float boundsMin		= GetAxisValue(bounds.m_mins, axis);
+		float boundsMax		= GetAxisValue(bounds.m_maxs, axis);
+
+		// Ray is parallel to this slab, so it either always or never overlaps it
+		if (fwd == 0.f)
+		{
+			if (start < boundsMin || start > boundsMax)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float slabEnterDist = (boundsMin - start) * inverseFwd;
+		float slabExitDist = (boundsMax - start) * inverseFwd;
+		if (slabEnterDist > slabExitDist)
+		{
+			SwapFloatValues(slabEnterDist, slabExitDist);
+		}
+
+		enterDist = slabEnterDist > enterDist ? slabEnterDist : enterDist;
+		exitDist = slabExitDist < exitDist ? slabExitDist : exitDist;
+		if (enterDist > exitDist)
+		{
+			return false;
+		}
+	}
+
+	out_enterDist = enterDist;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Builds one subtree below the parallel build depth into its own node list, rooted at index 0
+class BVH3DBuildJob : public Job
+{
+public:
+	BVH3DBuildJob(BVH3D* bvh, BVH3D::DeferredSubtree const& subtree, std::vector<Vec3> const& objectCentroids) :
+		m_bvh(bvh),
+		m_subtree(subtree),
+		m_objectCentroids(objectCentroids)
+	{};
+	virtual void Execute() override
+	{
+		m_nodes.reserve(2 * m_subtree.m_numObjects);
+		m_nodes.emplace_back();
+		m_bvh->BuildNode(m_nodes, 0, m_subtree.m_firstObject, m_subtree.m_numObjects, m_subtree.m_depth, m_objectCentroids, nullptr);
+	}
+
+	BVH3D*					m_bvh = nullptr;
+	BVH3D::DeferredSubtree	m_subtree;
+	std::vector<Vec3> const& m_objectCentroids;
+	std::vector<BVHNode3D>	m_nodes;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH3D::AddObject(AABB3 const& bounds)
+{
+	int objectIndex = (int)m_objectBounds.size();
+	m_objectBounds.push_back(bounds);
+	m_isBuilt = false;
+	return objectIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::Clear()
+{
+	m_objectBounds.clear();
+	m_objectOrder.clear();
+	m_leafIndexForObject.clear();
+	m_nodes.clear();
+	m_isBuilt = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::Build(bool useJobSystem)
+{
+	int numObjects = (int)m_objectBounds.size();
+	m_nodes.clear();
+	m_objectOrder.resize(numObjects);
+	m_leafIndexForObject.resize(numObjects);
+	m_isBuilt = true;
+	if (numObjects == 0)
+	{
+		return;
+	}
+
+	std::vector<Vec3> objectCentroids;
+	objectCentroids.resize(numObjects);
+	for (int objectIndex = 0; objectIndex < numObjects; ++objectIndex)
+	{
+		m_objectOrder[objectIndex] = objectIndex;
+		objectCentroids[objectIndex] = m_objectBounds[objectIndex].GetCenter();
+	}
+
+	// A binary tree with at least one object per leaf never has more than 2N - 1 nodes
+	m_nodes.reserve(2 * numObjects);
+	m_nodes.emplace_back();
+
+	bool isParallelBuild = useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0 && numObjects >= BVH3D_MIN_OBJECTS_PER_BUILD_JOB;
+	std::vector<DeferredSubtree> deferredSubtrees;
+	BuildNode(m_nodes, 0, 0, numObjects, 0, objectCentroids, isParallelBuild ? &deferredSubtrees : nullptr);
+
+	if (!deferredSubtrees.empty())
+	{
+		// Each job only reorders its own range of m_objectOrder, so the subtrees can build side by side
+		std::vector<Job*> jobs;
+		for (int subtreeIndex = 0; subtreeIndex < (int)deferredSubtrees.size(); ++subtreeIndex)
+		{
+			jobs.push_back(new BVH3DBuildJob(this, deferredSubtrees[subtreeIndex], objectCentroids));
+		}
+		g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+
+		// Splice each subtree in: its root replaces the placeholder node and the rest are appended,
+		// which keeps children after their parents for Refit()
+		for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+		{
+			BVH3DBuildJob* buildJob = (BVH3DBuildJob*)jobs[jobIndex];
+			std::vector<BVHNode3D> const& subtreeNodes = buildJob->m_nodes;
+			int rootNodeIndex = buildJob->m_subtree.m_nodeIndex;
+			int firstAppendedNodeIndex = (int)m_nodes.size();
+			auto GetSplicedNodeIndex = [&](int subtreeNodeIndex)
+			{
+				return subtreeNodeIndex == 0 ? rootNodeIndex : firstAppendedNodeIndex + subtreeNodeIndex - 1;
+			};
+
+			for (int subtreeNodeIndex = 0; subtreeNodeIndex < (int)subtreeNodes.size(); ++subtreeNodeIndex)
+			{
+				BVHNode3D node = subtreeNodes[subtreeNodeIndex];
+				if (!node.IsLeaf())
+				{
+					node.m_firstChildOrObject = GetSplicedNodeIndex(node.m_firstChildOrObject);
+				}
+
+				if (subtreeNodeIndex == 0)
+				{
+					node.m_parentIndex = m_nodes[rootNodeIndex].m_parentIndex;
+					m_nodes[rootNodeIndex] = node;
+				}
+				else
+				{
+					node.m_parentIndex = GetSplicedNodeIndex(node.m_parentIndex);
+					m_nodes.push_back(node);
+				}
+			}
+			delete buildJob;
+		}
+
+		// The placeholders' ancestors were built before their bounds were known
+		for (int nodeIndex = (int)m_nodes.size() - 1; nodeIndex >= 0; --nodeIndex)
+		{
+			if (!m_nodes[nodeIndex].IsLeaf())
+			{
+				RefitNode(nodeIndex);
+			}
+		}
+	}
+
+	for (int nodeIndex = 0; nodeIndex < (int)m_nodes.size(); ++nodeIndex)
+	{
+		BVHNode3D const& node = m_nodes[nodeIndex];
+		for (int orderIndex = node.m_firstChildOrObject; node.IsLeaf() && orderIndex < node.m_firstChildOrObject + node.m_numObjects; ++orderIndex)
+		{
+			m_leafIndexForObject[m_objectOrder[orderIndex]] = nodeIndex;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::BuildNode(std::vector<BVHNode3D>& nodes, int nodeIndex, int firstObject, int numObjects, int depth, std::vector<Vec3> const& objectCentroids, std::vector<DeferredSubtree>* out_deferredSubtrees)
+{
+	if (out_deferredSubtrees && depth >= BVH3D_PARALLEL_BUILD_DEPTH && numObjects > BVH3D_MAX_OBJECTS_PER_LEAF)
+	{
+		DeferredSubtree subtree;
+		subtree.m_nodeIndex = nodeIndex;
+		subtree.m_firstObject = firstObject;
+		subtree.m_numObjects = numObjects;
+		subtree.m_depth = depth;
+		out_deferredSubtrees->push_back(subtree);
+		return;
+	}
+
+	AABB3 nodeBounds = GetEmptyBounds();
+	AABB3 centroidBounds = GetEmptyBounds();
+	for (int orderIndex = firstObject; orderIndex < firstObject + numObjects; ++orderIndex)
+	{
+		int objectIndex = m_objectOrder[orderIndex];
+		StretchBoundsToIncludeBounds(nodeBounds, m_objectBounds[objectIndex]);
+		centroidBounds.StretchToIncludePoint(objectCentroids[objectIndex]);
+	}
+	nodes[nodeIndex].m_bounds = nodeBounds;
+
+	if (numObjects <= BVH3D_MAX_OBJECTS_PER_LEAF)
+	{
+		nodes[nodeIndex].m_firstChildOrObject = firstObject;
+		nodes[nodeIndex].m_numObjects = numObjects;
+		return;
+	}
+
+	Vec3 centroidExtents = centroidBounds.GetDimensions();
+	int splitAxis = 0;
+	if (centroidExtents.y > GetAxisValue(centroidExtents, splitAxis))	splitAxis = 1;
+	if (centroidExtents.z > GetAxisValue(centroidExtents, splitAxis))	splitAxis = 2;
+	float axisMin = GetAxisValue(centroidBounds.m_mins, splitAxis);
+	float axisExtent = GetAxisValue(centroidExtents, splitAxis);
+	int* objectOrderBegin = m_objectOrder.data() + firstObject;
+	int* objectOrderEnd = objectOrderBegin + numObjects;
+	int numObjectsOnLeft = 0;
+
+	if (axisExtent > 0.f && depth < BVH3D_MAX_SAH_DEPTH)
+	{
+		// Binned SAH: bucket the centroids along the split axis and evaluate a split at every bin boundary
+		int		binCounts[BVH3D_NUM_SAH_BINS] = {};
+		AABB3	binBounds[BVH3D_NUM_SAH_BINS];
+		for (int binIndex = 0; binIndex < BVH3D_NUM_SAH_BINS; ++binIndex)
+		{
+			binBounds[binIndex] = GetEmptyBounds();
+		}
+
+		float binsPerUnit = (float)BVH3D_NUM_SAH_BINS / axisExtent;
+		auto GetBinIndex = [&](int objectIndex) -> int
+		{
+			float centroidOnAxis = GetAxisValue(objectCentroids[objectIndex], splitAxis);
+			int binIndex = (int)((centroidOnAxis - axisMin) * binsPerUnit);
+			return binIndex < BVH3D_NUM_SAH_BINS ? binIndex : BVH3D_NUM_SAH_BINS - 1;
+		};
+
+		for (int orderIndex = firstObject; orderIndex < firstObject + numObjects; ++orderIndex)
+		{
+			int objectIndex = m_objectOrder[orderIndex];
+			int binIndex = GetBinIndex(objectIndex);
+			binCounts[binIndex] += 1;
+			StretchBoundsToIncludeBounds(binBounds[binIndex], m_objectBounds[objectIndex]);
+		}
+
+		float	costOnRight[BVH3D_NUM_SAH_BINS] = {};
+		int		countOnRight = 0;
+		AABB3	boundsOnRight = GetEmptyBounds();
+		for (int binIndex = BVH3D_NUM_SAH_BINS - 1; binIndex > 0; --binIndex)
+		{
+			countOnRight += binCounts[binIndex];
+			StretchBoundsToIncludeBounds(boundsOnRight, binBounds[binIndex]);
+			costOnRight[binIndex] = (float)countOnRight * GetHalfSurfaceArea(boundsOnRight);
+		}
+
+		float	bestCost = FLT_MAX;
+		int		bestSplitBin = -1;
+		int		countOnLeft = 0;
+		AABB3	boundsOnLeft = GetEmptyBounds();
+		for (int binIndex = 0; binIndex < BVH3D_NUM_SAH_BINS - 1; ++binIndex)
+		{
+			countOnLeft += binCounts[binIndex];
+			StretchBoundsToIncludeBounds(boundsOnLeft, binBounds[binIndex]);
+			if (countOnLeft == 0 || countOnLeft == numObjects)
+			{
+				continue;
+			}
+
+			float cost = ((float)countOnLeft * GetHalfSurfaceArea(boundsOnLeft)) + costOnRight[binIndex + 1];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestSplitBin = binIndex;
+			}
+		}
+
+		if (bestSplitBin >= 0)
+		{
+			int* splitPoint = std::partition(objectOrderBegin, objectOrderEnd, [&](int objectIndex) { return GetBinIndex(objectIndex) <= bestSplitBin; });
+			numObjectsOnLeft = (int)(splitPoint - objectOrderBegin);
+		}
+	}
+
+	// Coincident centroids, or the tree is getting too deep; split by count so the depth stays logarithmic
+	if (numObjectsOnLeft == 0 || numObjectsOnLeft == numObjects)
+	{
+		numObjectsOnLeft = numObjects / 2;
+		std::nth_element(objectOrderBegin, objectOrderBegin + numObjectsOnLeft, objectOrderEnd, [&](int objectIndexA, int objectIndexB)
+		{
+			return GetAxisValue(objectCentroids[objectIndexA], splitAxis) < GetAxisValue(objectCentroids[objectIndexB], splitAxis);
+		});
+	}
+
+	// Children are always allocated as a pair after their parent, which Refit() relies on
+	int leftChildIndex = (int)nodes.size();
+	nodes.emplace_back();
+	nodes.emplace_back();
+	nodes[nodeIndex].m_firstChildOrObject = leftChildIndex;
+	nodes[nodeIndex].m_numObjects = 0;
+	nodes[leftChildIndex].m_parentIndex = nodeIndex;
+	nodes[leftChildIndex + 1].m_parentIndex = nodeIndex;
+
+	BuildNode(nodes, leftChildIndex, firstObject, numObjectsOnLeft, depth + 1, objectCentroids, out_deferredSubtrees);
+	BuildNode(nodes, leftChildIndex + 1, firstObject + numObjectsOnLeft, numObjects - numObjectsOnLeft, depth + 1, objectCentroids, out_deferredSubtrees);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::RefitNode(int nodeIndex)
+{
+	BVHNode3D& node = m_nodes[nodeIndex];
+	if (node.IsLeaf())
+	{
+		node.m_bounds = GetEmptyBounds();
+		for (int orderIndex = node.m_firstChildOrObject; orderIndex < node.m_firstChildOrObject + node.m_numObjects; ++orderIndex)
+		{
+			StretchBoundsToIncludeBounds(node.m_bounds, m_objectBounds[m_objectOrder[orderIndex]]);
+		}
+	}
+	else
+	{
+		node.m_bounds = m_nodes[node.m_firstChildOrObject].m_bounds;
+		StretchBoundsToIncludeBounds(node.m_bounds, m_nodes[node.m_firstChildOrObject + 1].m_bounds);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::Refit()
+{
+	if (!m_isBuilt)
+	{
+		Build();
+		return;
+	}
+
+	// Children always live after their parent, so a reverse sweep updates every child before its parent
+	for (int nodeIndex = (int)m_nodes.size() - 1; nodeIndex >= 0; --nodeIndex)
+	{
+		RefitNode(nodeIndex);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::UpdateObject(int objectIndex, AABB3 const& bounds)
+{
+	GUARANTEE_OR_DIE(objectIndex >= 0 && objectIndex < (int)m_objectBounds.size(), "BVH3D::UpdateObject() was given an invalid object index");
+
+	m_objectBounds[objectIndex] = bounds;
+	if (!m_isBuilt)
+	{
+		return;
+	}
+
+	// Walk up from the object's leaf, stopping as soon as a node's bounds come out unchanged
+	int nodeIndex = m_leafIndexForObject[objectIndex];
+	while (nodeIndex >= 0)
+	{
+		AABB3 previousBounds = m_nodes[nodeIndex].m_bounds;
+		RefitNode(nodeIndex);
+		if (AreBoundsEqual(m_nodes[nodeIndex].m_bounds, previousBounds))
+		{
+			break;
+		}
+		nodeIndex = m_nodes[nodeIndex].m_parentIndex;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH3D::GetNumObjects() const
+{
+	return (int)m_objectBounds.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int BVH3D::GetNumNodes() const
+{
+	return (int)m_nodes.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3 const& BVH3D::GetObjectBounds(int objectIndex) const
+{
+	return m_objectBounds[objectIndex];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3 const BVH3D::GetBounds() const
+{
+	if (m_nodes.empty())
+	{
+		return AABB3::INVALID;
+	}
+	return m_nodes[0].m_bounds;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::GetObjectsOverlappingAABB(AABB3 const& box, std::vector<int>& out_objectIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3D was queried before Build() was called");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int nodeStack[BVH3D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode3D const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoAABBsOverlap3D(node.m_bounds, box))
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_firstChildOrObject;
+			nodeStack[stackSize++] = node.m_firstChildOrObject + 1;
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrObject; orderIndex < node.m_firstChildOrObject + node.m_numObjects; ++orderIndex)
+		{
+			int objectIndex = m_objectOrder[orderIndex];
+			if (DoAABBsOverlap3D(m_objectBounds[objectIndex], box))
+			{
+				out_objectIndexes.push_back(objectIndex);
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::GetObjectsOverlappingSphere(Vec3 const& sphereCenter, float sphereRadius, std::vector<int>& out_objectIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3D was queried before Build() was called");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	int nodeStack[BVH3D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode3D const& node = m_nodes[nodeStack[--stackSize]];
+		if (!DoSphereAndAABBOverlap3D(sphereCenter, sphereRadius, node.m_bounds))
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			nodeStack[stackSize++] = node.m_firstChildOrObject;
+			nodeStack[stackSize++] = node.m_firstChildOrObject + 1;
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrObject; orderIndex < node.m_firstChildOrObject + node.m_numObjects; ++orderIndex)
+		{
+			int objectIndex = m_objectOrder[orderIndex];
+			if (DoSphereAndAABBOverlap3D(sphereCenter, sphereRadius, m_objectBounds[objectIndex]))
+			{
+				out_objectIndexes.push_back(objectIndex);
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BVH3D::GetObjectsInFrustum(Frustum const& frustum, std::vector<int>& out_objectIndexes) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3D was queried before Build() was called");
+	if (m_nodes.empty())
+	{
+		return;
+	}
+
+	// Once a node is entirely inside the frustum, everything below it is too and needs no more plane tests
+	int		nodeStack[BVH3D_MAX_TRAVERSAL_DEPTH];
+	bool	isInsideStack[BVH3D_MAX_TRAVERSAL_DEPTH];
+	int		stackSize = 0;
+	nodeStack[stackSize] = 0;
+	isInsideStack[stackSize++] = false;
+
+	while (stackSize > 0)
+	{
+		--stackSize;
+		BVHNode3D const& node = m_nodes[nodeStack[stackSize]];
+		bool isInside = isInsideStack[stackSize];
+		if (!isInside)
+		{
+			FrustumOverlap overlap = frustum.GetAABBOverlap(node.m_bounds);
+			if (overlap == FrustumOverlap::OUTSIDE)
+			{
+				continue;
+			}
+			isInside = overlap == FrustumOverlap::INSIDE;
+		}
+
+		if (!node.IsLeaf())
+		{
+			nodeStack[stackSize] = node.m_firstChildOrObject;
+			isInsideStack[stackSize++] = isInside;
+			nodeStack[stackSize] = node.m_firstChildOrObject + 1;
+			isInsideStack[stackSize++] = isInside;
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrObject; orderIndex < node.m_firstChildOrObject + node.m_numObjects; ++orderIndex)
+		{
+			int objectIndex = m_objectOrder[orderIndex];
+			if (isInside || !frustum.IsAABBOutside(m_objectBounds[objectIndex]))
+			{
+				out_objectIndexes.push_back(objectIndex);
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RaycastResult3D BVH3D::Raycast(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_objectIndex, bool anyHit, BVH3DRaycastFunc const& raycastObject) const
+{
+	GUARANTEE_OR_DIE(m_isBuilt, "BVH3D was queried before Build() was called");
+
+	RaycastResult3D nearestResult;
+	int nearestObjectIndex = -1;
+	if (m_nodes.empty())
+	{
+		if (out_objectIndex)
+		{
+			*out_objectIndex = nearestObjectIndex;
+		}
+		return nearestResult;
+	}
+
+	Vec3 inverseFwdNormal = Vec3(fwdNormal.x != 0.f ? 1.f / fwdNormal.x : 0.f, fwdNormal.y != 0.f ? 1.f / fwdNormal.y : 0.f, fwdNormal.z != 0.f ? 1.f / fwdNormal.z : 0.f);
+	float nearestDist = maxDist;
+
+	int nodeStack[BVH3D_MAX_TRAVERSAL_DEPTH];
+	int stackSize = 0;
+	nodeStack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		BVHNode3D const& node = m_nodes[nodeStack[--stackSize]];
+		float enterDist = 0.f;
+		if (!DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, node.m_bounds, enterDist))
+		{
+			continue;
+		}
+
+		if (!node.IsLeaf())
+		{
+			// Visit the child the ray enters first
+			int leftChildIndex = node.m_firstChildOrObject;
+			int rightChildIndex = leftChildIndex + 1;
+			float leftEnterDist = FLT_MAX;
+			float rightEnterDist = FLT_MAX;
+			bool isLeftHit = DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, m_nodes[leftChildIndex].m_bounds, leftEnterDist);
+			bool isRightHit = DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, m_nodes[rightChildIndex].m_bounds, rightEnterDist);
+			if (isLeftHit && isRightHit)
+			{
+				nodeStack[stackSize++] = leftEnterDist < rightEnterDist ? rightChildIndex : leftChildIndex;
+				nodeStack[stackSize++] = leftEnterDist < rightEnterDist ? leftChildIndex : rightChildIndex;
+			}
+			else if (isLeftHit)
+			{
+				nodeStack[stackSize++] = leftChildIndex;
+			}
+			else if (isRightHit)
+			{
+				nodeStack[stackSize++] = rightChildIndex;
+			}
+			continue;
+		}
+
+		for (int orderIndex = node.m_firstChildOrObject; orderIndex < node.m_firstChildOrObject + node.m_numObjects; ++orderIndex)
+		{
+			int objectIndex = m_objectOrder[orderIndex];
+			float objectEnterDist = 0.f;
+			if (!DoesRayOverlapBounds(startPos, fwdNormal, inverseFwdNormal, nearestDist, m_objectBounds[objectIndex], objectEnterDist))
+			{
+				continue;
+			}
+
+			RaycastResult3D result = raycastObject ? raycastObject(objectIndex, startPos, fwdNormal, nearestDist) : RaycastVsAABB3D(startPos, fwdNormal, nearestDist, m_objectBounds[objectIndex]);
+			if (!result.m_didImpact || result.m_impactDist > nearestDist)
+			{
+				continue;
+			}
+
+			nearestResult = result;
+			nearestObjectIndex = objectIndex;
+			nearestDist = result.m_impactDist;
+			if (anyHit)
+			{
+				stackSize = 0;
+				break;
+			}
+		}
+	}
+
+	if (out_objectIndex)
+	{
+		*out_objectIndex = nearestObjectIndex;
+	}
+	return nearestResult;
+}
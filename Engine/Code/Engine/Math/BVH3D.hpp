@@ -0,0 +1,91 @@
+#pragma once
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/RaycastUtils.hpp"
+
+#include <vector>
+#include <functional>
+#include <float.h>
+
+struct Frustum;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int BVH3D_MAX_OBJECTS_PER_LEAF		= 4;
+constexpr int BVH3D_NUM_SAH_BINS				= 16;
+constexpr int BVH3D_MAX_SAH_DEPTH				= 64;	// Deeper than this and the build falls back to median splits
+constexpr int BVH3D_MAX_TRAVERSAL_DEPTH			= 128;
+constexpr int BVH3D_PARALLEL_BUILD_DEPTH		= 4;	// Subtrees below this depth are built as separate jobs (up to 16)
+constexpr int BVH3D_MIN_OBJECTS_PER_BUILD_JOB	= 4096;
+
+
+//--------------------------------------------------------------------------------------------------
+struct BVHNode3D
+{
+	AABB3	m_bounds;
+	int		m_firstChildOrObject	= -1;	// Interior: index of the left child (right child is +1); Leaf: first index into the object order
+	int		m_numObjects			= 0;	// Zero for interior nodes
+	int		m_parentIndex			= -1;
+
+	bool IsLeaf() const { return m_numObjects > 0; }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Optional narrow phase for BVH3D::Raycast(); called for each object whose bounds the ray reaches
+typedef std::function<RaycastResult3D(int objectIndex, Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist)> BVH3DRaycastFunc;
+
+
+//--------------------------------------------------------------------------------------------------
+// Bounding volume hierarchy over objects known only by their AABB3 bounds, built with a binned
+// surface area heuristic. Objects are referred to by the index returned from AddObject(), so the
+// caller keeps its own objects and can supply exact raycasts for them through a BVH3DRaycastFunc.
+// Large builds split the top of the tree on the main thread and build the subtrees over the JobSystem.
+// Queries are const and safe to run from multiple threads at once.
+//--------------------------------------------------------------------------------------------------
+class BVH3D
+{
+	friend class BVH3DBuildJob;
+public:
+	BVH3D() {}
+	~BVH3D() {}
+
+	int		AddObject(AABB3 const& bounds);
+	void	Clear();
+
+	void	Build(bool useJobSystem = true);
+	void	Refit();
+	void	UpdateObject(int objectIndex, AABB3 const& bounds);
+
+	int				GetNumObjects() const;
+	int				GetNumNodes() const;
+	AABB3 const&	GetObjectBounds(int objectIndex) const;
+	AABB3 const		GetBounds() const;
+
+	// Each of these appends the matching object indexes to the output list
+	void	GetObjectsOverlappingAABB(AABB3 const& box, std::vector<int>& out_objectIndexes) const;
+	void	GetObjectsOverlappingSphere(Vec3 const& sphereCenter, float sphereRadius, std::vector<int>& out_objectIndexes) const;
+	void	GetObjectsInFrustum(Frustum const& frustum, std::vector<int>& out_objectIndexes) const;
+
+	// Returns the nearest impact along the ray; when anyHit is true, returns the first impact found instead.
+	// Objects are raycast as their bounds unless raycastObject is given.
+	RaycastResult3D Raycast(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, int* out_objectIndex = nullptr, bool anyHit = false, BVH3DRaycastFunc const& raycastObject = nullptr) const;
+
+private:
+	struct DeferredSubtree
+	{
+		int m_nodeIndex		= -1;
+		int m_firstObject	= 0;
+		int m_numObjects	= 0;
+		int m_depth			= 0;
+	};
+
+	void	BuildNode(std::vector<BVHNode3D>& nodes, int nodeIndex, int firstObject, int numObjects, int depth, std::vector<Vec3> const& objectCentroids, std::vector<DeferredSubtree>* out_deferredSubtrees);
+	void	RefitNode(int nodeIndex);
+
+private:
+	std::vector<AABB3>		m_objectBounds;
+	std::vector<int>		m_objectOrder;
+	std::vector<int>		m_leafIndexForObject;
+	std::vector<BVHNode3D>	m_nodes;
+	bool					m_isBuilt = false;
+};
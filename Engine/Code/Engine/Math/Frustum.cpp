@@ -0,0 +1,200 @@
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+#include <math.h>
+#include <xmmintrin.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Gribb-Hartmann: each plane is a sum or difference of the clip matrix's rows. With 0..1 depth the
+// near plane is just the third row rather than the fourth row plus the third.
+Frustum const Frustum::MakeFromViewProjectionMatrix(Mat44 const& viewProjectionMatrix)
+{
+	float const* values = viewProjectionMatrix.m_values;
+	float rowX[4] = { values[Mat44::Ix], values[Mat44::Jx], values[Mat44::Kx], values[Mat44::Tx] };
+	float rowY[4] = { values[Mat44::Iy], values[Mat44::Jy], values[Mat44::Ky], values[Mat44::Ty] };
+	float rowZ[4] = { values[Mat44::Iz], values[Mat44::Jz], values[Mat44::Kz], values[Mat44::Tz] };
+	float rowW[4] = { values[Mat44::Iw], values[Mat44::Jw], values[Mat44::Kw], values[Mat44::Tw] };
+
+	float planeCoefficients[FRUSTUM_PLANE_COUNT][4];
+	for (int column = 0; column < 4; ++column)
+	{
+		planeCoefficients[FRUSTUM_PLANE_LEFT][column]	= rowW[column] + rowX[column];
+		planeCoefficients[FRUSTUM_PLANE_RIGHT][column]	= rowW[column] - rowX[column];
+		planeCoefficients[FRUSTUM_PLANE_BOTTOM][column]	= rowW[column] + rowY[column];
+		planeCoefficients[FRUSTUM_PLANE_TOP][column]	= rowW[column] - rowY[column];
+		planeCoefficients[FRUSTUM_PLANE_NEAR][column]	= rowZ[column];
+		planeCoefficients[FRUSTUM_PLANE_FAR][column]	= rowW[column] - rowZ[column];
+	}
+
+	// ax + by + cz + d >= 0 inside, so the distance from the origin is -d once normalized
+	Frustum frustum;
+	for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+	{
+		float const* coefficients = planeCoefficients[planeIndex];
+		Vec3 normal = Vec3(coefficients[0], coefficients[1], coefficients[2]);
+		float normalLength = normal.GetLength();
+		float inverseNormalLength = normalLength > 0.f ? 1.f / normalLength : 0.f;
+		frustum.m_planes[planeIndex] = Plane3(normal * inverseNormalLength, -coefficients[3] * inverseNormalLength);
+	}
+
+	return frustum;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Frustum::IsPointInside(Vec3 const& point) const
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+	{
+		if (m_planes[planeIndex].GetAltitudeOfPoint(point) < 0.f)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Frustum::IsSphereOutside(Vec3 const& sphereCenter, float sphereRadius) const
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+	{
+		if (m_planes[planeIndex].GetAltitudeOfPoint(sphereCenter) < -sphereRadius)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Frustum::IsAABBOutside(AABB3 const& box) const
+{
+	return GetAABBOverlap(box) == FrustumOverlap::OUTSIDE;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// For each plane, only the box corner furthest along the normal (and the one furthest against it)
+// matter: if the furthest corner is behind the plane the whole box is, and if the nearest corner is
+// in front of every plane the whole box is inside.
+FrustumOverlap Frustum::GetAABBOverlap(AABB3 const& box) const
+{
+	FrustumOverlap overlap = FrustumOverlap::INSIDE;
+	for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+	{
+		Plane3 const& plane = m_planes[planeIndex];
+		Vec3 const& normal = plane.m_normal;
+
+		float furthestX = normal.x >= 0.f ? box.m_maxs.x : box.m_mins.x;
+		float furthestY = normal.y >= 0.f ? box.m_maxs.y : box.m_mins.y;
+		float furthestZ = normal.z >= 0.f ? box.m_maxs.z : box.m_mins.z;
+		float furthestAltitude = (furthestX * normal.x) + (furthestY * normal.y) + (furthestZ * normal.z) - plane.m_distFromOrigin;
+		if (furthestAltitude < 0.f)
+		{
+			return FrustumOverlap::OUTSIDE;
+		}
+
+		float nearestX = normal.x >= 0.f ? box.m_mins.x : box.m_maxs.x;
+		float nearestY = normal.y >= 0.f ? box.m_mins.y : box.m_maxs.y;
+		float nearestZ = normal.z >= 0.f ? box.m_mins.z : box.m_maxs.z;
+		float nearestAltitude = (nearestX * normal.x) + (nearestY * normal.y) + (nearestZ * normal.z) - plane.m_distFromOrigin;
+		if (nearestAltitude < 0.f)
+		{
+			overlap = FrustumOverlap::INTERSECTING;
+		}
+	}
+
+	return overlap;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CullSpheresVsFrustum(Frustum const& frustum, std::vector<Vec3> const& sphereCenters, std::vector<float> const& sphereRadii, std::vector<unsigned int>& out_visibilityBits)
+{
+	int numSpheres = (int)sphereCenters.size();
+	out_visibilityBits.assign((numSpheres + 31) / 32, 0u);
+
+	for (int firstSphere = 0; firstSphere < numSpheres; firstSphere += 4)
+	{
+		// Unused lanes in the last group are filled with the first sphere and masked off below
+		int sphereIndexes[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			sphereIndexes[lane] = firstSphere + lane < numSpheres ? firstSphere + lane : firstSphere;
+		}
+		Vec3 const& centerA = sphereCenters[sphereIndexes[0]];
+		Vec3 const& centerB = sphereCenters[sphereIndexes[1]];
+		Vec3 const& centerC = sphereCenters[sphereIndexes[2]];
+		Vec3 const& centerD = sphereCenters[sphereIndexes[3]];
+		__m128 centersX = _mm_setr_ps(centerA.x, centerB.x, centerC.x, centerD.x);
+		__m128 centersY = _mm_setr_ps(centerA.y, centerB.y, centerC.y, centerD.y);
+		__m128 centersZ = _mm_setr_ps(centerA.z, centerB.z, centerC.z, centerD.z);
+		__m128 negativeRadii = _mm_setr_ps(-sphereRadii[sphereIndexes[0]], -sphereRadii[sphereIndexes[1]], -sphereRadii[sphereIndexes[2]], -sphereRadii[sphereIndexes[3]]);
+
+		__m128 isOutside = _mm_setzero_ps();
+		for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+		{
+			Plane3 const& plane = frustum.m_planes[planeIndex];
+			__m128 altitudes = _mm_add_ps(_mm_add_ps(_mm_mul_ps(centersX, _mm_set1_ps(plane.m_normal.x)), _mm_mul_ps(centersY, _mm_set1_ps(plane.m_normal.y))), _mm_mul_ps(centersZ, _mm_set1_ps(plane.m_normal.z)));
+			altitudes = _mm_sub_ps(altitudes, _mm_set1_ps(plane.m_distFromOrigin));
+			isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(altitudes, negativeRadii));
+		}
+
+		unsigned int numLanes = numSpheres - firstSphere < 4 ? numSpheres - firstSphere : 4;
+		unsigned int visibleLanes = ~(unsigned int)_mm_movemask_ps(isOutside) & ((1u << numLanes) - 1u);
+		out_visibilityBits[firstSphere >> 5] |= visibleLanes << (firstSphere & 31);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CullAABB3sVsFrustum(Frustum const& frustum, std::vector<AABB3> const& boxes, std::vector<unsigned int>& out_visibilityBits)
+{
+	int numBoxes = (int)boxes.size();
+	out_visibilityBits.assign((numBoxes + 31) / 32, 0u);
+
+	for (int firstBox = 0; firstBox < numBoxes; firstBox += 4)
+	{
+		// Unused lanes in the last group are filled with the first box and masked off below
+		int boxIndexes[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			boxIndexes[lane] = firstBox + lane < numBoxes ? firstBox + lane : firstBox;
+		}
+		AABB3 const& boxA = boxes[boxIndexes[0]];
+		AABB3 const& boxB = boxes[boxIndexes[1]];
+		AABB3 const& boxC = boxes[boxIndexes[2]];
+		AABB3 const& boxD = boxes[boxIndexes[3]];
+		__m128 minsX = _mm_setr_ps(boxA.m_mins.x, boxB.m_mins.x, boxC.m_mins.x, boxD.m_mins.x);
+		__m128 minsY = _mm_setr_ps(boxA.m_mins.y, boxB.m_mins.y, boxC.m_mins.y, boxD.m_mins.y);
+		__m128 minsZ = _mm_setr_ps(boxA.m_mins.z, boxB.m_mins.z, boxC.m_mins.z, boxD.m_mins.z);
+		__m128 maxsX = _mm_setr_ps(boxA.m_maxs.x, boxB.m_maxs.x, boxC.m_maxs.x, boxD.m_maxs.x);
+		__m128 maxsY = _mm_setr_ps(boxA.m_maxs.y, boxB.m_maxs.y, boxC.m_maxs.y, boxD.m_maxs.y);
+		__m128 maxsZ = _mm_setr_ps(boxA.m_maxs.z, boxB.m_maxs.z, boxC.m_maxs.z, boxD.m_maxs.z);
+
+		// A box is outside once its corner furthest along some plane's normal is behind that plane
+		__m128 isOutside = _mm_setzero_ps();
+		for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+		{
+			Plane3 const& plane = frustum.m_planes[planeIndex];
+			Vec3 const& normal = plane.m_normal;
+			__m128 furthestX = normal.x >= 0.f ? maxsX : minsX;
+			__m128 furthestY = normal.y >= 0.f ? maxsY : minsY;
+			__m128 furthestZ = normal.z >= 0.f ? maxsZ : minsZ;
+			__m128 altitudes = _mm_add_ps(_mm_add_ps(_mm_mul_ps(furthestX, _mm_set1_ps(normal.x)), _mm_mul_ps(furthestY, _mm_set1_ps(normal.y))), _mm_mul_ps(furthestZ, _mm_set1_ps(normal.z)));
+			altitudes = _mm_sub_ps(altitudes, _mm_set1_ps(plane.m_distFromOrigin));
+			isOutside = _mm_or_ps(isOutside, _mm_cmplt_ps(altitudes, _mm_setzero_ps()));
+		}
+
+		unsigned int numLanes = numBoxes - firstBox < 4 ? numBoxes - firstBox : 4;
+		unsigned int visibleLanes = ~(unsigned int)_mm_movemask_ps(isOutside) & ((1u << numLanes) - 1u);
+		out_visibilityBits[firstBox >> 5] |= visibleLanes << (firstBox & 31);
+	}
+}
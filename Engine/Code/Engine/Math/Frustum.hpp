@@ -0,0 +1,68 @@
+#pragma once
+#include "Engine/Math/Plane3.hpp"
+
+#include <vector>
+
+struct AABB3;
+struct Mat44;
+
+
+//--------------------------------------------------------------------------------------------------
+enum class FrustumOverlap
+{
+	OUTSIDE,
+	INTERSECTING,
+	INSIDE,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+enum FrustumPlane
+{
+	FRUSTUM_PLANE_LEFT,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+
+	FRUSTUM_PLANE_COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Convex volume bounded by six planes whose normals all point inward; a point is inside when it is
+// not behind any plane. The tests are conservative near the edges and corners, where a box that is
+// outside the frustum but not entirely behind any single plane still counts as intersecting.
+//--------------------------------------------------------------------------------------------------
+struct Frustum
+{
+public:
+	Plane3 m_planes[FRUSTUM_PLANE_COUNT];
+
+public:
+	Frustum() {}
+	~Frustum() {}
+
+	// Planes are normalized; clip space depth is assumed to be D3D style, 0 at the near plane and 1 at the far plane
+	static Frustum const MakeFromViewProjectionMatrix(Mat44 const& viewProjectionMatrix);
+
+	bool			IsPointInside(Vec3 const& point) const;
+	bool			IsSphereOutside(Vec3 const& sphereCenter, float sphereRadius) const;
+	bool			IsAABBOutside(AABB3 const& box) const;
+	FrustumOverlap	GetAABBOverlap(AABB3 const& box) const;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Batch culling, four objects at a time with SSE. Bit N of the output is set when object N is not
+// outside the frustum, with the same results as calling IsSphereOutside() / IsAABBOutside() one by one.
+// Bits are packed 32 to a word; read them back with IsVisibilityBitSet().
+//--------------------------------------------------------------------------------------------------
+void CullSpheresVsFrustum(Frustum const& frustum, std::vector<Vec3> const& sphereCenters, std::vector<float> const& sphereRadii, std::vector<unsigned int>& out_visibilityBits);
+void CullAABB3sVsFrustum(Frustum const& frustum, std::vector<AABB3> const& boxes, std::vector<unsigned int>& out_visibilityBits);
+
+inline bool IsVisibilityBitSet(std::vector<unsigned int> const& visibilityBits, int objectIndex)
+{
+	return (visibilityBits[objectIndex >> 5] & (1u << (objectIndex & 31))) != 0;
+}
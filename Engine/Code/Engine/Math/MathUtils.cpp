@@ -4,6 +4,7 @@
 #include "Engine/Math/Vec2.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 
 #include <math.h>
@@ -548,6 +549,47 @@ bool DoSpheresOverlap(Vec3 const& centerA, float radiusA, Vec3 const& centerB, f
 	return false;
 }
 
+bool DoAABBsOverlap2D(AABB2 const& boxA, AABB2 const& boxB)
+{
+	if (boxA.m_maxs.x < boxB.m_mins.x || boxA.m_mins.x > boxB.m_maxs.x)
+	{
+		return false;
+	}
+
+	if (boxA.m_maxs.y < boxB.m_mins.y || boxA.m_mins.y > boxB.m_maxs.y)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool DoAABBsOverlap3D(AABB3 const& boxA, AABB3 const& boxB)
+{
+	if (boxA.m_maxs.x < boxB.m_mins.x || boxA.m_mins.x > boxB.m_maxs.x)
+	{
+		return false;
+	}
+
+	if (boxA.m_maxs.y < boxB.m_mins.y || boxA.m_mins.y > boxB.m_maxs.y)
+	{
+		return false;
+	}
+
+	if (boxA.m_maxs.z < boxB.m_mins.z || boxA.m_mins.z > boxB.m_maxs.z)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool DoSphereAndAABBOverlap3D(Vec3 const& sphereCenter, float sphereRadius, AABB3 const& box)
+{
+	Vec3 nearestPointOnBox = box.GetNearestPoint(sphereCenter);
+	return GetDistanceSquared3D(nearestPointOnBox, sphereCenter) <= sphereRadius * sphereRadius;
+}
+
 Vec2 GetNearestPointOnDisc2D(Vec2 const& referencePosition, Vec2 const& discCenter, float discRadius)
 {
 	if (IsPointInsideDisc2D(referencePosition, discCenter, discRadius))
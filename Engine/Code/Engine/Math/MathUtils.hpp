@@ -9,6 +9,7 @@ struct Rgba8;
 struct Vec3;
 struct IntVec2;
 struct Mat44;
+struct AABB3;
 
 enum class BillboardType
 {
@@ -74,6 +75,9 @@ bool IsPointInsideDirectedSector2D(Vec2 const& point, Vec2 const& sectorTip, Vec
 
 bool DoDiscsOverlap(Vec2 const& centerA, float radiusA, Vec2 const& centerB, float radiusB);
 bool DoSpheresOverlap(Vec3 const& centerA, float radiusA, Vec3 const& centerB, float radiusB);
+bool DoAABBsOverlap2D(AABB2 const& boxA, AABB2 const& boxB);
+bool DoAABBsOverlap3D(AABB3 const& boxA, AABB3 const& boxB);
+bool DoSphereAndAABBOverlap3D(Vec3 const& sphereCenter, float sphereRadius, AABB3 const& box);
 
 Vec2 GetNearestPointOnDisc2D(Vec2 const& referencePosition, Vec2 const& discCenter, float discRadius);
 Vec2 const GetNearestPointOnAABB2D(Vec2 const& referencePos, AABB2 const& box);
@@ -1,21 +1,33 @@
 #include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/MathUtils.hpp"
 
 void OBB2::GetCornerPoints(Vec2* out_fourCornerWorldPositions) const
 {
-	(void)out_fourCornerWorldPositions;
+	Vec2 jBasisNormal = m_iBasisNormal.GetRotated90Degrees();
+	Vec2 halfWidthAlongiBasis = m_iBasisNormal * m_halfDimensions.x;
+	Vec2 halfHeightAlongjBasis = jBasisNormal * m_halfDimensions.y;
+
+	// Counter-clockwise, starting at the local bottom left
+	out_fourCornerWorldPositions[0] = m_center - halfWidthAlongiBasis - halfHeightAlongjBasis;
+	out_fourCornerWorldPositions[1] = m_center + halfWidthAlongiBasis - halfHeightAlongjBasis;
+	out_fourCornerWorldPositions[2] = m_center + halfWidthAlongiBasis + halfHeightAlongjBasis;
+	out_fourCornerWorldPositions[3] = m_center - halfWidthAlongiBasis + halfHeightAlongjBasis;
 }
 
 Vec2 OBB2::GetLocalPosForWorldPos(Vec2 worldPos) const
 {
-	return Vec2();
+	Vec2 jBasisNormal = m_iBasisNormal.GetRotated90Degrees();
+	Vec2 dispFromCenterToWorldPos = worldPos - m_center;
+	return Vec2(DotProduct2D(dispFromCenterToWorldPos, m_iBasisNormal), DotProduct2D(dispFromCenterToWorldPos, jBasisNormal));
 }
 
 Vec2 OBB2::GetWorldPosForLocalPos(Vec2 localPos) const
 {
-	return Vec2();
+	Vec2 jBasisNormal = m_iBasisNormal.GetRotated90Degrees();
+	return m_center + (m_iBasisNormal * localPos.x) + (jBasisNormal * localPos.y);
 }
 
 void OBB2::RotateAboutCenter(float rotationDeltaDegrees)
 {
-	(void)rotationDeltaDegrees;
+	m_iBasisNormal.RotateDegrees(rotationDeltaDegrees);
 }
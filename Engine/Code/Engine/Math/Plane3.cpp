@@ -0,0 +1,39 @@
+#include "Engine/Math/Plane3.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+Plane3::Plane3(Vec3 const& normal, float distFromOrigin) :
+	m_normal(normal),
+	m_distFromOrigin(distFromOrigin)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Plane3::Plane3(Vec3 const& normal, Vec3 const& pointOnPlane) :
+	m_normal(normal),
+	m_distFromOrigin(DotProduct3D(normal, pointOnPlane))
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float Plane3::GetAltitudeOfPoint(Vec3 const& point) const
+{
+	return DotProduct3D(point, m_normal) - m_distFromOrigin;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Plane3::IsPointInFront(Vec3 const& point) const
+{
+	return GetAltitudeOfPoint(point) > 0.f;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vec3 const Plane3::GetNearestPoint(Vec3 const& referencePosition) const
+{
+	return referencePosition - (m_normal * GetAltitudeOfPoint(referencePosition));
+}
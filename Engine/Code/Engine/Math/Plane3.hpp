@@ -0,0 +1,24 @@
+#pragma once
+#include "Engine/Math/Vec3.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+// Plane of all points P where DotProduct3D(P, m_normal) == m_distFromOrigin; points in front of the
+// plane (the side the normal points to) have positive altitude.
+//--------------------------------------------------------------------------------------------------
+struct Plane3
+{
+public:
+	Vec3	m_normal = Vec3(0.f, 0.f, 1.f);
+	float	m_distFromOrigin = 0.f;
+
+public:
+	Plane3() {}
+	~Plane3() {}
+	explicit Plane3(Vec3 const& normal, float distFromOrigin);
+	explicit Plane3(Vec3 const& normal, Vec3 const& pointOnPlane);
+
+	float		GetAltitudeOfPoint(Vec3 const& point) const;
+	bool		IsPointInFront(Vec3 const& point) const;
+	Vec3 const	GetNearestPoint(Vec3 const& referencePosition) const;
+};
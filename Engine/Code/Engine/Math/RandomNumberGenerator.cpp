@@ -4,6 +4,15 @@
 //--------------------------------------------------------------------------------------------------
 constexpr unsigned int MAX_RANDOM_UINT = 0xFF'FF'FF'FF;
 constexpr double ONE_OVER_MAX_RANDOM_UINT = 1.0 / double(MAX_RANDOM_UINT);
+constexpr int RANDOM_FILL_BATCH_SIZE = 256;
+
+
+//--------------------------------------------------------------------------------------------------
+RandomNumberGenerator::RandomNumberGenerator(unsigned int seed, int streamID)
+	: m_seed(seed)
+	, m_streamID(streamID)
+{
+}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -13,11 +22,49 @@ void RandomNumberGenerator::SetSeed(unsigned int newSeed)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::SetStream(int streamID)
+{
+	m_streamID = streamID;
+	m_position = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::SetPosition(int position)
+{
+	m_position = position;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::JumpAhead(int numRolls)
+{
+	m_position = int((unsigned int)m_position + (unsigned int)numRolls);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RandomNumberGenerator RandomNumberGenerator::GetStream(int streamID) const
+{
+	return RandomNumberGenerator(m_seed, streamID);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned int RandomNumberGenerator::RollRandomUint()
+{
+	unsigned int randomUInt = Get1dNoiseUint(m_position, GetStreamSeed());
+	JumpAhead(1);
+	return randomUInt;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 int RandomNumberGenerator::RollRandomIntLessThan(int maxNotInclusive)
 {
 	// return rand() % maxNotInclusive;
-	unsigned int randomUInt = Get1dNoiseUint(m_position++, m_seed);
+	unsigned int randomUInt = RollRandomUint();
 	return randomUInt % maxNotInclusive;
 }
 
@@ -25,7 +72,7 @@ int RandomNumberGenerator::RollRandomIntLessThan(int maxNotInclusive)
 //--------------------------------------------------------------------------------------------------
 int RandomNumberGenerator::RollRandomIntInRange(int minInclusive, int maxInclusive)
 {
-	unsigned int randomUInt = Get1dNoiseUint(m_position++, m_seed);
+	unsigned int randomUInt = RollRandomUint();
 	int range = 1 + maxInclusive - minInclusive;
 	return minInclusive + (randomUInt % range);
 	// return ((randomUInt % (maxExclusive - minExclusive + 1)) + minExclusive);
@@ -35,7 +82,7 @@ int RandomNumberGenerator::RollRandomIntInRange(int minInclusive, int maxInclusi
 //--------------------------------------------------------------------------------------------------
 float RandomNumberGenerator::RollRandomFloatZeroToOne()
 {
-	unsigned int randomUInt = Get1dNoiseUint(m_position++, m_seed);
+	unsigned int randomUInt = RollRandomUint();
 	return float((double)randomUInt * ONE_OVER_MAX_RANDOM_UINT);
 }
 
@@ -48,3 +95,66 @@ float RandomNumberGenerator::RollRandomFloatInRange(float minInclusive, float ma
 	float range = maxInclusive - minInclusive;
 	return minInclusive + (RollRandomFloatZeroToOne() * range);
 }
+
+
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomUints(unsigned int* out_values, int numValues)
+{
+	Get1dNoiseUints(out_values, m_position, numValues, GetStreamSeed());
+	JumpAhead(numValues);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomIntsInRange(int* out_values, int numValues, int minInclusive, int maxInclusive)
+{
+	int range = 1 + maxInclusive - minInclusive;
+	unsigned int randomUInts[RANDOM_FILL_BATCH_SIZE];
+	for (int batchStart = 0; batchStart < numValues; batchStart += RANDOM_FILL_BATCH_SIZE)
+	{
+		int batchSize = numValues - batchStart < RANDOM_FILL_BATCH_SIZE ? numValues - batchStart : RANDOM_FILL_BATCH_SIZE;
+		FillRandomUints(randomUInts, batchSize);
+		for (int index = 0; index < batchSize; ++index)
+		{
+			out_values[batchStart + index] = minInclusive + (randomUInts[index] % range);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomFloatsZeroToOne(float* out_values, int numValues)
+{
+	FillRandomFloatsInRange(out_values, numValues, 0.f, 1.f);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RandomNumberGenerator::FillRandomFloatsInRange(float* out_values, int numValues, float minInclusive, float maxInclusive)
+{
+	float range = maxInclusive - minInclusive;
+	unsigned int randomUInts[RANDOM_FILL_BATCH_SIZE];
+	for (int batchStart = 0; batchStart < numValues; batchStart += RANDOM_FILL_BATCH_SIZE)
+	{
+		int batchSize = numValues - batchStart < RANDOM_FILL_BATCH_SIZE ? numValues - batchStart : RANDOM_FILL_BATCH_SIZE;
+		FillRandomUints(randomUInts, batchSize);
+		for (int index = 0; index < batchSize; ++index)
+		{
+			float zeroToOne = float((double)randomUInts[index] * ONE_OVER_MAX_RANDOM_UINT);
+			out_values[batchStart + index] = minInclusive + (zeroToOne * range);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Each stream hashes its ID into its own seed, so streams are unrelated sequences rather than
+// shifted copies of one. Stream 0 keeps the plain seed.
+unsigned int RandomNumberGenerator::GetStreamSeed() const
+{
+	if (m_streamID == 0)
+	{
+		return m_seed;
+	}
+	return Get1dNoiseUint(m_streamID, m_seed);
+}
@@ -1,17 +1,40 @@
 #pragma once
 
+//--------------------------------------------------------------------------------------------------
+// Counter-based: roll N of stream S is Get1dNoiseUint(N, streamSeed), where stream S's seed is
+// Get1dNoiseUint(S, seed), so any roll can be reached directly. Give each job or thread its own
+// stream (e.g. GetStream(jobIndex)) and results no longer depend on which worker ran what, or in
+// which order. Stream 0 uses the seed itself and is the original single-stream sequence.
+//--------------------------------------------------------------------------------------------------
 class RandomNumberGenerator
 {
 public:
+	RandomNumberGenerator() {}
+	explicit RandomNumberGenerator(unsigned int seed, int streamID = 0);
 
 	void SetSeed(unsigned int newSeed);
+	void SetStream(int streamID);
+	void SetPosition(int position);
+	void JumpAhead(int numRolls);
+	RandomNumberGenerator GetStream(int streamID) const;
 
+	unsigned int RollRandomUint();
 	int RollRandomIntLessThan(int maxNotInclusive);
 	int RollRandomIntInRange(int minExclusive, int maxExclusive);
 	float RollRandomFloatZeroToOne();
 	float RollRandomFloatInRange(float minInclusive, float maxInclusive);
 
+	// Bulk rolls; each gives the same values as calling its single-roll version numValues times
+	void FillRandomUints(unsigned int* out_values, int numValues);
+	void FillRandomIntsInRange(int* out_values, int numValues, int minInclusive, int maxInclusive);
+	void FillRandomFloatsZeroToOne(float* out_values, int numValues);
+	void FillRandomFloatsInRange(float* out_values, int numValues, float minInclusive, float maxInclusive);
+
+private:
+	unsigned int GetStreamSeed() const;
+
 public:
 	unsigned int	m_seed = 0;
 	int				m_position = 0;
-};
\ No newline at end of file
+	int				m_streamID = 0;
+};
@@ -2,8 +2,14 @@
 #include "Engine/Math/FloatRange.hpp"
 #include "RaycastUtils.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Core/JobSystem.hpp"
 
 #include <math.h>
+#include <float.h>
+#include <xmmintrin.h>
 
 //--------------------------------------------------------------------------------------------------
 
@@ -121,6 +127,71 @@ RaycastResult2D RaycastVsAABB2D(Vec2 const& startPos, Vec2 const& fwdNormal, flo
 
 //--------------------------------------------------------------------------------------------------
 
+RaycastResult2D RaycastVsOBB2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, OBB2 const& orientedBox)
+{
+	// Raycast in the box's local space against an AABB2, then bring the result back into world space
+	Vec2 jBasisNormal = orientedBox.m_iBasisNormal.GetRotated90Degrees();
+	Vec2 localStartPos = orientedBox.GetLocalPosForWorldPos(startPos);
+	Vec2 localFwdNormal = Vec2(DotProduct2D(fwdNormal, orientedBox.m_iBasisNormal), DotProduct2D(fwdNormal, jBasisNormal));
+	AABB2 localBounds = AABB2(-orientedBox.m_halfDimensions, orientedBox.m_halfDimensions);
+
+	RaycastResult2D raycastResult2D = RaycastVsAABB2D(localStartPos, localFwdNormal, maxDist, localBounds);
+	if (!raycastResult2D.m_didImpact)
+	{
+		return raycastResult2D;
+	}
+
+	raycastResult2D.m_impactPos = orientedBox.GetWorldPosForLocalPos(raycastResult2D.m_impactPos);
+	Vec2 const& localImpactNormal = raycastResult2D.m_impactNormal;
+	raycastResult2D.m_impactNormal = (orientedBox.m_iBasisNormal * localImpactNormal.x) + (jBasisNormal * localImpactNormal.y);
+
+	return raycastResult2D;
+}
+
+//--------------------------------------------------------------------------------------------------
+
+RaycastResult2D RaycastVsCapsule2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, Vec2 const& boneStart, Vec2 const& boneEnd, float radius)
+{
+	RaycastResult2D raycastResult2D;
+
+	if (IsPointInsideCapsule2D(startPos, boneStart, boneEnd, radius))
+	{
+		raycastResult2D.m_didImpact = true;
+		raycastResult2D.m_impactDist = 0.f;
+		raycastResult2D.m_impactNormal = -fwdNormal;
+		raycastResult2D.m_impactPos = startPos;
+
+		return raycastResult2D;
+	}
+
+	// The capsule's outline is two end caps and two sides parallel to the bone; the nearest of their impacts wins
+	RaycastResult2D candidates[4];
+	int numCandidates = 0;
+	candidates[numCandidates++] = RaycastVsDisc2D(startPos, fwdNormal, maxDist, boneStart, radius);
+	candidates[numCandidates++] = RaycastVsDisc2D(startPos, fwdNormal, maxDist, boneEnd, radius);
+
+	Vec2 dispFromBoneStartToEnd = boneEnd - boneStart;
+	if (dispFromBoneStartToEnd.GetLengthSquared() > 0.f)
+	{
+		Vec2 sideOffset = dispFromBoneStartToEnd.GetRotated90Degrees().GetNormalized() * radius;
+		candidates[numCandidates++] = RaycastVsLineSegment2D(startPos, fwdNormal, maxDist, boneStart + sideOffset, boneEnd + sideOffset);
+		candidates[numCandidates++] = RaycastVsLineSegment2D(startPos, fwdNormal, maxDist, boneStart - sideOffset, boneEnd - sideOffset);
+	}
+
+	for (int candidateIndex = 0; candidateIndex < numCandidates; ++candidateIndex)
+	{
+		RaycastResult2D const& candidate = candidates[candidateIndex];
+		if (candidate.m_didImpact && (!raycastResult2D.m_didImpact || candidate.m_impactDist < raycastResult2D.m_impactDist))
+		{
+			raycastResult2D = candidate;
+		}
+	}
+
+	return raycastResult2D;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 RaycastResult2D RaycastVsLineSegment2D(Vec2 const& rayStartPos, Vec2 const& fwdNormal, float maxDist, Vec2 const& lineSegmentStartPos, Vec2 const& lineSegmentEndPos)
 {
 	RaycastResult2D raycastResult2D;
@@ -252,3 +323,767 @@ RaycastResult3D RaycastVsCylinderZ3D(Vec3 const& rayStart, Vec3 const& fwdNormal
 
 	return raycastResult3D;
 }
+
+
+//--------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsAABB3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3 const& bounds)
+{
+	RaycastResult3D raycastResult3D;
+
+	if (bounds.IsPointInside(startPos))
+	{
+		raycastResult3D.m_didImpact = true;
+		raycastResult3D.m_impactDist = 0.f;
+		raycastResult3D.m_impactNormal = -fwdNormal;
+		raycastResult3D.m_impactPos = startPos;
+
+		return raycastResult3D;
+	}
+
+	float start[3]		= { startPos.x, startPos.y, startPos.z };
+	float fwd[3]		= { fwdNormal.x, fwdNormal.y, fwdNormal.z };
+	float boundMins[3]	= { bounds.m_mins.x, bounds.m_mins.y, bounds.m_mins.z };
+	float boundMaxs[3]	= { bounds.m_maxs.x, bounds.m_maxs.y, bounds.m_maxs.z };
+
+	float enterDist = -FLT_MAX;
+	float exitDist = FLT_MAX;
+	int enterAxis = -1;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		// Ray is parallel to this slab, so it either always or never overlaps it
+		if (fwd[axis] == 0.f)
+		{
+			if (start[axis] < boundMins[axis] || start[axis] > boundMaxs[axis])
+			{
+				return raycastResult3D;
+			}
+			continue;
+		}
+
+		float inverseFwd = 1.f / fwd[axis];
+		float slabEnterDist = (boundMins[axis] - start[axis]) * inverseFwd;
+		float slabExitDist = (boundMaxs[axis] - start[axis]) * inverseFwd;
+		if (slabEnterDist > slabExitDist)
+		{
+			SwapFloatValues(slabEnterDist, slabExitDist);
+		}
+		if (slabEnterDist > enterDist)
+		{
+			enterDist = slabEnterDist;
+			enterAxis = axis;
+		}
+		exitDist = slabExitDist < exitDist ? slabExitDist : exitDist;
+	}
+
+	if (enterAxis < 0 || enterDist > exitDist || enterDist > maxDist || enterDist < 0.f)
+	{
+		return raycastResult3D;
+	}
+
+	float impactNormal[3] = { 0.f, 0.f, 0.f };
+	impactNormal[enterAxis] = fwd[enterAxis] > 0.f ? -1.f : 1.f;
+	raycastResult3D.m_didImpact = true;
+	raycastResult3D.m_impactDist = enterDist;
+	raycastResult3D.m_impactNormal = Vec3(impactNormal[0], impactNormal[1], impactNormal[2]);
+	raycastResult3D.m_impactPos = startPos + (fwdNormal * enterDist);
+
+	return raycastResult3D;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RaycastResult3D RaycastVsSphere3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Vec3 const& sphereCenter, float sphereRadius)
+{
+	RaycastResult3D raycastResult3D;
+
+	Vec3 dispFromStartToSphereCen = sphereCenter - startPos;
+	float sphereRadiusSquared = sphereRadius * sphereRadius;
+
+	// raycast starts inside the sphere
+	if (dispFromStartToSphereCen.GetLengthSquared() < sphereRadiusSquared)
+	{
+		raycastResult3D.m_didImpact = true;
+		raycastResult3D.m_impactDist = 0.f;
+		raycastResult3D.m_impactNormal = -fwdNormal;
+		raycastResult3D.m_impactPos = startPos;
+
+		return raycastResult3D;
+	}
+
+	// raycast points away from the sphere or stops before reaching it
+	float projectionOfDispAlongFwd = DotProduct3D(dispFromStartToSphereCen, fwdNormal);
+	if (projectionOfDispAlongFwd <= 0.f || projectionOfDispAlongFwd >= (maxDist + sphereRadius))
+	{
+		return raycastResult3D;
+	}
+
+	// raycast misses the sphere or is a tangent
+	float perpendicularDistSquared = dispFromStartToSphereCen.GetLengthSquared() - (projectionOfDispAlongFwd * projectionOfDispAlongFwd);
+	float halfChordLengthSquared = sphereRadiusSquared - perpendicularDistSquared;
+	if (halfChordLengthSquared <= 0.f)
+	{
+		return raycastResult3D;
+	}
+
+	float impactDist = projectionOfDispAlongFwd - sqrtf(halfChordLengthSquared);
+	if (impactDist >= maxDist || impactDist < 0.f)
+	{
+		return raycastResult3D;
+	}
+
+	raycastResult3D.m_didImpact = true;
+	raycastResult3D.m_impactDist = impactDist;
+	raycastResult3D.m_impactPos = startPos + (fwdNormal * impactDist);
+	raycastResult3D.m_impactNormal = (raycastResult3D.m_impactPos - sphereCenter).GetNormalized();
+
+	return raycastResult3D;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacket2D::AddRay(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist)
+{
+	m_startPositions.push_back(startPos);
+	m_fwdNormals.push_back(fwdNormal);
+	m_maxDists.push_back(maxDist);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int RaycastPacket2D::GetNumRays() const
+{
+	return (int)m_startPositions.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacket2D::Clear()
+{
+	m_startPositions.clear();
+	m_fwdNormals.clear();
+	m_maxDists.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacket3D::AddRay(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist)
+{
+	m_startPositions.push_back(startPos);
+	m_fwdNormals.push_back(fwdNormal);
+	m_maxDists.push_back(maxDist);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int RaycastPacket3D::GetNumRays() const
+{
+	return (int)m_startPositions.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacket3D::Clear()
+{
+	m_startPositions.clear();
+	m_fwdNormals.clear();
+	m_maxDists.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Relative slack added to every SIMD rejection test, so float rounding can only ever let extra shapes
+// through to the scalar test and never drop a shape the scalar test would have hit
+constexpr float PACKET_FILTER_TOLERANCE = 1e-5f;
+constexpr float PACKET_FILTER_INFINITE_INVERSE = 1e30f;
+
+
+//--------------------------------------------------------------------------------------------------
+static inline __m128 AbsSIMD(__m128 values)
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.f), values);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Splits four consecutive Vec2s into their x and y lanes
+static inline void LoadFourVec2s(Vec2 const* firstVec2, __m128& out_xs, __m128& out_ys)
+{
+	float const* floats = &firstVec2->x;
+	__m128 firstPair = _mm_loadu_ps(floats);
+	__m128 secondPair = _mm_loadu_ps(floats + 4);
+	out_xs = _mm_shuffle_ps(firstPair, secondPair, _MM_SHUFFLE(2, 0, 2, 0));
+	out_ys = _mm_shuffle_ps(firstPair, secondPair, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Splits four consecutive FloatRanges into their min and max lanes
+static inline void LoadFourFloatRanges(FloatRange const* firstRange, __m128& out_mins, __m128& out_maxs)
+{
+	out_mins = _mm_setr_ps(firstRange[0].m_min, firstRange[1].m_min, firstRange[2].m_min, firstRange[3].m_min);
+	out_maxs = _mm_setr_ps(firstRange[0].m_max, firstRange[1].m_max, firstRange[2].m_max, firstRange[3].m_max);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static inline float GetPacketFilterInverse(float fwdComponent)
+{
+	if (fwdComponent == 0.f)
+	{
+		return PACKET_FILTER_INFINITE_INVERSE;
+	}
+	return 1.f / fwdComponent;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Shared loop for every packet function. filterFourShapes(rayIndex, firstShapeIndex, pruneDist) returns a
+// 4-bit mask of the shapes that might be hit closer than pruneDist; raycastVsShape(rayIndex, shapeIndex)
+// runs the scalar test. Shapes left over after the last group of four go straight to the scalar test.
+template<typename T_RaycastResult, typename T_FilterFourShapes, typename T_RaycastVsShape>
+static void RaycastPacketVsShapes(int numRays, float const* rayMaxDists, int numShapes, T_FilterFourShapes filterFourShapes, T_RaycastVsShape raycastVsShape,
+	std::vector<T_RaycastResult>& out_results, std::vector<int>* out_hitShapeIndexes, bool anyHit)
+{
+	out_results.clear();
+	out_results.resize(numRays);
+	if (out_hitShapeIndexes)
+	{
+		out_hitShapeIndexes->assign(numRays, -1);
+	}
+
+	int numShapesInGroupsOfFour = numShapes & ~3;
+	for (int rayIndex = 0; rayIndex < numRays; ++rayIndex)
+	{
+		T_RaycastResult& nearestResult = out_results[rayIndex];
+		int nearestShapeIndex = -1;
+		float pruneDist = rayMaxDists ? rayMaxDists[rayIndex] : FLT_MAX;
+		bool isDone = false;
+
+		for (int firstShapeIndex = 0; firstShapeIndex < numShapes && !isDone; firstShapeIndex += 4)
+		{
+			int candidateMask = firstShapeIndex < numShapesInGroupsOfFour ? filterFourShapes(rayIndex, firstShapeIndex, pruneDist) : (1 << (numShapes - firstShapeIndex)) - 1;
+			for (int lane = 0; lane < 4 && candidateMask != 0; ++lane, candidateMask >>= 1)
+			{
+				if ((candidateMask & 1) == 0)
+				{
+					continue;
+				}
+
+				int shapeIndex = firstShapeIndex + lane;
+				T_RaycastResult result = raycastVsShape(rayIndex, shapeIndex);
+				bool isNearest = result.m_didImpact && (nearestShapeIndex < 0 || result.m_impactDist < nearestResult.m_impactDist);
+				if (!isNearest)
+				{
+					continue;
+				}
+
+				nearestResult = result;
+				nearestShapeIndex = shapeIndex;
+				pruneDist = result.m_impactDist;
+				if (anyHit)
+				{
+					isDone = true;
+					break;
+				}
+			}
+		}
+
+		if (out_hitShapeIndexes)
+		{
+			(*out_hitShapeIndexes)[rayIndex] = nearestShapeIndex;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacketVsDiscs2D(RaycastPacket2D const& rays, std::vector<Vec2> const& discCenters, std::vector<float> const& discRadii, std::vector<RaycastResult2D>& out_results, std::vector<int>* out_hitShapeIndexes, bool anyHit)
+{
+	auto FilterFourDiscs = [&](int rayIndex, int firstDiscIndex, float pruneDist) -> int
+	{
+		Vec2 const& startPos = rays.m_startPositions[rayIndex];
+		Vec2 const& fwdNormal = rays.m_fwdNormals[rayIndex];
+		__m128 centerXs;
+		__m128 centerYs;
+		LoadFourVec2s(&discCenters[firstDiscIndex], centerXs, centerYs);
+		__m128 radii = _mm_loadu_ps(&discRadii[firstDiscIndex]);
+
+		// Same math as the scalar version: distance from the disc center along and across the ray
+		__m128 dispXs = _mm_sub_ps(centerXs, _mm_set1_ps(startPos.x));
+		__m128 dispYs = _mm_sub_ps(centerYs, _mm_set1_ps(startPos.y));
+		__m128 alongRay = _mm_add_ps(_mm_mul_ps(dispXs, _mm_set1_ps(fwdNormal.x)), _mm_mul_ps(dispYs, _mm_set1_ps(fwdNormal.y)));
+		__m128 acrossRay = _mm_add_ps(_mm_mul_ps(dispXs, _mm_set1_ps(-fwdNormal.y)), _mm_mul_ps(dispYs, _mm_set1_ps(fwdNormal.x)));
+
+		__m128 tolerance = _mm_mul_ps(_mm_add_ps(_mm_add_ps(AbsSIMD(dispXs), AbsSIMD(dispYs)), _mm_add_ps(radii, _mm_set1_ps(1.f))), _mm_set1_ps(PACKET_FILTER_TOLERANCE));
+		__m128 paddedRadii = _mm_add_ps(radii, tolerance);
+		__m128 isCloseToRay = _mm_cmple_ps(AbsSIMD(acrossRay), paddedRadii);
+		__m128 isNotBehind = _mm_cmpgt_ps(alongRay, _mm_sub_ps(_mm_setzero_ps(), paddedRadii));
+		__m128 isNotBeyond = _mm_cmplt_ps(alongRay, _mm_add_ps(_mm_set1_ps(pruneDist), paddedRadii));
+		return _mm_movemask_ps(_mm_and_ps(isCloseToRay, _mm_and_ps(isNotBehind, isNotBeyond)));
+	};
+
+	auto RaycastVsDisc = [&](int rayIndex, int discIndex) -> RaycastResult2D
+	{
+		return RaycastVsDisc2D(rays.m_startPositions[rayIndex], rays.m_fwdNormals[rayIndex], rays.m_maxDists[rayIndex], discCenters[discIndex], discRadii[discIndex]);
+	};
+
+	RaycastPacketVsShapes(rays.GetNumRays(), rays.m_maxDists.data(), (int)discCenters.size(), FilterFourDiscs, RaycastVsDisc, out_results, out_hitShapeIndexes, anyHit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacketVsLineSegments2D(RaycastPacket2D const& rays, std::vector<Vec2> const& lineSegmentStartPositions, std::vector<Vec2> const& lineSegmentEndPositions, std::vector<RaycastResult2D>& out_results, std::vector<int>* out_hitShapeIndexes, bool anyHit)
+{
+	auto FilterFourLineSegments = [&](int rayIndex, int firstLineSegmentIndex, float pruneDist) -> int
+	{
+		Vec2 const& startPos = rays.m_startPositions[rayIndex];
+		Vec2 const& fwdNormal = rays.m_fwdNormals[rayIndex];
+		__m128 segStartXs;
+		__m128 segStartYs;
+		__m128 segEndXs;
+		__m128 segEndYs;
+		LoadFourVec2s(&lineSegmentStartPositions[firstLineSegmentIndex], segStartXs, segStartYs);
+		LoadFourVec2s(&lineSegmentEndPositions[firstLineSegmentIndex], segEndXs, segEndYs);
+
+		__m128 fwdXs = _mm_set1_ps(fwdNormal.x);
+		__m128 fwdYs = _mm_set1_ps(fwdNormal.y);
+		__m128 negativeFwdYs = _mm_set1_ps(-fwdNormal.y);
+		__m128 dispToStartXs = _mm_sub_ps(segStartXs, _mm_set1_ps(startPos.x));
+		__m128 dispToStartYs = _mm_sub_ps(segStartYs, _mm_set1_ps(startPos.y));
+		__m128 dispToEndXs = _mm_sub_ps(segEndXs, _mm_set1_ps(startPos.x));
+		__m128 dispToEndYs = _mm_sub_ps(segEndYs, _mm_set1_ps(startPos.y));
+
+		__m128 startAcrossRay = _mm_add_ps(_mm_mul_ps(dispToStartXs, negativeFwdYs), _mm_mul_ps(dispToStartYs, fwdXs));
+		__m128 endAcrossRay = _mm_add_ps(_mm_mul_ps(dispToEndXs, negativeFwdYs), _mm_mul_ps(dispToEndYs, fwdXs));
+		__m128 startAlongRay = _mm_add_ps(_mm_mul_ps(dispToStartXs, fwdXs), _mm_mul_ps(dispToStartYs, fwdYs));
+		__m128 endAlongRay = _mm_add_ps(_mm_mul_ps(dispToEndXs, fwdXs), _mm_mul_ps(dispToEndYs, fwdYs));
+
+		__m128 sumOfAbsDisps = _mm_add_ps(_mm_add_ps(AbsSIMD(dispToStartXs), AbsSIMD(dispToStartYs)), _mm_add_ps(AbsSIMD(dispToEndXs), AbsSIMD(dispToEndYs)));
+		__m128 tolerance = _mm_mul_ps(_mm_add_ps(sumOfAbsDisps, _mm_set1_ps(1.f)), _mm_set1_ps(PACKET_FILTER_TOLERANCE));
+		__m128 negativeTolerance = _mm_sub_ps(_mm_setzero_ps(), tolerance);
+
+		// Both ends clearly on the same side of the ray means no straddle
+		__m128 isBothLeft = _mm_and_ps(_mm_cmpgt_ps(startAcrossRay, tolerance), _mm_cmpgt_ps(endAcrossRay, tolerance));
+		__m128 isBothRight = _mm_and_ps(_mm_cmplt_ps(startAcrossRay, negativeTolerance), _mm_cmplt_ps(endAcrossRay, negativeTolerance));
+		__m128 isStraddling = _mm_andnot_ps(_mm_or_ps(isBothLeft, isBothRight), _mm_castsi128_ps(_mm_set1_epi32(-1)));
+
+		// The impact lies between the two ends, so its distance along the ray does too
+		__m128 isNotBehind = _mm_cmpge_ps(_mm_max_ps(startAlongRay, endAlongRay), negativeTolerance);
+		__m128 isNotBeyond = _mm_cmple_ps(_mm_min_ps(startAlongRay, endAlongRay), _mm_add_ps(_mm_set1_ps(pruneDist), tolerance));
+		return _mm_movemask_ps(_mm_and_ps(isStraddling, _mm_and_ps(isNotBehind, isNotBeyond)));
+	};
+
+	auto RaycastVsLineSegment = [&](int rayIndex, int lineSegmentIndex) -> RaycastResult2D
+	{
+		return RaycastVsLineSegment2D(rays.m_startPositions[rayIndex], rays.m_fwdNormals[rayIndex], rays.m_maxDists[rayIndex], lineSegmentStartPositions[lineSegmentIndex], lineSegmentEndPositions[lineSegmentIndex]);
+	};
+
+	RaycastPacketVsShapes(rays.GetNumRays(), rays.m_maxDists.data(), (int)lineSegmentStartPositions.size(), FilterFourLineSegments, RaycastVsLineSegment, out_results, out_hitShapeIndexes, anyHit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Slab test of one ray against four boxes; the boxes are padded so rounding can only make the test more generous
+static inline int FilterFourBoxesAlongRay(__m128 minXs, __m128 minYs, __m128 maxXs, __m128 maxYs, Vec2 const& startPos, Vec2 const& fwdNormal, float pruneDist)
+{
+	float rayTolerance = (fabsf(startPos.x) + fabsf(startPos.y) + 1.f) * PACKET_FILTER_TOLERANCE;
+	__m128 boxTolerances = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(AbsSIMD(minXs), AbsSIMD(maxXs)), _mm_add_ps(AbsSIMD(minYs), AbsSIMD(maxYs))), _mm_set1_ps(PACKET_FILTER_TOLERANCE)), _mm_set1_ps(rayTolerance));
+
+	__m128 startXs = _mm_set1_ps(startPos.x);
+	__m128 startYs = _mm_set1_ps(startPos.y);
+	__m128 inverseFwdXs = _mm_set1_ps(GetPacketFilterInverse(fwdNormal.x));
+	__m128 inverseFwdYs = _mm_set1_ps(GetPacketFilterInverse(fwdNormal.y));
+
+	__m128 slabXDistA = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(minXs, boxTolerances), startXs), inverseFwdXs);
+	__m128 slabXDistB = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(maxXs, boxTolerances), startXs), inverseFwdXs);
+	__m128 slabYDistA = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(minYs, boxTolerances), startYs), inverseFwdYs);
+	__m128 slabYDistB = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(maxYs, boxTolerances), startYs), inverseFwdYs);
+
+	__m128 enterDists = _mm_max_ps(_mm_min_ps(slabXDistA, slabXDistB), _mm_min_ps(slabYDistA, slabYDistB));
+	__m128 exitDists = _mm_min_ps(_mm_max_ps(slabXDistA, slabXDistB), _mm_max_ps(slabYDistA, slabYDistB));
+
+	__m128 distTolerance = _mm_set1_ps((pruneDist < FLT_MAX ? pruneDist : 0.f) * PACKET_FILTER_TOLERANCE + rayTolerance);
+	__m128 isOverlapping = _mm_cmple_ps(enterDists, exitDists);
+	__m128 isNotBehind = _mm_cmpge_ps(exitDists, _mm_sub_ps(_mm_setzero_ps(), distTolerance));
+	__m128 isNotBeyond = _mm_cmple_ps(enterDists, _mm_add_ps(_mm_set1_ps(pruneDist), distTolerance));
+	return _mm_movemask_ps(_mm_and_ps(isOverlapping, _mm_and_ps(isNotBehind, isNotBeyond)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacketVsAABBs2D(RaycastPacket2D const& rays, std::vector<AABB2> const& boxes, std::vector<RaycastResult2D>& out_results, std::vector<int>* out_hitShapeIndexes, bool anyHit)
+{
+	auto FilterFourAABBs = [&](int rayIndex, int firstBoxIndex, float pruneDist) -> int
+	{
+		// Each AABB2 is one row of (minX, minY, maxX, maxY); transposing four rows gives one register per component
+		__m128 minXs = _mm_loadu_ps(&boxes[firstBoxIndex].m_mins.x);
+		__m128 minYs = _mm_loadu_ps(&boxes[firstBoxIndex + 1].m_mins.x);
+		__m128 maxXs = _mm_loadu_ps(&boxes[firstBoxIndex + 2].m_mins.x);
+		__m128 maxYs = _mm_loadu_ps(&boxes[firstBoxIndex + 3].m_mins.x);
+		_MM_TRANSPOSE4_PS(minXs, minYs, maxXs, maxYs);
+		return FilterFourBoxesAlongRay(minXs, minYs, maxXs, maxYs, rays.m_startPositions[rayIndex], rays.m_fwdNormals[rayIndex], pruneDist);
+	};
+
+	auto RaycastVsAABB = [&](int rayIndex, int boxIndex) -> RaycastResult2D
+	{
+		return RaycastVsAABB2D(rays.m_startPositions[rayIndex], rays.m_fwdNormals[rayIndex], rays.m_maxDists[rayIndex], boxes[boxIndex]);
+	};
+
+	RaycastPacketVsShapes(rays.GetNumRays(), rays.m_maxDists.data(), (int)boxes.size(), FilterFourAABBs, RaycastVsAABB, out_results, out_hitShapeIndexes, anyHit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacketVsCylindersZ3D(RaycastPacket3D const& rays, std::vector<Vec2> const& centersXY, std::vector<FloatRange> const& minMaxZs, std::vector<float> const& radii, std::vector<RaycastResult3D>& out_results, std::vector<int>* out_hitShapeIndexes, bool anyHit)
+{
+	auto FilterFourCylinders = [&](int rayIndex, int firstCylinderIndex, float pruneDist) -> int
+	{
+		Vec3 const& startPos = rays.m_startPositions[rayIndex];
+		Vec3 const& fwdNormal = rays.m_fwdNormals[rayIndex];
+
+		// The scalar test divides by the ray's x direction, so those rays skip the filter to keep its exact results
+		if (fwdNormal.x == 0.f)
+		{
+			return 0xF;
+		}
+
+		__m128 centerXs;
+		__m128 centerYs;
+		__m128 minZs;
+		__m128 maxZs;
+		LoadFourVec2s(&centersXY[firstCylinderIndex], centerXs, centerYs);
+		LoadFourFloatRanges(&minMaxZs[firstCylinderIndex], minZs, maxZs);
+		__m128 cylinderRadii = _mm_loadu_ps(&radii[firstCylinderIndex]);
+
+		// Every impact the scalar test reports is on the ray and inside the cylinder's bounding box;
+		// test the box's XY slabs as a 2D box against the ray's XY projection, then its Z slab
+		__m128 minXs = _mm_sub_ps(centerXs, cylinderRadii);
+		__m128 minYs = _mm_sub_ps(centerYs, cylinderRadii);
+		__m128 maxXs = _mm_add_ps(centerXs, cylinderRadii);
+		__m128 maxYs = _mm_add_ps(centerYs, cylinderRadii);
+		int candidateMask = FilterFourBoxesAlongRay(minXs, minYs, maxXs, maxYs, Vec2(startPos.x, startPos.y), Vec2(fwdNormal.x, fwdNormal.y), pruneDist);
+		if (candidateMask == 0)
+		{
+			return 0;
+		}
+
+		float rayTolerance = (fabsf(startPos.z) + 1.f) * PACKET_FILTER_TOLERANCE;
+		__m128 zTolerances = _mm_add_ps(_mm_mul_ps(_mm_add_ps(AbsSIMD(minZs), AbsSIMD(maxZs)), _mm_set1_ps(PACKET_FILTER_TOLERANCE)), _mm_set1_ps(rayTolerance));
+		__m128 inverseFwdZs = _mm_set1_ps(GetPacketFilterInverse(fwdNormal.z));
+		__m128 slabZDistA = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(minZs, zTolerances), _mm_set1_ps(startPos.z)), inverseFwdZs);
+		__m128 slabZDistB = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(maxZs, zTolerances), _mm_set1_ps(startPos.z)), inverseFwdZs);
+		__m128 distTolerance = _mm_set1_ps((pruneDist < FLT_MAX ? pruneDist : 0.f) * PACKET_FILTER_TOLERANCE + rayTolerance);
+		__m128 isNotBehind = _mm_cmpge_ps(_mm_max_ps(slabZDistA, slabZDistB), _mm_sub_ps(_mm_setzero_ps(), distTolerance));
+		__m128 isNotBeyond = _mm_cmple_ps(_mm_min_ps(slabZDistA, slabZDistB), _mm_add_ps(_mm_set1_ps(pruneDist), distTolerance));
+		return candidateMask & _mm_movemask_ps(_mm_and_ps(isNotBehind, isNotBeyond));
+	};
+
+	auto RaycastVsCylinder = [&](int rayIndex, int cylinderIndex) -> RaycastResult3D
+	{
+		return RaycastVsCylinderZ3D(rays.m_startPositions[rayIndex], rays.m_fwdNormals[rayIndex], rays.m_maxDists[rayIndex], centersXY[cylinderIndex], minMaxZs[cylinderIndex], radii[cylinderIndex]);
+	};
+
+	// The scalar test can report end cap impacts past maxDist, so only earlier impacts are used to prune here
+	RaycastPacketVsShapes(rays.GetNumRays(), nullptr, (int)centersXY.size(), FilterFourCylinders, RaycastVsCylinder, out_results, out_hitShapeIndexes, anyHit);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// DDA core shared by the 2D and 3D grid raycasts. Returns true on impact; out_impactAxis is the axis
+// of the tile face that was crossed, or -1 if the ray started inside a solid tile.
+template<int NUM_AXES, typename T_IsTileSolid>
+static bool TraverseGrid(float const* startPos, float const* fwdNormal, float maxDist, int const* gridDimensions, T_IsTileSolid const& isTileSolid,
+	int* out_impactTileCoords, float& out_impactDist, int& out_impactAxis)
+{
+	// Clip the ray to the grid's bounds
+	float enterDist = 0.f;
+	float exitDist = maxDist;
+	int enterAxis = -1;
+	for (int axis = 0; axis < NUM_AXES; ++axis)
+	{
+		float gridMax = (float)gridDimensions[axis];
+		if (fwdNormal[axis] == 0.f)
+		{
+			if (startPos[axis] < 0.f || startPos[axis] >= gridMax)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		float inverseFwd = 1.f / fwdNormal[axis];
+		float slabEnterDist = (0.f - startPos[axis]) * inverseFwd;
+		float slabExitDist = (gridMax - startPos[axis]) * inverseFwd;
+		if (slabEnterDist > slabExitDist)
+		{
+			SwapFloatValues(slabEnterDist, slabExitDist);
+		}
+		if (slabEnterDist > enterDist)
+		{
+			enterDist = slabEnterDist;
+			enterAxis = axis;
+		}
+		exitDist = slabExitDist < exitDist ? slabExitDist : exitDist;
+	}
+	if (enterDist > exitDist)
+	{
+		return false;
+	}
+
+	int		tileCoords[NUM_AXES];
+	int		tileSteps[NUM_AXES];
+	float	nextBoundaryDists[NUM_AXES];
+	float	distPerTile[NUM_AXES];
+	for (int axis = 0; axis < NUM_AXES; ++axis)
+	{
+		// Clamp so rounding at the entry point can't put the first tile outside the grid
+		float entryPos = startPos[axis] + (fwdNormal[axis] * enterDist);
+		int tileCoord = (int)floorf(entryPos);
+		tileCoord = tileCoord < 0 ? 0 : (tileCoord >= gridDimensions[axis] ? gridDimensions[axis] - 1 : tileCoord);
+		tileCoords[axis] = tileCoord;
+
+		if (fwdNormal[axis] > 0.f)
+		{
+			tileSteps[axis] = 1;
+			distPerTile[axis] = 1.f / fwdNormal[axis];
+			nextBoundaryDists[axis] = ((float)(tileCoord + 1) - startPos[axis]) * distPerTile[axis];
+		}
+		else if (fwdNormal[axis] < 0.f)
+		{
+			tileSteps[axis] = -1;
+			distPerTile[axis] = -1.f / fwdNormal[axis];
+			nextBoundaryDists[axis] = (startPos[axis] - (float)tileCoord) * distPerTile[axis];
+		}
+		else
+		{
+			tileSteps[axis] = 0;
+			distPerTile[axis] = FLT_MAX;
+			nextBoundaryDists[axis] = FLT_MAX;
+		}
+	}
+
+	float currentDist = enterDist;
+	int crossedAxis = enterAxis;
+	for (;;)
+	{
+		if (isTileSolid(tileCoords))
+		{
+			for (int axis = 0; axis < NUM_AXES; ++axis)
+			{
+				out_impactTileCoords[axis] = tileCoords[axis];
+			}
+			out_impactDist = currentDist;
+			out_impactAxis = crossedAxis;
+			return true;
+		}
+
+		// Step into the neighboring tile whose boundary the ray reaches first
+		int stepAxis = 0;
+		for (int axis = 1; axis < NUM_AXES; ++axis)
+		{
+			if (nextBoundaryDists[axis] < nextBoundaryDists[stepAxis])
+			{
+				stepAxis = axis;
+			}
+		}
+
+		currentDist = nextBoundaryDists[stepAxis];
+		if (currentDist > exitDist)
+		{
+			return false;
+		}
+
+		tileCoords[stepAxis] += tileSteps[stepAxis];
+		if (tileCoords[stepAxis] < 0 || tileCoords[stepAxis] >= gridDimensions[stepAxis])
+		{
+			return false;
+		}
+		nextBoundaryDists[stepAxis] += distPerTile[stepAxis];
+		crossedAxis = stepAxis;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+GridRaycastResult2D RaycastVsGrid2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, IntVec2 const& gridDimensions, IsTileSolidFunc2D const& isTileSolid)
+{
+	GridRaycastResult2D raycastResult2D;
+
+	float	start[2]		= { startPos.x, startPos.y };
+	float	fwd[2]			= { fwdNormal.x, fwdNormal.y };
+	int		dimensions[2]	= { gridDimensions.x, gridDimensions.y };
+	int		impactTileCoords[2];
+	float	impactDist = 0.f;
+	int		impactAxis = -1;
+	auto IsTileSolid = [&](int const* tileCoords) { return isTileSolid(IntVec2(tileCoords[0], tileCoords[1])); };
+	if (!TraverseGrid<2>(start, fwd, maxDist, dimensions, IsTileSolid, impactTileCoords, impactDist, impactAxis))
+	{
+		return raycastResult2D;
+	}
+
+	raycastResult2D.m_didImpact = true;
+	raycastResult2D.m_impactDist = impactDist;
+	raycastResult2D.m_impactPos = startPos + (fwdNormal * impactDist);
+	raycastResult2D.m_impactTileCoords = IntVec2(impactTileCoords[0], impactTileCoords[1]);
+	if (impactAxis == 0)
+	{
+		raycastResult2D.m_impactNormal = Vec2(fwdNormal.x > 0.f ? -1.f : 1.f, 0.f);
+	}
+	else if (impactAxis == 1)
+	{
+		raycastResult2D.m_impactNormal = Vec2(0.f, fwdNormal.y > 0.f ? -1.f : 1.f);
+	}
+	else
+	{
+		raycastResult2D.m_impactNormal = -fwdNormal;
+	}
+
+	return raycastResult2D;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+GridRaycastResult3D RaycastVsGrid3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, IntVec3 const& gridDimensions, IsTileSolidFunc3D const& isTileSolid)
+{
+	GridRaycastResult3D raycastResult3D;
+
+	float	start[3]		= { startPos.x, startPos.y, startPos.z };
+	float	fwd[3]			= { fwdNormal.x, fwdNormal.y, fwdNormal.z };
+	int		dimensions[3]	= { gridDimensions.x, gridDimensions.y, gridDimensions.z };
+	int		impactTileCoords[3];
+	float	impactDist = 0.f;
+	int		impactAxis = -1;
+	auto IsTileSolid = [&](int const* tileCoords) { return isTileSolid(IntVec3(tileCoords[0], tileCoords[1], tileCoords[2])); };
+	if (!TraverseGrid<3>(start, fwd, maxDist, dimensions, IsTileSolid, impactTileCoords, impactDist, impactAxis))
+	{
+		return raycastResult3D;
+	}
+
+	raycastResult3D.m_didImpact = true;
+	raycastResult3D.m_impactDist = impactDist;
+	raycastResult3D.m_impactPos = startPos + (fwdNormal * impactDist);
+	raycastResult3D.m_impactTileCoords = IntVec3(impactTileCoords[0], impactTileCoords[1], impactTileCoords[2]);
+	if (impactAxis >= 0)
+	{
+		float normal[3] = { 0.f, 0.f, 0.f };
+		normal[impactAxis] = fwd[impactAxis] > 0.f ? -1.f : 1.f;
+		raycastResult3D.m_impactNormal = Vec3(normal[0], normal[1], normal[2]);
+	}
+	else
+	{
+		raycastResult3D.m_impactNormal = -fwdNormal;
+	}
+
+	return raycastResult3D;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int GRID_RAYCASTS_PER_JOB = 256;
+
+
+//--------------------------------------------------------------------------------------------------
+class GridRaycastJob2D : public Job
+{
+public:
+	GridRaycastJob2D(RaycastPacket2D const& rays, IntVec2 const& gridDimensions, IsTileSolidFunc2D const& isTileSolid, GridRaycastResult2D* results, int firstRayIndex, int numRays) :
+		m_rays(rays),
+		m_gridDimensions(gridDimensions),
+		m_isTileSolid(isTileSolid),
+		m_results(results),
+		m_firstRayIndex(firstRayIndex),
+		m_numRays(numRays)
+	{};
+	virtual void Execute() override
+	{
+		for (int rayIndex = m_firstRayIndex; rayIndex < m_firstRayIndex + m_numRays; ++rayIndex)
+		{
+			m_results[rayIndex] = RaycastVsGrid2D(m_rays.m_startPositions[rayIndex], m_rays.m_fwdNormals[rayIndex], m_rays.m_maxDists[rayIndex], m_gridDimensions, m_isTileSolid);
+		}
+	}
+
+	RaycastPacket2D const&		m_rays;
+	IntVec2						m_gridDimensions;
+	IsTileSolidFunc2D const&	m_isTileSolid;
+	GridRaycastResult2D*		m_results		= nullptr;
+	int							m_firstRayIndex = 0;
+	int							m_numRays		= 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+class GridRaycastJob3D : public Job
+{
+public:
+	GridRaycastJob3D(RaycastPacket3D const& rays, IntVec3 const& gridDimensions, IsTileSolidFunc3D const& isTileSolid, GridRaycastResult3D* results, int firstRayIndex, int numRays) :
+		m_rays(rays),
+		m_gridDimensions(gridDimensions),
+		m_isTileSolid(isTileSolid),
+		m_results(results),
+		m_firstRayIndex(firstRayIndex),
+		m_numRays(numRays)
+	{};
+	virtual void Execute() override
+	{
+		for (int rayIndex = m_firstRayIndex; rayIndex < m_firstRayIndex + m_numRays; ++rayIndex)
+		{
+			m_results[rayIndex] = RaycastVsGrid3D(m_rays.m_startPositions[rayIndex], m_rays.m_fwdNormals[rayIndex], m_rays.m_maxDists[rayIndex], m_gridDimensions, m_isTileSolid);
+		}
+	}
+
+	RaycastPacket3D const&		m_rays;
+	IntVec3						m_gridDimensions;
+	IsTileSolidFunc3D const&	m_isTileSolid;
+	GridRaycastResult3D*		m_results		= nullptr;
+	int							m_firstRayIndex = 0;
+	int							m_numRays		= 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Splits the rays into jobs of GRID_RAYCASTS_PER_JOB and runs them, or runs everything here if there are no workers
+template<typename T_Job, typename T_Packet, typename T_Dimensions, typename T_IsTileSolid, typename T_Result>
+static void RunGridRaycastJobs(T_Packet const& rays, T_Dimensions const& gridDimensions, T_IsTileSolid const& isTileSolid, std::vector<T_Result>& out_results, bool useJobSystem)
+{
+	int numRays = rays.GetNumRays();
+	out_results.clear();
+	out_results.resize(numRays);
+
+	std::vector<Job*> jobs;
+	for (int firstRayIndex = 0; firstRayIndex < numRays; firstRayIndex += GRID_RAYCASTS_PER_JOB)
+	{
+		int numRaysInJob = numRays - firstRayIndex < GRID_RAYCASTS_PER_JOB ? numRays - firstRayIndex : GRID_RAYCASTS_PER_JOB;
+		jobs.push_back(new T_Job(rays, gridDimensions, isTileSolid, out_results.data(), firstRayIndex, numRaysInJob));
+	}
+
+	if (useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0)
+	{
+		g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+	}
+	else
+	{
+		for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+		{
+			jobs[jobIndex]->Execute();
+		}
+	}
+
+	for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacketVsGrid2D(RaycastPacket2D const& rays, IntVec2 const& gridDimensions, IsTileSolidFunc2D const& isTileSolid, std::vector<GridRaycastResult2D>& out_results, bool useJobSystem)
+{
+	RunGridRaycastJobs<GridRaycastJob2D>(rays, gridDimensions, isTileSolid, out_results, useJobSystem);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RaycastPacketVsGrid3D(RaycastPacket3D const& rays, IntVec3 const& gridDimensions, IsTileSolidFunc3D const& isTileSolid, std::vector<GridRaycastResult3D>& out_results, bool useJobSystem)
+{
+	RunGridRaycastJobs<GridRaycastJob3D>(rays, gridDimensions, isTileSolid, out_results, useJobSystem);
+}
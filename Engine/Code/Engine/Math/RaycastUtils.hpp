@@ -1,9 +1,16 @@
 #pragma once
 #include "Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/IntVec3.hpp"
+
+#include <vector>
+#include <functional>
 
-struct Vec3;
 struct FloatRange;
 struct AABB2;
+struct OBB2;
+struct AABB3;
 
 struct RaycastResult2D
 {
@@ -16,6 +23,8 @@ struct RaycastResult2D
 RaycastResult2D RaycastVsDisc2D(Vec2 startPos, Vec2 fwdNormal, float maxDist, Vec2 discCenter, float discRadius);
 RaycastResult2D RaycastVsLineSegment2D(Vec2 const& rayStartPos, Vec2 const& fwdNormal, float maxDist, Vec2 const& lineSegmentStartPos, Vec2 const& lineSegmentEndPos);
 RaycastResult2D RaycastVsAABB2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, AABB2 const& bounds);
+RaycastResult2D RaycastVsOBB2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, OBB2 const& orientedBox);
+RaycastResult2D RaycastVsCapsule2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, Vec2 const& boneStart, Vec2 const& boneEnd, float radius);
 
 struct RaycastResult3D
 {
@@ -25,4 +34,67 @@ struct RaycastResult3D
 	bool m_didImpact = false;
 };
 
-RaycastResult3D RaycastVsCylinderZ3D(Vec3 const& start, Vec3 const& fwdNormal, float maxDist, Vec2 const& centerXY, FloatRange minMaxZ, float radius);
\ No newline at end of file
+RaycastResult3D RaycastVsCylinderZ3D(Vec3 const& start, Vec3 const& fwdNormal, float maxDist, Vec2 const& centerXY, FloatRange minMaxZ, float radius);
+RaycastResult3D RaycastVsAABB3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, AABB3 const& bounds);
+RaycastResult3D RaycastVsSphere3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, Vec3 const& sphereCenter, float sphereRadius);
+
+
+//--------------------------------------------------------------------------------------------------
+// Ray packets: many rays against many shapes of one kind in a single call. Shapes are tested four at a
+// time with SSE as a conservative filter and the scalar functions above compute every actual impact, so
+// each ray's result is exactly what looping the scalar function over the shapes would give. Each ray
+// gets its nearest impact, or with anyHit the first impact found (enough for line of sight checks).
+//--------------------------------------------------------------------------------------------------
+struct RaycastPacket2D
+{
+	std::vector<Vec2>	m_startPositions;
+	std::vector<Vec2>	m_fwdNormals;
+	std::vector<float>	m_maxDists;
+
+	void	AddRay(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist);
+	int		GetNumRays() const;
+	void	Clear();
+};
+
+void RaycastPacketVsDiscs2D(RaycastPacket2D const& rays, std::vector<Vec2> const& discCenters, std::vector<float> const& discRadii, std::vector<RaycastResult2D>& out_results, std::vector<int>* out_hitShapeIndexes = nullptr, bool anyHit = false);
+void RaycastPacketVsLineSegments2D(RaycastPacket2D const& rays, std::vector<Vec2> const& lineSegmentStartPositions, std::vector<Vec2> const& lineSegmentEndPositions, std::vector<RaycastResult2D>& out_results, std::vector<int>* out_hitShapeIndexes = nullptr, bool anyHit = false);
+void RaycastPacketVsAABBs2D(RaycastPacket2D const& rays, std::vector<AABB2> const& boxes, std::vector<RaycastResult2D>& out_results, std::vector<int>* out_hitShapeIndexes = nullptr, bool anyHit = false);
+
+//--------------------------------------------------------------------------------------------------
+struct RaycastPacket3D
+{
+	std::vector<Vec3>	m_startPositions;
+	std::vector<Vec3>	m_fwdNormals;
+	std::vector<float>	m_maxDists;
+
+	void	AddRay(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist);
+	int		GetNumRays() const;
+	void	Clear();
+};
+
+void RaycastPacketVsCylindersZ3D(RaycastPacket3D const& rays, std::vector<Vec2> const& centersXY, std::vector<FloatRange> const& minMaxZs, std::vector<float> const& radii, std::vector<RaycastResult3D>& out_results, std::vector<int>* out_hitShapeIndexes = nullptr, bool anyHit = false);
+
+
+//--------------------------------------------------------------------------------------------------
+// Grid raycasts (Amanatides-Woo DDA) over unit tiles, with tile (x, y) covering [x, x + 1] x [y, y + 1].
+// Only the tiles the ray actually crosses are visited, stopping at the first one the predicate calls
+// solid. Tiles outside the grid are never solid; rays starting outside the grid are clipped to it first.
+// The batch versions call the predicate from worker threads, so it must be safe to call concurrently.
+//--------------------------------------------------------------------------------------------------
+struct GridRaycastResult2D : public RaycastResult2D
+{
+	IntVec2 m_impactTileCoords = IntVec2(-1, -1);
+};
+
+struct GridRaycastResult3D : public RaycastResult3D
+{
+	IntVec3 m_impactTileCoords = IntVec3(-1, -1, -1);
+};
+
+typedef std::function<bool(IntVec2 const& tileCoords)> IsTileSolidFunc2D;
+typedef std::function<bool(IntVec3 const& tileCoords)> IsTileSolidFunc3D;
+
+GridRaycastResult2D RaycastVsGrid2D(Vec2 const& startPos, Vec2 const& fwdNormal, float maxDist, IntVec2 const& gridDimensions, IsTileSolidFunc2D const& isTileSolid);
+GridRaycastResult3D RaycastVsGrid3D(Vec3 const& startPos, Vec3 const& fwdNormal, float maxDist, IntVec3 const& gridDimensions, IsTileSolidFunc3D const& isTileSolid);
+void RaycastPacketVsGrid2D(RaycastPacket2D const& rays, IntVec2 const& gridDimensions, IsTileSolidFunc2D const& isTileSolid, std::vector<GridRaycastResult2D>& out_results, bool useJobSystem = true);
+void RaycastPacketVsGrid3D(RaycastPacket3D const& rays, IntVec3 const& gridDimensions, IsTileSolidFunc3D const& isTileSolid, std::vector<GridRaycastResult3D>& out_results, bool useJobSystem = true);
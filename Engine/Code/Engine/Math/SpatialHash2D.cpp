@@ -0,0 +1,347 @@
+#include "Engine/Math/SpatialHash2D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------
+void SpatialHash2D::Build(std::vector<Vec2> const& discCenters, std::vector<float> const& discRadii, float cellSize)
+{
+	GUARANTEE_OR_DIE(discCenters.size() == discRadii.size(), "SpatialHash2D::Build() needs one radius per disc center");
+
+	m_numDiscs = (int)discCenters.size();
+
+	m_maxDiscRadius = 0.f;
+	for (int discIndex = 0; discIndex < m_numDiscs; ++discIndex)
+	{
+		m_maxDiscRadius = discRadii[discIndex] > m_maxDiscRadius ? discRadii[discIndex] : m_maxDiscRadius;
+	}
+
+	float minCellSize = 2.f * m_maxDiscRadius;
+	m_cellSize = cellSize > minCellSize ? cellSize : minCellSize;
+	if (m_cellSize <= 0.f)
+	{
+		m_cellSize = 1.f;
+	}
+	m_inverseCellSize = 1.f / m_cellSize;
+
+	// The buckets form a power of two grid that the infinite cell grid wraps around, at least twice the number
+	// of discs to keep cells sharing a bucket rare; unlike a scrambling hash, neighboring cells stay neighbors in memory
+	m_bucketGridSizeLog2 = 0;
+	while ((1u << (2 * m_bucketGridSizeLog2)) < (unsigned int)(2 * m_numDiscs))
+	{
+		++m_bucketGridSizeLog2;
+	}
+	unsigned int numBuckets = 1u << (2 * m_bucketGridSizeLog2);
+	m_bucketIndexMask = (1u << m_bucketGridSizeLog2) - 1;
+
+	// Counting sort of the discs by bucket
+	m_cellCoordsForDisc.resize(m_numDiscs);
+	m_bucketStartIndexes.assign(numBuckets + 1, 0);
+	for (int discIndex = 0; discIndex < m_numDiscs; ++discIndex)
+	{
+		m_cellCoordsForDisc[discIndex] = GetCellCoordsForPosition(discCenters[discIndex]);
+		int bucketIndex = GetBucketIndexForCell(m_cellCoordsForDisc[discIndex]);
+		m_bucketStartIndexes[bucketIndex + 1] += 1;
+	}
+
+	for (unsigned int bucketIndex = 0; bucketIndex < numBuckets; ++bucketIndex)
+	{
+		m_bucketStartIndexes[bucketIndex + 1] += m_bucketStartIndexes[bucketIndex];
+	}
+
+	std::vector<int> bucketWriteIndexes(m_bucketStartIndexes.begin(), m_bucketStartIndexes.end() - 1);
+	m_sortedDiscIndexes.resize(m_numDiscs);
+	for (int discIndex = 0; discIndex < m_numDiscs; ++discIndex)
+	{
+		int bucketIndex = GetBucketIndexForCell(m_cellCoordsForDisc[discIndex]);
+		m_sortedDiscIndexes[bucketWriteIndexes[bucketIndex]++] = discIndex;
+	}
+
+	m_sortedCellCoords.resize(m_numDiscs);
+	m_sortedCenters.resize(m_numDiscs);
+	m_sortedRadii.resize(m_numDiscs);
+	for (int sortedIndex = 0; sortedIndex < m_numDiscs; ++sortedIndex)
+	{
+		int discIndex = m_sortedDiscIndexes[sortedIndex];
+		m_sortedCellCoords[sortedIndex] = m_cellCoordsForDisc[discIndex];
+		m_sortedCenters[sortedIndex] = discCenters[discIndex];
+		m_sortedRadii[sortedIndex] = discRadii[discIndex];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpatialHash2D::GetOverlappingDiscPairs(std::vector<DiscCollisionPair2D>& out_pairs) const
+{
+	// Half of the 3x3 neighborhood is enough to see every pair exactly once: the disc's own cell (only looking
+	// further along in the bucket), then the cells to the east, north-west, north and north-east
+	constexpr int NUM_FORWARD_NEIGHBORS = 4;
+	static IntVec2 const forwardNeighborOffsets[NUM_FORWARD_NEIGHBORS] = { IntVec2(1, 0), IntVec2(-1, 1), IntVec2(0, 1), IntVec2(1, 1) };
+
+	for (int sortedIndexA = 0; sortedIndexA < m_numDiscs; ++sortedIndexA)
+	{
+		IntVec2 const& cellCoordsA = m_sortedCellCoords[sortedIndexA];
+		Vec2 const& centerA = m_sortedCenters[sortedIndexA];
+		float radiusA = m_sortedRadii[sortedIndexA];
+
+		for (int neighborIndex = -1; neighborIndex < NUM_FORWARD_NEIGHBORS; ++neighborIndex)
+		{
+			int neighborCellX = cellCoordsA.x;
+			int neighborCellY = cellCoordsA.y;
+			if (neighborIndex >= 0)
+			{
+				neighborCellX += forwardNeighborOffsets[neighborIndex].x;
+				neighborCellY += forwardNeighborOffsets[neighborIndex].y;
+			}
+
+			int bucketIndex = GetBucketIndexForCell(IntVec2(neighborCellX, neighborCellY));
+			int firstSortedIndexB = neighborIndex < 0 ? sortedIndexA + 1 : m_bucketStartIndexes[bucketIndex];
+			for (int sortedIndexB = firstSortedIndexB; sortedIndexB < m_bucketStartIndexes[bucketIndex + 1]; ++sortedIndexB)
+			{
+				// Skip discs from other cells that happen to share this bucket
+				IntVec2 const& cellCoordsB = m_sortedCellCoords[sortedIndexB];
+				if (cellCoordsB.x != neighborCellX || cellCoordsB.y != neighborCellY)
+				{
+					continue;
+				}
+
+				Vec2 dispFromAToB = m_sortedCenters[sortedIndexB] - centerA;
+				float sumOfRadii = radiusA + m_sortedRadii[sortedIndexB];
+				if ((dispFromAToB.x * dispFromAToB.x) + (dispFromAToB.y * dispFromAToB.y) < sumOfRadii * sumOfRadii)
+				{
+					int discIndexA = m_sortedDiscIndexes[sortedIndexA];
+					int discIndexB = m_sortedDiscIndexes[sortedIndexB];
+					DiscCollisionPair2D pair;
+					pair.m_discIndexA = discIndexA < discIndexB ? discIndexA : discIndexB;
+					pair.m_discIndexB = discIndexA < discIndexB ? discIndexB : discIndexA;
+					out_pairs.push_back(pair);
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpatialHash2D::GetDiscsOverlappingDisc(Vec2 const& discCenter, float discRadius, std::vector<int>& out_discIndexes) const
+{
+	float searchRadius = discRadius + m_maxDiscRadius;
+	IntVec2 minCellCoords = GetCellCoordsForPosition(discCenter - Vec2(searchRadius, searchRadius));
+	IntVec2 maxCellCoords = GetCellCoordsForPosition(discCenter + Vec2(searchRadius, searchRadius));
+
+	for (int cellY = minCellCoords.y; cellY <= maxCellCoords.y; ++cellY)
+	{
+		for (int cellX = minCellCoords.x; cellX <= maxCellCoords.x; ++cellX)
+		{
+			IntVec2 cellCoords(cellX, cellY);
+			int bucketIndex = GetBucketIndexForCell(cellCoords);
+			for (int sortedIndex = m_bucketStartIndexes[bucketIndex]; sortedIndex < m_bucketStartIndexes[bucketIndex + 1]; ++sortedIndex)
+			{
+				if (m_sortedCellCoords[sortedIndex] != cellCoords)
+				{
+					continue;
+				}
+
+				float sumOfRadii = discRadius + m_sortedRadii[sortedIndex];
+				if (GetDistanceSquared2D(discCenter, m_sortedCenters[sortedIndex]) < sumOfRadii * sumOfRadii)
+				{
+					out_discIndexes.push_back(m_sortedDiscIndexes[sortedIndex]);
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float SpatialHash2D::GetCellSize() const
+{
+	return m_cellSize;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+IntVec2 SpatialHash2D::GetCellCoordsForPosition(Vec2 const& position) const
+{
+	return IntVec2((int)floorf(position.x * m_inverseCellSize), (int)floorf(position.y * m_inverseCellSize));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int SpatialHash2D::GetBucketIndexForCell(IntVec2 const& cellCoords) const
+{
+	unsigned int bucketX = (unsigned int)cellCoords.x & m_bucketIndexMask;
+	unsigned int bucketY = (unsigned int)cellCoords.y & m_bucketIndexMask;
+	return (int)(bucketX | (bucketY << m_bucketGridSizeLog2));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ColorDiscCollisionPairs(std::vector<DiscCollisionPair2D> const& pairs, int numDiscs, DiscCollisionBatches2D& out_batches)
+{
+	constexpr int OVERFLOW_COLOR = MAX_DISC_COLLISION_COLORS;
+
+	std::vector<unsigned long long> usedColorMasksForDisc(numDiscs, 0ull);
+	std::vector<unsigned char> colorForPair(pairs.size());
+	int numPairsForColor[MAX_DISC_COLLISION_COLORS + 1] = {};
+	int numColorsUsed = 0;
+
+	for (int pairIndex = 0; pairIndex < (int)pairs.size(); ++pairIndex)
+	{
+		DiscCollisionPair2D const& pair = pairs[pairIndex];
+		unsigned long long usedColorMask = usedColorMasksForDisc[pair.m_discIndexA] | usedColorMasksForDisc[pair.m_discIndexB];
+
+		int color = 0;
+		while (color < MAX_DISC_COLLISION_COLORS && (usedColorMask & (1ull << color)) != 0)
+		{
+			++color;
+		}
+
+		if (color < MAX_DISC_COLLISION_COLORS)
+		{
+			usedColorMasksForDisc[pair.m_discIndexA] |= (1ull << color);
+			usedColorMasksForDisc[pair.m_discIndexB] |= (1ull << color);
+			numColorsUsed = color + 1 > numColorsUsed ? color + 1 : numColorsUsed;
+		}
+
+		colorForPair[pairIndex] = (unsigned char)color;
+		numPairsForColor[color] += 1;
+	}
+
+	out_batches.m_batchStartIndexes.resize(numColorsUsed + 1);
+	int pairWriteIndexes[MAX_DISC_COLLISION_COLORS + 1] = {};
+	int runningTotal = 0;
+	for (int color = 0; color < numColorsUsed; ++color)
+	{
+		out_batches.m_batchStartIndexes[color] = runningTotal;
+		pairWriteIndexes[color] = runningTotal;
+		runningTotal += numPairsForColor[color];
+	}
+	out_batches.m_batchStartIndexes[numColorsUsed] = runningTotal;
+	out_batches.m_overflowStartIndex = runningTotal;
+	pairWriteIndexes[OVERFLOW_COLOR] = runningTotal;
+
+	out_batches.m_pairs.resize(pairs.size());
+	for (int pairIndex = 0; pairIndex < (int)pairs.size(); ++pairIndex)
+	{
+		out_batches.m_pairs[pairWriteIndexes[colorForPair[pairIndex]]++] = pairs[pairIndex];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+struct DiscCollisionArrays2D
+{
+	Vec2*			m_discCenters		= nullptr;
+	float const*	m_discRadii			= nullptr;
+	Vec2*			m_discVelocities	= nullptr;	// Null when only pushing
+	float			m_elasticity		= 1.f;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static void ResolveDiscCollisionPairs(DiscCollisionArrays2D const& discs, DiscCollisionPair2D const* pairs, int numPairs)
+{
+	for (int pairIndex = 0; pairIndex < numPairs; ++pairIndex)
+	{
+		int discIndexA = pairs[pairIndex].m_discIndexA;
+		int discIndexB = pairs[pairIndex].m_discIndexB;
+		if (discs.m_discVelocities)
+		{
+			BounceDiscsOffEachOther2D(discs.m_discCenters[discIndexA], discs.m_discRadii[discIndexA], discs.m_discVelocities[discIndexA],
+				discs.m_discCenters[discIndexB], discs.m_discRadii[discIndexB], discs.m_discVelocities[discIndexB], discs.m_elasticity, 1.f);
+		}
+		else
+		{
+			PushDiscsOutOfEachOther2D(discs.m_discCenters[discIndexA], discs.m_discRadii[discIndexA], discs.m_discCenters[discIndexB], discs.m_discRadii[discIndexB]);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+class DiscCollisionJob : public Job
+{
+public:
+	DiscCollisionJob(DiscCollisionArrays2D const& discs, DiscCollisionPair2D const* pairs, int numPairs) :
+		m_discs(discs),
+		m_pairs(pairs),
+		m_numPairs(numPairs)
+	{};
+	virtual void Execute() override
+	{
+		ResolveDiscCollisionPairs(m_discs, m_pairs, m_numPairs);
+	}
+
+	DiscCollisionArrays2D		m_discs;
+	DiscCollisionPair2D const*	m_pairs		= nullptr;
+	int							m_numPairs	= 0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static void ResolveDiscCollisionPairsInParallel(DiscCollisionArrays2D const& discs, int numDiscs, std::vector<DiscCollisionPair2D> const& pairs)
+{
+	DiscCollisionBatches2D batches;
+	ColorDiscCollisionPairs(pairs, numDiscs, batches);
+
+	// Within a batch no two pairs share a disc, so its jobs can write to the discs without locking
+	std::vector<Job*> jobs;
+	for (int batchIndex = 0; batchIndex < batches.GetNumBatches(); ++batchIndex)
+	{
+		int batchStartIndex = batches.m_batchStartIndexes[batchIndex];
+		int batchEndIndex = batches.m_batchStartIndexes[batchIndex + 1];
+		for (int jobStartIndex = batchStartIndex; jobStartIndex < batchEndIndex; jobStartIndex += DISC_COLLISION_PAIRS_PER_JOB)
+		{
+			int numPairsInJob = batchEndIndex - jobStartIndex < DISC_COLLISION_PAIRS_PER_JOB ? batchEndIndex - jobStartIndex : DISC_COLLISION_PAIRS_PER_JOB;
+			jobs.push_back(new DiscCollisionJob(discs, batches.m_pairs.data() + jobStartIndex, numPairsInJob));
+		}
+
+		g_theJobSystem->ExecuteAndRetrieveJobs(jobs);
+		for (int jobIndex = 0; jobIndex < (int)jobs.size(); ++jobIndex)
+		{
+			delete jobs[jobIndex];
+		}
+		jobs.clear();
+	}
+
+	int numOverflowPairs = (int)batches.m_pairs.size() - batches.m_overflowStartIndex;
+	ResolveDiscCollisionPairs(discs, batches.m_pairs.data() + batches.m_overflowStartIndex, numOverflowPairs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void PushDiscsOutOfEachOther2D(std::vector<Vec2>& discCenters, std::vector<float> const& discRadii, std::vector<DiscCollisionPair2D> const& pairs, bool useJobSystem)
+{
+	DiscCollisionArrays2D discs;
+	discs.m_discCenters = discCenters.data();
+	discs.m_discRadii = discRadii.data();
+
+	if (useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0)
+	{
+		ResolveDiscCollisionPairsInParallel(discs, (int)discCenters.size(), pairs);
+		return;
+	}
+	ResolveDiscCollisionPairs(discs, pairs.data(), (int)pairs.size());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BounceDiscsOffEachOther2D(std::vector<Vec2>& discCenters, std::vector<float> const& discRadii, std::vector<Vec2>& discVelocities, std::vector<DiscCollisionPair2D> const& pairs, float elasticity, bool useJobSystem)
+{
+	DiscCollisionArrays2D discs;
+	discs.m_discCenters = discCenters.data();
+	discs.m_discRadii = discRadii.data();
+	discs.m_discVelocities = discVelocities.data();
+	discs.m_elasticity = elasticity;
+
+	if (useJobSystem && g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0)
+	{
+		ResolveDiscCollisionPairsInParallel(discs, (int)discCenters.size(), pairs);
+		return;
+	}
+	ResolveDiscCollisionPairs(discs, pairs.data(), (int)pairs.size());
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int MAX_DISC_COLLISION_COLORS				= 64;	// One bit per color in each disc's used-color mask
+constexpr int DISC_COLLISION_PAIRS_PER_JOB			= 2048;
+
+
+//--------------------------------------------------------------------------------------------------
+struct DiscCollisionPair2D
+{
+	int m_discIndexA = -1;
+	int m_discIndexB = -1;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Collision pairs regrouped so that no two pairs within the same batch share a disc, which lets
+// every pair in a batch be resolved at the same time. Pairs that did not fit in any color land
+// in the overflow batch at the end, which has to be resolved serially.
+//--------------------------------------------------------------------------------------------------
+struct DiscCollisionBatches2D
+{
+	std::vector<DiscCollisionPair2D>	m_pairs;
+	std::vector<int>					m_batchStartIndexes;	// Batch N is [m_batchStartIndexes[N], m_batchStartIndexes[N + 1])
+	int									m_overflowStartIndex = 0;
+
+	int GetNumBatches() const { return m_batchStartIndexes.empty() ? 0 : (int)m_batchStartIndexes.size() - 1; }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Uniform grid broadphase for discs, stored as a hash table so the world does not need to be bounded.
+// Every disc is filed under the cell containing its center; with cells at least as wide as the
+// largest disc's diameter, any overlapping pair is guaranteed to be within one cell of each other.
+// Build() copies the centers and radii, so queries use the positions and radii as they were at
+// Build(); discs that move in the meantime are only seen where they were until the next Build().
+//--------------------------------------------------------------------------------------------------
+class SpatialHash2D
+{
+public:
+	SpatialHash2D() {}
+	~SpatialHash2D() {}
+
+	// Pass a cellSize of 0 to size cells to the largest disc
+	void	Build(std::vector<Vec2> const& discCenters, std::vector<float> const& discRadii, float cellSize = 0.f);
+	void	GetOverlappingDiscPairs(std::vector<DiscCollisionPair2D>& out_pairs) const;
+	void	GetDiscsOverlappingDisc(Vec2 const& discCenter, float discRadius, std::vector<int>& out_discIndexes) const;
+
+	float	GetCellSize() const;
+	IntVec2 GetCellCoordsForPosition(Vec2 const& position) const;
+
+private:
+	int		GetBucketIndexForCell(IntVec2 const& cellCoords) const;
+
+private:
+	int					m_numDiscs				= 0;
+	float				m_cellSize				= 1.f;
+	float				m_inverseCellSize		= 1.f;
+	float				m_maxDiscRadius			= 0.f;
+	unsigned int		m_bucketIndexMask		= 0;	// Per axis
+	unsigned int		m_bucketGridSizeLog2	= 0;
+	std::vector<IntVec2>	m_cellCoordsForDisc;
+	std::vector<int>		m_bucketStartIndexes;	// Prefix sums; bucket N's discs are [m_bucketStartIndexes[N], m_bucketStartIndexes[N + 1])
+	std::vector<int>		m_sortedDiscIndexes;
+	std::vector<IntVec2>	m_sortedCellCoords;		// Copies of the disc data in bucket order, so neighbor scans read memory linearly
+	std::vector<Vec2>		m_sortedCenters;
+	std::vector<float>		m_sortedRadii;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Greedy edge coloring of the collision pairs; each disc tracks which colors its pairs already use
+void ColorDiscCollisionPairs(std::vector<DiscCollisionPair2D> const& pairs, int numDiscs, DiscCollisionBatches2D& out_batches);
+
+// Batch versions of the pairwise MathUtils helpers. Pairs are resolved in order on the main thread,
+// or batch by batch over the JobSystem when useJobSystem is true (results then depend on the coloring order)
+void PushDiscsOutOfEachOther2D(std::vector<Vec2>& discCenters, std::vector<float> const& discRadii, std::vector<DiscCollisionPair2D> const& pairs, bool useJobSystem = false);
+void BounceDiscsOffEachOther2D(std::vector<Vec2>& discCenters, std::vector<float> const& discRadii, std::vector<Vec2>& discVelocities, std::vector<DiscCollisionPair2D> const& pairs, float elasticity = 1.f, bool useJobSystem = false);
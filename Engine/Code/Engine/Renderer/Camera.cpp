@@ -1,5 +1,8 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+#include <math.h>
 
 void Camera::SetOrthoView(Vec2 const& bottomLeft, Vec2 const& topRight, float near, float far)
 {
@@ -8,6 +11,7 @@ void Camera::SetOrthoView(Vec2 const& bottomLeft, Vec2 const& topRight, float ne
 	m_orthographicTopRight = topRight;
 	m_orthographicNear = near;
 	m_orthographicFar = far;
+	UpdateCachedMatrices();
 }
 
 void Camera::SetPerspectiveView(float aspect, float fov, float near, float far)
@@ -17,11 +21,13 @@ void Camera::SetPerspectiveView(float aspect, float fov, float near, float far)
 	m_perspectiveFOV = fov;
 	m_perspectiveNear = near;
 	m_perspectiveFar = far;
+	UpdateCachedMatrices();
 }
 
 void Camera::SetPerspectiveFOV(float fov)
 {
 	m_perspectiveFOV = fov;
+	UpdateCachedMatrices();
 }
 
 Vec2 Camera::GetCameraCenter() const
@@ -38,6 +44,7 @@ void Camera::SetCameraCenter(Vec2 const& newCenter)
 	camBounds.SetCenter(newCenter);
 	m_orthographicBotttomLeft = camBounds.m_mins;
 	m_orthographicTopRight = camBounds.m_maxs;
+	UpdateCachedMatrices();
 }
 
 void Camera::SetCameraViewport(float minX, float minY, float maxX, float maxY)
@@ -64,22 +71,26 @@ void Camera::SetRenderBasis(Vec3 const& iBasis, Vec3 const& jBasis, Vec3 const&
 	m_renderIBasis = iBasis;
 	m_renderJBasis = jBasis;
 	m_renderKBasis = kBasis;
+	UpdateCachedMatrices();
 }
 
 void Camera::SetTransform(Vec3 const& position, EulerAngles const& orientation)
 {
 	m_position = position;
 	m_orientation = orientation;
+	UpdateCachedMatrices();
 }
 
 void Camera::SetPositionOnly(Vec3 const& position)
 {
 	m_position = position;
+	UpdateCachedMatrices();
 }
 
 void Camera::SetOrientationOnly(EulerAngles const& orientation)
 {
 	m_orientation = orientation;
+	UpdateCachedMatrices();
 }
 
 Mat44 Camera::GetOrthographicMatrix() const
@@ -98,40 +109,56 @@ Mat44 Camera::GetPerspectiveMatrix() const
 
 Mat44 Camera::GetProjectionMatrix() const
 {
-	// Mat44 viewMat = GetViewMatrix();
+	return m_projectionMatrix;
+}
+
+Mat44 Camera::GetRenderMatrix() const
+{
+	Mat44 renderMat;
+	renderMat.SetIJK3D(m_renderIBasis, m_renderJBasis, m_renderKBasis);
+	return renderMat;
+}
+
+Mat44 Camera::GetViewMatrix() const
+{
+	return m_viewMatrix;
+}
+
+Mat44 Camera::GetViewProjectionMatrix() const
+{
+	return m_viewProjectionMatrix;
+}
+
+Frustum const& Camera::GetFrustum() const
+{
+	return m_frustum;
+}
+
+void Camera::UpdateCachedMatrices()
+{
 	Mat44 renderMat = GetRenderMatrix();
-	Mat44 projectionMat;
 	if (m_mode == Mode_Orthographic)
 	{
-		projectionMat = GetOrthographicMatrix();
+		m_projectionMatrix = GetOrthographicMatrix();
 	}
 	else if (m_mode == Mode_Perspective)
 	{
-		projectionMat = GetPerspectiveMatrix();
+		m_projectionMatrix = GetPerspectiveMatrix();
 	}
 	else
 	{
 		ERROR_AND_DIE("Invalid camera mode: " + m_mode);
 	}
-	//projectionMat.Append(viewMat);
-	projectionMat.Append(renderMat);
-	return projectionMat;
-}
-
-Mat44 Camera::GetRenderMatrix() const
-{
-	Mat44 renderMat;
-	renderMat.SetIJK3D(m_renderIBasis, m_renderJBasis, m_renderKBasis);
-	return renderMat;
-}
+	m_projectionMatrix.Append(renderMat);
 
-Mat44 Camera::GetViewMatrix() const
-{
-	Mat44 viewMat = m_orientation.GetAsMatrix_XFwd_YLeft_ZUp();
-	viewMat.SetTranslation3D(m_position);
+	m_viewMatrix = m_orientation.GetAsMatrix_XFwd_YLeft_ZUp();
+	m_viewMatrix.SetTranslation3D(m_position);
+	m_viewMatrix = m_viewMatrix.GetOrthonormalInverse();
 
-	viewMat = viewMat.GetOrthonormalInverse();
-	return viewMat;
+	// World to clip space in one matrix, the same order the shaders apply them in
+	m_viewProjectionMatrix = m_projectionMatrix;
+	m_viewProjectionMatrix.Append(m_viewMatrix);
+	m_frustum = Frustum::MakeFromViewProjectionMatrix(m_viewProjectionMatrix);
 }
 
 Vec2 Camera::GetOrthoBottomLeft() const
@@ -165,6 +192,25 @@ EulerAngles Camera::GetCameraOrientation() const
 	return m_orientation;
 }
 
+// Radius in pixels of a sphere on screen, for picking a level of detail. Perspective uses the distance
+// to the sphere's center rather than its depth, which slightly undersizes spheres at the screen edges.
+float Camera::GetProjectedRadius(Vec3 const& center, float radius, float viewportHeightPixels) const
+{
+	if (m_mode == Mode_Orthographic)
+	{
+		float viewHeight = m_orthographicTopRight.y - m_orthographicBotttomLeft.y;
+		return viewHeight > 0.f ? radius * viewportHeightPixels / viewHeight : 0.f;
+	}
+
+	float distance = (center - m_position).GetLength();
+	float halfViewHeightAtDistance = distance * tanf(ConvertDegreesToRadians(0.5f * m_perspectiveFOV));
+	if (distance <= radius || halfViewHeightAtDistance <= 0.f)
+	{
+		return viewportHeightPixels;
+	}
+	return radius * 0.5f * viewportHeightPixels / halfViewHeightAtDistance;
+}
+
 void Camera::Translate2D(Vec2 const& translation)
 {
 	(void)translation;
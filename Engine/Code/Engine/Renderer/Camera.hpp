@@ -3,6 +3,7 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Frustum.hpp"
 
 class Camera
 {
@@ -31,6 +32,8 @@ public:
 	Mat44 GetProjectionMatrix() const;
 	Mat44 GetRenderMatrix() const;
 	Mat44 GetViewMatrix() const;
+	Mat44 GetViewProjectionMatrix() const;
+	Frustum const& GetFrustum() const;
 
 	Vec2 GetCameraCenter() const;
 	Vec2 GetOrthoBottomLeft() const;
@@ -40,22 +43,26 @@ public:
 
 	Vec3 GetCameraPosition() const;
 	EulerAngles GetCameraOrientation() const;
+	float GetProjectedRadius(Vec3 const& center, float radius, float viewportHeightPixels) const;
 
 	void Translate2D(Vec2 const& translation);
 	Vec2 CameraShake(float randomTheta,float shakeAmount);
 
+private:
+	void UpdateCachedMatrices();
+
 private:
 	Mode m_mode = Mode_Orthographic;
 	Vec2 m_orthographicBotttomLeft;
 	Vec2 m_orthographicTopRight;
 	AABB2 m_viewport = AABB2::INVALID;
-	float m_orthographicNear;
-	float m_orthographicFar;
+	float m_orthographicNear = 0.f;
+	float m_orthographicFar = 1.f;
 
-	float m_perspectiveAspect;
-	float m_perspectiveFOV;
-	float m_perspectiveNear;
-	float m_perspectiveFar;
+	float m_perspectiveAspect = 1.f;
+	float m_perspectiveFOV = 60.f;
+	float m_perspectiveNear = 0.1f;
+	float m_perspectiveFar = 100.f;
 
 	Vec3 m_renderIBasis = Vec3(1.f, 0.f, 0.f);
 	Vec3 m_renderJBasis = Vec3(0.f, 1.f, 0.f);
@@ -63,4 +70,10 @@ private:
 
 	Vec3 m_position;
 	EulerAngles m_orientation;
+
+	// Rebuilt by every setter that affects them, so the getters are free to call per object
+	Mat44 m_projectionMatrix;
+	Mat44 m_viewMatrix;
+	Mat44 m_viewProjectionMatrix;
+	Frustum m_frustum;
 };
\ No newline at end of file
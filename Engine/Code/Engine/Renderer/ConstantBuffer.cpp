@@ -1,7 +1,9 @@
 #include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
+#if !defined(ENGINE_NULL_RENDERER)
 #include <d3d11.h>
+#endif
 
 ConstantBuffer::ConstantBuffer(size_t size) :
 	m_size(size)
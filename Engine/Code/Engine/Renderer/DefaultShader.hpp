@@ -50,4 +50,140 @@ float4 PixelMain(v2p_t input) : SV_Target0
 	if (color.a < 0.001) discard;
 	return color;
 }
-)";
\ No newline at end of file
+)";
+
+const char* g_theInstanced2DShaderSource = R"(
+struct vs_input_t
+{
+	float3 localPosition : POSITION;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+	float4 instanceTranslationAndScale : INSTANCE_TRANSFORM;
+	float4 instanceColor : INSTANCE_COLOR;
+};
+
+struct v2p_t
+{
+	float4 position : SV_Position;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+};
+
+cbuffer CameraConstants : register(b2)
+{
+	float4x4 projectionMatrix;
+	float4x4 viewMatrix;
+};
+
+cbuffer ModelConstants : register(b3)
+{
+	float4x4 modelMatrix;
+	float4 modelColor;
+};
+
+Texture2D diffuseTexture : register(t0);
+
+SamplerState diffuseSampler : register(s0);
+
+v2p_t VertexMain(vs_input_t input)
+{
+	v2p_t v2p;
+	float2 instancePosition = input.instanceTranslationAndScale.xy + input.localPosition.xy * input.instanceTranslationAndScale.zw;
+	float4 modelPosition = mul(modelMatrix, float4(instancePosition, input.localPosition.z, 1));
+	float4 viewPosition = mul(viewMatrix, modelPosition);
+	float4 clipPosition = mul(projectionMatrix, viewPosition);
+	v2p.position = clipPosition;
+	v2p.color = input.color * input.instanceColor * modelColor;
+	v2p.uv = input.uv;
+	return v2p;
+}
+
+float4 PixelMain(v2p_t input) : SV_Target0
+{
+	float4 color = diffuseTexture.Sample(diffuseSampler, input.uv);
+	color *= input.color;
+	if (color.a < 0.001) discard;
+	return color;
+}
+)";
+
+// For Vertex_PNCUPacked and Vertex_PNCUQuantized. Both position formats read as a float4 with w = 1.
+// The octahedral normal is decoded here and lit by the sun from the lighting constants. Normals go
+// through the cofactor of the model matrix, which stays correct under the non-uniform scale of a
+// quantized mesh's dequantization transform.
+const char* g_thePackedLitShaderSource = R"(
+struct vs_input_t
+{
+	float4 localPosition : POSITION;
+	float2 octahedralNormal : NORMAL;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+};
+
+struct v2p_t
+{
+	float4 position : SV_Position;
+	float3 worldNormal : NORMAL;
+	float4 color : COLOR;
+	float2 uv : TEXCOORD;
+};
+
+cbuffer LightingConstants : register(b1)
+{
+	float3 sunDirection;
+	float sunIntensity;
+	float ambientIntensity;
+	float3 sunDirectionPadding;
+};
+
+cbuffer CameraConstants : register(b2)
+{
+	float4x4 projectionMatrix;
+	float4x4 viewMatrix;
+};
+
+cbuffer ModelConstants : register(b3)
+{
+	float4x4 modelMatrix;
+	float4 modelColor;
+};
+
+Texture2D diffuseTexture : register(t0);
+
+SamplerState diffuseSampler : register(s0);
+
+float3 DecodeOctahedralNormal(float2 e)
+{
+	float3 n = float3(e.x, e.y, 1 - abs(e.x) - abs(e.y));
+	float t = saturate(-n.z);
+	n.xy += (n.xy >= 0) ? -t : t;
+	return normalize(n);
+}
+
+v2p_t VertexMain(vs_input_t input)
+{
+	v2p_t v2p;
+	float4 modelPosition = mul(modelMatrix, float4(input.localPosition.xyz, 1));
+	float4 viewPosition = mul(viewMatrix, modelPosition);
+	v2p.position = mul(projectionMatrix, viewPosition);
+
+	float3 localNormal = DecodeOctahedralNormal(input.octahedralNormal);
+	float3x3 basis = (float3x3)transpose(modelMatrix);	// Rows are the model's i, j and k basis
+	float3 worldNormal = cross(basis[1], basis[2]) * localNormal.x + cross(basis[2], basis[0]) * localNormal.y + cross(basis[0], basis[1]) * localNormal.z;
+	v2p.worldNormal = normalize(worldNormal);
+
+	v2p.color = input.color * modelColor;
+	v2p.uv = input.uv;
+	return v2p;
+}
+
+float4 PixelMain(v2p_t input) : SV_Target0
+{
+	float3 normal = normalize(input.worldNormal);
+	float diffuse = ambientIntensity + sunIntensity * saturate(dot(normal, -sunDirection));
+	float4 color = diffuseTexture.Sample(diffuseSampler, input.uv);
+	color *= input.color;
+	if (color.a < 0.001) discard;
+	return float4(color.rgb * diffuse, color.a);
+}
+)";
@@ -2,7 +2,9 @@
 
 #include "Engine/Renderer/IndexBuffer.hpp"
 
+#if !defined(ENGINE_NULL_RENDERER)
 #include <d3d11.h>
+#endif
 
 IndexBuffer::IndexBuffer(size_t size) :
 	m_size(size)
@@ -0,0 +1,26 @@
+#include "Engine/Renderer/InstanceBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+#if !defined(ENGINE_NULL_RENDERER)
+#include <d3d11.h>
+#endif
+
+InstanceBuffer::InstanceBuffer(int maxInstances) :
+	m_maxInstances(maxInstances)
+{
+}
+
+InstanceBuffer::~InstanceBuffer()
+{
+	DX_SAFE_RELEASE(m_buffer);
+}
+
+int InstanceBuffer::GetMaxInstances() const
+{
+	return m_maxInstances;
+}
+
+unsigned int InstanceBuffer::GetStride() const
+{
+	return sizeof(Instance2D);
+}
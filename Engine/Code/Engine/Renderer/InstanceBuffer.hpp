@@ -0,0 +1,37 @@
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+struct ID3D11Buffer;
+
+
+//--------------------------------------------------------------------------------------------------
+// Per-instance data for Renderer::DrawInstanced2D. Each instance is the unit quad (0,0)-(1,1),
+// scaled then moved, with its color multiplied into the quad's.
+struct Instance2D
+{
+	Vec2	m_translation = Vec2(0.f, 0.f);
+	Vec2	m_scale = Vec2(1.f, 1.f);
+	Rgba8	m_color = Rgba8::WHITE;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// A GPU-only array of Instance2D. It is never mapped; Renderer::UpdateInstances copies just the
+// given range in, so changing a few instances of a big buffer costs only those few.
+class InstanceBuffer
+{
+	friend class Renderer;
+
+public:
+	InstanceBuffer(int maxInstances);
+	InstanceBuffer(InstanceBuffer const& copy) = delete;
+	virtual ~InstanceBuffer();
+
+	int				GetMaxInstances() const;
+	unsigned int	GetStride() const;
+
+public:
+	ID3D11Buffer*	m_buffer = nullptr;
+	int				m_maxInstances = 0;
+};
@@ -0,0 +1,438 @@
+#include "Engine/Renderer/Renderer.hpp"
+
+#if defined(ENGINE_NULL_RENDERER)
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/DefaultShader.hpp"
+#include "Engine/Renderer/ConstantBuffer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/InstanceBuffer.hpp"
+
+#include <string.h>
+
+// The headless backend, built instead of Renderer.cpp when ENGINE_NULL_RENDERER is defined. It has
+// no device, window or shader compiler; every call does the same CPU work the D3D11 backend does
+// (recording, sorting and batching draws, building constants) and then only counts what it would
+// have sent to the GPU in RendererDrawStats and RendererUploadStats. With
+// RendererConfig::m_checksumDrawData set it also hashes every flushed vert and index, so a
+// benchmark run can check it is still submitting the same frames.
+
+static unsigned long long const s_fnvPrime = 1099511628211ULL;
+
+static unsigned long long HashBytes(unsigned long long hash, void const* data, size_t size)
+{
+	unsigned char const* bytes = (unsigned char const*)data;
+	for (size_t byteIndex = 0; byteIndex < size; ++byteIndex)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= s_fnvPrime;
+	}
+	return hash;
+}
+
+Renderer::Renderer(RendererConfig const& config) :
+	m_config(config)
+{
+}
+
+Renderer::~Renderer()
+{
+
+}
+
+void Renderer::Startup()
+{
+	Shader* shader = CreateShader("Default", g_theShaderSource);
+	m_defaultShader = shader;
+	BindShader(shader);
+	m_defaultInstanced2DShader = CreateShader("DefaultInstanced2D", g_theInstanced2DShaderSource, VERTEX_TYPE_PCU_INSTANCED_2D);
+	CreateShader("DefaultPackedLit", g_thePackedLitShaderSource, VERTEX_TYPE_PNCU_PACKED);
+	CreateShader("DefaultPackedLit", g_thePackedLitShaderSource, VERTEX_TYPE_PNCU_QUANTIZED);
+
+	Image defaultImage = Image(IntVec2(1, 1), Rgba8(255, 255, 255));
+	defaultImage.m_imageFilePath = "DEFAULT";
+	m_defaultTexture = CreateTextureFromImage(defaultImage);
+	BindTexture(m_defaultTexture);
+
+	m_ringVBO = CreateVertexBuffer(DEFAULT_RING_VBO_SIZE);
+	m_ringIBO = CreateIndexBuffer(DEFAULT_RING_IBO_SIZE);
+	m_unitQuadVBO = CreateVertexBuffer(sizeof(Vertex_PCU) * 4, sizeof(Vertex_PCU));
+	m_unitQuadIBO = CreateIndexBuffer(sizeof(unsigned int) * 6);
+	m_cameraCBO = CreateConstantBuffer(sizeof(Mat44) * 2);
+	m_modelCBO = CreateConstantBuffer(sizeof(ModelConstants));
+	m_lightingCBO = CreateConstantBuffer(sizeof(m_lights));
+
+	// Nothing is bound yet, so the first draw counts every state as a change like it would on a device
+	m_nullBoundState.m_blendMode = BlendMode::COUNT;
+	m_nullBoundState.m_samplerMode = SamplerMode::COUNT;
+	m_nullBoundState.m_rasterizerMode = RasterizerMode::COUNT;
+	m_nullBoundState.m_depthMode = DepthMode::COUNT;
+
+	SetModelConstants();
+}
+
+void Renderer::BeginFrame()
+{
+	m_uploadStats = RendererUploadStats();
+	m_drawStats = RendererDrawStats();
+	UpdateTextureStreaming();
+}
+
+void Renderer::EndFrame()
+{
+	FlushDrawCommands();
+	m_lastFrameUploadStats = m_uploadStats;
+	m_lastFrameDrawStats = m_drawStats;
+}
+
+void Renderer::Shutdown()
+{
+	FinishTextureLoads();
+
+	for (int shaderIndex = 0; shaderIndex < (int)m_loadedShaders.size(); ++shaderIndex)
+	{
+		delete m_loadedShaders[shaderIndex];
+		m_loadedShaders[shaderIndex] = nullptr;
+	}
+
+	m_currentShader = nullptr;
+	m_boundShader = nullptr;
+	m_currentTexture = nullptr;
+	m_boundTexture = nullptr;
+
+	for (int bitmapFontIndex = 0; bitmapFontIndex < (int)m_loadedFonts.size(); ++bitmapFontIndex)
+	{
+		delete m_loadedFonts[bitmapFontIndex];
+		m_loadedFonts[bitmapFontIndex] = nullptr;
+	}
+
+	for (int textureIndex = 0; textureIndex < (int)m_loadedTextures.size(); ++textureIndex)
+	{
+		delete m_loadedTextures[textureIndex];
+		m_loadedTextures[textureIndex] = nullptr;
+	}
+
+	m_loadedShaders.clear();
+	m_loadedTextures.clear();
+	m_loadedFonts.clear();
+	m_shaderIDs.clear();
+	m_textureIDs.clear();
+	m_bitmapFontIDs.clear();
+	delete m_defaultTexture;
+	m_defaultTexture = nullptr;
+
+	delete m_ringVBO;
+	m_ringVBO = nullptr;
+	delete m_ringIBO;
+	m_ringIBO = nullptr;
+	delete m_unitQuadVBO;
+	m_unitQuadVBO = nullptr;
+	delete m_unitQuadIBO;
+	m_unitQuadIBO = nullptr;
+	delete m_cameraCBO;
+	m_cameraCBO = nullptr;
+	delete m_modelCBO;
+	m_modelCBO = nullptr;
+	delete m_lightingCBO;
+	m_lightingCBO = nullptr;
+}
+
+void Renderer::ClearScreen(Rgba8 const& clearColor)
+{
+	(void)clearColor;
+	FlushDrawCommands();
+}
+
+void Renderer::BeginCamera(Camera const& camera)
+{
+	FlushDrawCommands();
+	m_isRecordingDrawCommands = m_config.m_batchDrawCommands;
+
+	Mat44 camConstants[2] = { camera.GetProjectionMatrix(), camera.GetViewMatrix() };
+	CopyCPUToGPU(camConstants, sizeof(camConstants), m_cameraCBO);
+}
+
+void Renderer::EndCamera(Camera const& camera)
+{
+	(void)camera;
+	FlushDrawCommands();
+	m_isRecordingDrawCommands = false;
+}
+
+// Same shape as the D3D11 flush, with a CPU array standing in for the index ring. The verts and
+// indexes count as one map each, like the rings.
+void Renderer::FlushDrawCommands()
+{
+	if (m_drawCommands.empty())
+	{
+		return;
+	}
+
+	size_t numPCUBytes = sizeof(Vertex_PCU) * m_drawVertsPCU.size();
+	size_t numPNCUBytes = sizeof(Vertex_PNCU) * m_drawVertsPNCU.size();
+	size_t numIndexBytes = sizeof(unsigned int) * m_drawIndexes.size();
+
+	m_nullSortedIndexes.resize(m_drawIndexes.size());
+	BatchDrawCommands(m_nullSortedIndexes.data(), 0);
+	m_uploadStats.m_numMaps += 2;
+	m_uploadStats.m_numBytesUploaded += numPCUBytes + numPNCUBytes + numIndexBytes;
+
+	if (m_config.m_checksumDrawData)
+	{
+		unsigned long long checksum = m_drawStats.m_checksum;
+		checksum = HashBytes(checksum, m_drawVertsPCU.data(), numPCUBytes);
+		checksum = HashBytes(checksum, m_drawVertsPNCU.data(), numPNCUBytes);
+		checksum = HashBytes(checksum, m_nullSortedIndexes.data(), numIndexBytes);
+		m_drawStats.m_checksum = checksum;
+	}
+
+	for (int batchIndex = 0; batchIndex < (int)m_drawBatches.size(); ++batchIndex)
+	{
+		ApplyDrawState(m_drawCommands[m_drawBatches[batchIndex].m_commandIndex]);
+		++m_drawStats.m_numDrawCalls;
+	}
+
+	ResetDrawCommands();
+}
+
+void Renderer::ApplyDrawState(DrawCommand const& command)
+{
+	if (command.m_shader != m_boundShader)
+	{
+		m_boundShader = command.m_shader;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	if (command.m_texture != m_boundTexture)
+	{
+		m_boundTexture = command.m_texture;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	if (command.m_modelConstantsIndex != m_boundModelConstantsIndex)
+	{
+		CopyCPUToGPU(&m_drawModelConstants[command.m_modelConstantsIndex], sizeof(ModelConstants), m_modelCBO);
+		m_boundModelConstantsIndex = command.m_modelConstantsIndex;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	SetStatesIfChanged(command.m_blendMode, command.m_samplerMode, command.m_rasterizerMode, command.m_depthMode);
+}
+
+void Renderer::InitializeTextureFromImage(Texture& texture, Image const& image)
+{
+	texture.m_dimensions = image.GetDimensions();
+}
+
+Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource, VertexType vertexType)
+{
+	(void)shaderSource;
+	ShaderConfig shaderConfig;
+	shaderConfig.m_name = shaderName;
+	shaderConfig.m_vertexType = GetShaderVertexType(shaderName, vertexType);
+
+
+	Shader* shader = new Shader(shaderConfig);
+	AddLoadedShader(shader);
+	return shader;
+}
+
+bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target)
+{
+	(void)name;
+	(void)source;
+	(void)entryPoint;
+	(void)target;
+	outByteCode.clear();
+	return true;
+}
+
+VertexBuffer* Renderer::CreateVertexBuffer(size_t const size)
+{
+	return new VertexBuffer(size);
+}
+
+VertexBuffer* Renderer::CreateVertexBuffer(size_t const size, unsigned int stride)
+{
+	return new VertexBuffer(size, stride);
+}
+
+IndexBuffer* Renderer::CreateIndexBuffer(size_t const size)
+{
+	return new IndexBuffer(size);
+}
+
+void Renderer::CopyCPUToGPU(void const* data, size_t size, VertexBuffer*& vbo)
+{
+	(void)data;
+	if (vbo->m_size < size)
+	{
+		vbo->m_size = size;
+	}
+	++m_uploadStats.m_numMaps;
+	m_uploadStats.m_numBytesUploaded += size;
+}
+
+void Renderer::CopyCPUToGPU(void const* data, size_t size, IndexBuffer*& ibo)
+{
+	(void)data;
+	if (ibo->m_size < size)
+	{
+		ibo->m_size = size;
+	}
+	++m_uploadStats.m_numMaps;
+	m_uploadStats.m_numBytesUploaded += size;
+}
+
+void Renderer::BindVertexBuffer(VertexBuffer* vbo)
+{
+	(void)vbo;
+	FlushDrawCommands();
+}
+
+void Renderer::BindIndexBuffer(IndexBuffer* ibo)
+{
+	(void)ibo;
+	FlushDrawCommands();
+}
+
+ConstantBuffer* Renderer::CreateConstantBuffer(size_t const size)
+{
+	return new ConstantBuffer(size);
+}
+
+void Renderer::CopyCPUToGPU(void const* data, size_t size, ConstantBuffer*& cbo)
+{
+	(void)data;
+	(void)cbo;
+	++m_uploadStats.m_numMaps;
+	m_uploadStats.m_numBytesUploaded += size;
+}
+
+void Renderer::BindConstantBuffer(int slot, ConstantBuffer* cbo)
+{
+	(void)slot;
+	(void)cbo;
+}
+
+void Renderer::DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, int vertexOffset)
+{
+	(void)vertexCount;
+	(void)vertexOffset;
+	BindVertexBuffer(vbo);
+	ApplyDrawState(GetCurrentDrawCommand());
+	++m_drawStats.m_numDrawCalls;
+}
+
+void Renderer::DrawVertexAndIndexBuffer(VertexBuffer* vbo, IndexBuffer* ibo, int indexCount, int indexOffset, int vertexOffset)
+{
+	(void)indexCount;
+	(void)indexOffset;
+	(void)vertexOffset;
+	BindVertexBuffer(vbo);
+	BindIndexBuffer(ibo);
+	ApplyDrawState(GetCurrentDrawCommand());
+	++m_drawStats.m_numDrawCalls;
+}
+
+void Renderer::DrawIndexed(int indexCount, int indexOffset, int vertexOffset)
+{
+	(void)indexCount;
+	(void)indexOffset;
+	(void)vertexOffset;
+	ApplyDrawState(GetCurrentDrawCommand());
+	++m_drawStats.m_numDrawCalls;
+}
+
+InstanceBuffer* Renderer::CreateInstanceBuffer(int maxInstances)
+{
+	GUARANTEE_OR_DIE(maxInstances > 0, "An instance buffer needs room for at least one instance");
+	return new InstanceBuffer(maxInstances);
+}
+
+void Renderer::UpdateInstances(InstanceBuffer* instanceBuffer, int firstInstance, int numInstances, Instance2D const* instances)
+{
+	(void)instances;
+	GUARANTEE_OR_DIE(firstInstance >= 0 && firstInstance + numInstances <= instanceBuffer->m_maxInstances, "Instance update is out of the instance buffer's range");
+	if (numInstances <= 0)
+	{
+		return;
+	}
+	m_uploadStats.m_numBytesUploaded += sizeof(Instance2D) * numInstances;
+}
+
+void Renderer::DrawInstanced2D(InstanceBuffer* instanceBuffer, int numInstances, int firstInstance)
+{
+	(void)instanceBuffer;
+	(void)firstInstance;
+	FlushDrawCommands();
+	if (numInstances <= 0)
+	{
+		return;
+	}
+
+	DrawCommand command = GetCurrentDrawCommand();
+	if (command.m_shader == m_defaultShader)
+	{
+		command.m_shader = m_defaultInstanced2DShader;
+	}
+	ApplyDrawState(command);
+	++m_drawStats.m_numDrawCalls;
+}
+
+void Renderer::CreateAndInitializeBlendModes()
+{
+}
+
+void Renderer::CreateSamplerModes()
+{
+}
+
+void Renderer::CreateRasterizerMode()
+{
+}
+
+void Renderer::CreateDepthMode()
+{
+}
+
+void Renderer::SetStatesIfChanged(BlendMode blendMode, SamplerMode samplerMode, RasterizerMode rasterizerMode, DepthMode depthMode)
+{
+	if (blendMode != m_nullBoundState.m_blendMode)
+	{
+		m_nullBoundState.m_blendMode = blendMode;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	if (samplerMode != m_nullBoundState.m_samplerMode)
+	{
+		m_nullBoundState.m_samplerMode = samplerMode;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	if (rasterizerMode != m_nullBoundState.m_rasterizerMode)
+	{
+		m_nullBoundState.m_rasterizerMode = rasterizerMode;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	if (depthMode != m_nullBoundState.m_depthMode)
+	{
+		m_nullBoundState.m_depthMode = depthMode;
+		++m_drawStats.m_numStateChanges;
+	}
+}
+
+void Renderer::SetLightingConstants(Vec3 const& sunDirection, float sunIntensity, float ambientIntensity)
+{
+	(void)sunDirection;
+	(void)sunIntensity;
+	(void)ambientIntensity;
+	FlushDrawCommands();
+	CopyCPUToGPU(m_lights, sizeof(m_lights), m_lightingCBO);
+}
+
+#endif // defined(ENGINE_NULL_RENDERER)
@@ -1,4 +1,6 @@
 #include "Engine/Renderer/Renderer.hpp"
+
+#if !defined(ENGINE_NULL_RENDERER)
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Renderer/Texture.hpp"
@@ -7,6 +9,7 @@
 #include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/InstanceBuffer.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Core/StringUtils.hpp"
 #include "ThirdParty/stb/stb_image.h"
@@ -51,13 +54,81 @@ struct CameraConstants
 
 static int const s_cameraConstantsSlot = 2;
 
-struct ModelConstants
+static int const s_modelConstantsSlot = 3;
+
+//--------------------------------------------------------------------------------------------------
+// Input layouts for each VertexType, in the same order as the vertex struct's members. Half UVs come
+// in as R16G16_FLOAT, quantized positions as R16G16B16A16_UNORM and octahedral normals as R16G16_SNORM.
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPCU[] =
 {
-	Mat44 modelMatrix;
-	float modelColor[4];
+	{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
 };
 
-static int const s_modelConstantsSlot = 3;
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPNCU[] =
+{
+	{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+};
+
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPCUPacked[] =
+{
+	{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+};
+
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPCUQuantized[] =
+{
+	{"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+};
+
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPNCUPacked[] =
+{
+	{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+};
+
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPNCUQuantized[] =
+{
+	{"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+};
+
+static D3D11_INPUT_ELEMENT_DESC const s_inputLayoutPCUInstanced2D[] =
+{
+	{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+	{"INSTANCE_TRANSFORM", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+	{"INSTANCE_COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+};
+
+struct InputLayoutDesc
+{
+	D3D11_INPUT_ELEMENT_DESC const* m_elements;
+	unsigned int m_numElements;
+};
+
+static InputLayoutDesc const s_inputLayouts[VERTEX_TYPE_COUNT] =
+{
+	{ s_inputLayoutPCU,				_countof(s_inputLayoutPCU) },
+	{ s_inputLayoutPNCU,			_countof(s_inputLayoutPNCU) },
+	{ s_inputLayoutPCUPacked,		_countof(s_inputLayoutPCUPacked) },
+	{ s_inputLayoutPCUQuantized,	_countof(s_inputLayoutPCUQuantized) },
+	{ s_inputLayoutPNCUPacked,		_countof(s_inputLayoutPNCUPacked) },
+	{ s_inputLayoutPNCUQuantized,	_countof(s_inputLayoutPNCUQuantized) },
+	{ s_inputLayoutPCUInstanced2D,	_countof(s_inputLayoutPCUInstanced2D) },
+};
 
 Renderer::Renderer(RendererConfig const& config) :
 	m_config(config)
@@ -142,15 +213,30 @@ void Renderer::Startup()
 	// Shader* shader = CreateShader("Data/Shaders/Default");
 	m_defaultShader = shader;
 	BindShader(shader);
+	m_defaultInstanced2DShader = CreateShader("DefaultInstanced2D", g_theInstanced2DShaderSource, VERTEX_TYPE_PCU_INSTANCED_2D);
+	CreateShader("DefaultPackedLit", g_thePackedLitShaderSource, VERTEX_TYPE_PNCU_PACKED);
+	CreateShader("DefaultPackedLit", g_thePackedLitShaderSource, VERTEX_TYPE_PNCU_QUANTIZED);
 
 	Image defaultImage = Image(IntVec2(1, 1), Rgba8(255, 255, 255));
 	defaultImage.m_imageFilePath = "DEFAULT";
 	m_defaultTexture = CreateTextureFromImage(defaultImage);
 	BindTexture(m_defaultTexture);
 
-	m_immediateVBO = CreateVertexBuffer(sizeof(Vertex_PCU), sizeof(Vertex_PCU));
-	m_immediatePNCUVBO = CreateVertexBuffer(sizeof(Vertex_PNCU), sizeof(Vertex_PNCU));
-	m_immediateIBO = CreateIndexBuffer(sizeof(unsigned int));
+	m_ringVBO = CreateVertexBuffer(DEFAULT_RING_VBO_SIZE);
+	m_ringIBO = CreateIndexBuffer(DEFAULT_RING_IBO_SIZE);
+
+	Vertex_PCU unitQuadVerts[4] =
+	{
+		Vertex_PCU(Vec3(0.f, 0.f, 0.f), Rgba8::WHITE, Vec2(0.f, 0.f)),
+		Vertex_PCU(Vec3(1.f, 0.f, 0.f), Rgba8::WHITE, Vec2(1.f, 0.f)),
+		Vertex_PCU(Vec3(1.f, 1.f, 0.f), Rgba8::WHITE, Vec2(1.f, 1.f)),
+		Vertex_PCU(Vec3(0.f, 1.f, 0.f), Rgba8::WHITE, Vec2(0.f, 1.f)),
+	};
+	unsigned int unitQuadIndexes[6] = { 0, 1, 2, 0, 2, 3 };
+	m_unitQuadVBO = CreateVertexBuffer(sizeof(unitQuadVerts), sizeof(Vertex_PCU));
+	CopyCPUToGPU(unitQuadVerts, sizeof(unitQuadVerts), m_unitQuadVBO);
+	m_unitQuadIBO = CreateIndexBuffer(sizeof(unitQuadIndexes));
+	CopyCPUToGPU(unitQuadIndexes, sizeof(unitQuadIndexes), m_unitQuadIBO);
 	m_cameraCBO = CreateConstantBuffer(sizeof(CameraConstants));
 	m_modelCBO = CreateConstantBuffer(sizeof(ModelConstants));
 	m_lightingCBO = CreateConstantBuffer(sizeof(LightingConstants));
@@ -191,11 +277,17 @@ void Renderer::Startup()
 
 void Renderer::BeginFrame()
 {
+	m_uploadStats = RendererUploadStats();
+	m_drawStats = RendererDrawStats();
 	m_d3d11DeviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+	UpdateTextureStreaming();
 }
 
 void Renderer::EndFrame()
 {
+	FlushDrawCommands();
+	m_lastFrameUploadStats = m_uploadStats;
+	m_lastFrameDrawStats = m_drawStats;
 	HRESULT hResult = m_swapChain->Present(0, 0);
 	if (hResult == DXGI_ERROR_DEVICE_REMOVED || hResult == DXGI_ERROR_DEVICE_RESET)
 	{
@@ -205,6 +297,8 @@ void Renderer::EndFrame()
 
 void Renderer::Shutdown()
 {
+	FinishTextureLoads();
+
 	for (int samplerIndex = 0; samplerIndex < int(SamplerMode::COUNT); ++samplerIndex)
 	{
 		DX_SAFE_RELEASE(m_samplerStates[samplerIndex]);
@@ -235,21 +329,39 @@ void Renderer::Shutdown()
 	}
 
 	m_currentShader = nullptr;
+	m_boundShader = nullptr;
+	m_currentTexture = nullptr;
+	m_boundTexture = nullptr;
 	
+	for (int bitmapFontIndex = 0; bitmapFontIndex < m_loadedFonts.size(); ++bitmapFontIndex)
+	{
+		delete m_loadedFonts[bitmapFontIndex];
+		m_loadedFonts[bitmapFontIndex] = nullptr;
+	}
+
 	for (int textureIndex = 0; textureIndex < m_loadedTextures.size(); ++textureIndex)
 	{
 		delete m_loadedTextures[textureIndex];
 		m_loadedTextures[textureIndex] = nullptr;
 	}
+
+	m_loadedShaders.clear();
+	m_loadedTextures.clear();
+	m_loadedFonts.clear();
+	m_shaderIDs.clear();
+	m_textureIDs.clear();
+	m_bitmapFontIDs.clear();
 	delete m_defaultTexture;
 	m_defaultTexture = nullptr;
 
-	delete m_immediateVBO;
-	m_immediateVBO = nullptr;
-	delete m_immediatePNCUVBO;
-	m_immediatePNCUVBO = nullptr;
-	delete m_immediateIBO;
-	m_immediateIBO = nullptr;
+	delete m_ringVBO;
+	m_ringVBO = nullptr;
+	delete m_ringIBO;
+	m_ringIBO = nullptr;
+	delete m_unitQuadVBO;
+	m_unitQuadVBO = nullptr;
+	delete m_unitQuadIBO;
+	m_unitQuadIBO = nullptr;
 	delete m_cameraCBO;
 	m_cameraCBO = nullptr;
 	delete m_modelCBO;
@@ -270,6 +382,7 @@ void Renderer::Shutdown()
 
 void Renderer::ClearScreen(Rgba8 const& clearColor)
 {
+	FlushDrawCommands();
 	float clearColorAsFloats[4] = {};
 	clearColor.GetAsFloats(clearColorAsFloats);
 	m_d3d11DeviceContext->ClearRenderTargetView(m_renderTargetView, clearColorAsFloats);
@@ -278,6 +391,9 @@ void Renderer::ClearScreen(Rgba8 const& clearColor)
 
 void Renderer::BeginCamera(Camera const& camera)
 {
+	FlushDrawCommands();
+	m_isRecordingDrawCommands = m_config.m_batchDrawCommands;
+
 	Mat44 projectionMat = camera.GetProjectionMatrix();
 	Mat44 viewMat = camera.GetViewMatrix();
 	CameraConstants camConstants = {};
@@ -319,81 +435,150 @@ void Renderer::BeginCamera(Camera const& camera)
 void Renderer::EndCamera(Camera const& camera)
 {
 	(void)camera;
+	FlushDrawCommands();
+	m_isRecordingDrawCommands = false;
 }
 
-void Renderer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes)
+// Draws every recorded command. All verts go into the vertex ring in one map, BatchDrawCommands
+// writes the sorted indexes straight into the index ring in another, and then each batch is one
+// DrawIndexed at its offset in the rings.
+void Renderer::FlushDrawCommands()
 {
-	CopyCPUToGPU(vertexes, (size_t)m_immediateVBO->GetStride() * numVertexes, m_immediateVBO);
-	DrawVertexBuffer(m_immediateVBO, numVertexes);
-}
+	if (m_drawCommands.empty())
+	{
+		return;
+	}
 
-void Renderer::DrawVertexArray(std::vector<Vertex_PCU> const& vertexes)
-{
-	int numVertexes = (int)vertexes.size();
-	CopyCPUToGPU(vertexes.data(), (size_t)m_immediateVBO->GetStride() * numVertexes, m_immediateVBO);
-	DrawVertexBuffer(m_immediateVBO, numVertexes);
-}
+	size_t numPCUBytes = sizeof(Vertex_PCU) * m_drawVertsPCU.size();
+	size_t numPNCUBytes = sizeof(Vertex_PNCU) * m_drawVertsPNCU.size();
+	size_t numVertexBytes = numPCUBytes + numPNCUBytes;
+	size_t numIndexBytes = sizeof(unsigned int) * m_drawIndexes.size();
 
-void Renderer::DrawIndexedArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes)
-{
-	SetStatesIfChanged();
-	CopyCPUToGPU(vertexes, (size_t)m_immediateVBO->GetStride() * numVertexes, m_immediateVBO);
-	BindVertexBuffer(m_immediateVBO);
-	CopyCPUToGPU(indexes, (size_t)m_immediateIBO->GetStride() * numIndexes, m_immediateIBO);
-	BindIndexBuffer(m_immediateIBO);
+	// Grow geometrically so a scene that keeps getting bigger only recreates the rings a few times
+	if (numVertexBytes > m_ringVBO->m_size)
+	{
+		size_t newSize = m_ringVBO->m_size;
+		while (newSize < numVertexBytes)
+		{
+			newSize *= 2;
+		}
+		delete m_ringVBO;
+		m_ringVBO = CreateVertexBuffer(newSize);
+		m_ringVBOWriteOffset = 0;
+		++m_uploadStats.m_numGrows;
+	}
+	if (numIndexBytes > m_ringIBO->m_size)
+	{
+		size_t newSize = m_ringIBO->m_size;
+		while (newSize < numIndexBytes)
+		{
+			newSize *= 2;
+		}
+		delete m_ringIBO;
+		m_ringIBO = CreateIndexBuffer(newSize);
+		m_ringIBOWriteOffset = 0;
+		++m_uploadStats.m_numGrows;
+	}
 
-	DrawIndexed(numIndexes);
-}
+	size_t vertexOffset = 0;
+	unsigned char* vertexData = (unsigned char*)MapRingBuffer(m_ringVBO->m_buffer, m_ringVBO->m_size, m_ringVBOWriteOffset, numVertexBytes, vertexOffset);
+	if (numPCUBytes > 0)
+	{
+		memcpy(vertexData, m_drawVertsPCU.data(), numPCUBytes);
+	}
+	if (numPNCUBytes > 0)
+	{
+		memcpy(vertexData + numPCUBytes, m_drawVertsPNCU.data(), numPNCUBytes);
+	}
+	m_d3d11DeviceContext->Unmap(m_ringVBO->m_buffer, NULL);
 
-void Renderer::DrawIndexedArray(int numVertexes, Vertex_PNCU const* vertexes, int numIndexes, unsigned int const* indexes)
-{
-	SetStatesIfChanged();
-	CopyCPUToGPU(vertexes, (size_t)m_immediatePNCUVBO->GetStride() * numVertexes, m_immediatePNCUVBO);
-	BindVertexBuffer(m_immediatePNCUVBO);
-	CopyCPUToGPU(indexes, (size_t)m_immediateIBO->GetStride() * numIndexes, m_immediateIBO);
-	BindIndexBuffer(m_immediateIBO);
+	size_t indexOffset = 0;
+	unsigned int* indexData = (unsigned int*)MapRingBuffer(m_ringIBO->m_buffer, m_ringIBO->m_size, m_ringIBOWriteOffset, numIndexBytes, indexOffset);
+	BatchDrawCommands(indexData, (int)(indexOffset / sizeof(unsigned int)));
+	m_d3d11DeviceContext->Unmap(m_ringIBO->m_buffer, NULL);
 
-	DrawIndexed(numIndexes);
-}
+	m_d3d11DeviceContext->IASetIndexBuffer(m_ringIBO->m_buffer, DXGI_FORMAT_R32_UINT, 0);
+	m_d3d11DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
+	DrawVertexStream boundVertexStream = DRAW_VERTEX_STREAM_COUNT;
+	for (int batchIndex = 0; batchIndex < (int)m_drawBatches.size(); ++batchIndex)
+	{
+		DrawBatch const& batch = m_drawBatches[batchIndex];
+		DrawCommand const& command = m_drawCommands[batch.m_commandIndex];
+		ApplyDrawState(command);
+		if (command.m_vertexStream != boundVertexStream)
+		{
+			bool isPCU = command.m_vertexStream == DRAW_VERTEX_STREAM_PCU;
+			unsigned int vertexStride = isPCU ? sizeof(Vertex_PCU) : sizeof(Vertex_PNCU);
+			unsigned int offset = (unsigned int)(isPCU ? vertexOffset : vertexOffset + numPCUBytes);
+			m_d3d11DeviceContext->IASetVertexBuffers(0, 1, &m_ringVBO->m_buffer, &vertexStride, &offset);
+			boundVertexStream = command.m_vertexStream;
+		}
+		m_d3d11DeviceContext->DrawIndexed(batch.m_numIndexes, command.m_firstIndex, 0);
+		++m_drawStats.m_numDrawCalls;
+	}
+
+	ResetDrawCommands();
+}
 
-Texture* Renderer::CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, unsigned char* texelData)
+// Returns a pointer to where the data goes; out_offset is that spot's byte offset in the buffer.
+// Writing at the front of a ring uses DISCARD, which hands back fresh memory while the GPU finishes
+// with the old; every other write lands past everything written since, so NO_OVERWRITE is safe
+// and the map never waits on the GPU.
+void* Renderer::MapRingBuffer(ID3D11Buffer* buffer, size_t bufferSize, size_t& writeOffset, size_t size, size_t& out_offset)
 {
-	// Check if the load was successful
-	GUARANTEE_OR_DIE(texelData, Stringf("CreateTextureFromData failed for \"%s\" - texelData was null!", name));
-	GUARANTEE_OR_DIE(bytesPerTexel >= 3 && bytesPerTexel <= 4, Stringf("CreateTextureFromData failed for \"%s\" - unsupported BPP=%i (must be 3 or 4)", name, bytesPerTexel));
-	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("CreateTextureFromData failed for \"%s\" - illegal texture dimensions (%i x %i)", name, dimensions.x, dimensions.y));
+	if (writeOffset + size > bufferSize)
+	{
+		writeOffset = 0;
+		++m_uploadStats.m_numWraps;
+	}
 
-	Texture* newTexture = new Texture();
-	newTexture->m_name = name; // NOTE: m_name must be a std::string, otherwise it may point to temporary data!
-	newTexture->m_dimensions = dimensions;
+	D3D11_MAP mapType = writeOffset == 0 ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+	D3D11_MAPPED_SUBRESOURCE mappedSubresource;
+	HRESULT hResult = m_d3d11DeviceContext->Map(buffer, NULL, mapType, NULL, &mappedSubresource);
+	if (!SUCCEEDED(hResult))
+	{
+		ERROR_AND_DIE("Could not map the ring buffer");
+	}
 
-	return newTexture;
+	out_offset = writeOffset;
+	writeOffset += size;
+	++m_uploadStats.m_numMaps;
+	m_uploadStats.m_numBytesUploaded += size;
+	return (unsigned char*)mappedSubresource.pData + out_offset;
 }
 
-
-void Renderer::BindTexture(Texture const* texture)
+void Renderer::ApplyDrawState(DrawCommand const& command)
 {
-	if (texture == nullptr)
+	if (command.m_shader != m_boundShader)
 	{
-		texture = m_defaultTexture;
+		m_d3d11DeviceContext->IASetInputLayout(command.m_shader->m_inputLayout);
+		m_d3d11DeviceContext->VSSetShader(command.m_shader->m_vertexShader, NULL, NULL);
+		m_d3d11DeviceContext->PSSetShader(command.m_shader->m_pixelShader, NULL, NULL);
+		m_boundShader = command.m_shader;
+		++m_drawStats.m_numStateChanges;
 	}
-	m_d3d11DeviceContext->PSSetShaderResources(0, 1, &texture->m_shaderResourceView);
-}
 
-Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
-{
-	Image* newImage = new Image(imageFilePath);
-	Texture* newTexture = CreateTextureFromImage(*newImage);
-	if (newTexture != nullptr)
+	if (command.m_texture != m_boundTexture)
+	{
+		m_d3d11DeviceContext->PSSetShaderResources(0, 1, &command.m_texture->m_shaderResourceView);
+		m_boundTexture = command.m_texture;
+		++m_drawStats.m_numStateChanges;
+	}
+
+	if (command.m_modelConstantsIndex != m_boundModelConstantsIndex)
 	{
-		m_loadedTextures.push_back(newTexture);
+		CopyCPUToGPU(&m_drawModelConstants[command.m_modelConstantsIndex], sizeof(ModelConstants), m_modelCBO);
+		BindConstantBuffer(s_modelConstantsSlot, m_modelCBO);
+		m_boundModelConstantsIndex = command.m_modelConstantsIndex;
+		++m_drawStats.m_numStateChanges;
 	}
 
-	return newTexture;
+	SetStatesIfChanged(command.m_blendMode, command.m_samplerMode, command.m_rasterizerMode, command.m_depthMode);
 }
 
-Texture* Renderer::CreateTextureFromImage(Image const& image)
+
+void Renderer::InitializeTextureFromImage(Texture& texture, Image const& image)
 {
 	IntVec2 textureDim = image.GetDimensions();
 	D3D11_TEXTURE2D_DESC texture2DDesc = {};
@@ -416,118 +601,28 @@ Texture* Renderer::CreateTextureFromImage(Image const& image)
 	{
 		ERROR_AND_DIE("We only support RGBA8 for now, format specified here is" + texture2DDesc.Format);
 	}
-	Texture* texture = new Texture;
-	texture->m_dimensions = image.GetDimensions();
-	texture->m_name = image.GetImageFilePath();
+	texture.m_dimensions = image.GetDimensions();
 
 	HRESULT hResult;
-	hResult = m_d3d11Device->CreateTexture2D(&texture2DDesc, &subresourceData, &texture->m_texture);
+	hResult = m_d3d11Device->CreateTexture2D(&texture2DDesc, &subresourceData, &texture.m_texture);
 	if (!SUCCEEDED(hResult))
 	{
 		ERROR_AND_DIE("could not create texture2D");
 	}
-	hResult = m_d3d11Device->CreateShaderResourceView(texture->m_texture, NULL, &texture->m_shaderResourceView);
+	hResult = m_d3d11Device->CreateShaderResourceView(texture.m_texture, NULL, &texture.m_shaderResourceView);
 	if (!SUCCEEDED(hResult))
 	{
 		ERROR_AND_DIE("Could not create a shader Resource View");
 	}
-
-	return texture;
-}
-
-BitmapFont* Renderer::CreateBitmapFont(char const* imageFilePathWithNoExtension)
-{
-	std::string imageFilePathString = imageFilePathWithNoExtension + std::string(".png");
-	char const* imageFilePath = imageFilePathString.c_str();
-	Texture* bitmapFontTexture = CreateTextureFromFile(imageFilePath);
-	BitmapFont* newBitmapFont = new BitmapFont(imageFilePathWithNoExtension, *bitmapFontTexture);
-	return newBitmapFont;
-}
-
-Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
-{
-	// See if we already have this texture previously loaded
-	Texture* existingTexture = GetTextureForFileName(imageFilePath);
-	if (existingTexture)
-	{
-		return existingTexture;
-	}
-
-	// Never seen this texture before!  Let's load it.
-	Texture* newTexture = CreateTextureFromFile(imageFilePath);
-	return newTexture;
-}
-
-BitmapFont* Renderer::CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNoExtension)
-{
-	BitmapFont* existingBitmap = GetBitmapFontForFileName(bitmapFontFilePathWithNoExtension);
-	if (existingBitmap)
-	{
-		return existingBitmap;
-	}
-
-	BitmapFont* newBitmapFont = CreateBitmapFont(bitmapFontFilePathWithNoExtension);
-	return newBitmapFont;
-}
-
-Shader* Renderer::CreateOrGetShader(char const* shaderFilePath)
-{
-	for (int shaderIndex = 0; shaderIndex < m_loadedShaders.size(); ++shaderIndex)
-	{
-		if (m_loadedShaders[shaderIndex]->m_config.m_name == shaderFilePath)
-		{
-			return m_loadedShaders[shaderIndex];
-		}
-	}
-
-	Shader* newShader = CreateShader(shaderFilePath);
-	return newShader;
-}
-
-Texture* Renderer::GetTextureForFileName(char const* imageFilePath)
-{
-	for (int textureIndex = 0; textureIndex < m_loadedTextures.size(); ++textureIndex)
-	{
-		if (m_loadedTextures[textureIndex]->m_name == imageFilePath)
-		{
-			return m_loadedTextures[textureIndex];
-		}
-	}
-
-	return nullptr;
-}
-
-BitmapFont* Renderer::GetBitmapFontForFileName(char const* bitmapFontFilePathWithNoExtension)
-{
-	for (int bitmapFontIndex = 0; bitmapFontIndex < m_loadedFonts.size(); ++bitmapFontIndex)
-	{
-		if (m_loadedFonts[bitmapFontIndex]->m_fontFilePathNameWithNoExtension == bitmapFontFilePathWithNoExtension)
-		{
-			return m_loadedFonts[bitmapFontIndex];
-		}
-	}
-
-	return nullptr;
-}
-
-void Renderer::BindShader(Shader* shader)
-{
-	if (shader == nullptr)
-	{
-		shader = m_defaultShader;
-	}
-
-	m_d3d11DeviceContext->IASetInputLayout(shader->m_inputLayout);
-	m_d3d11DeviceContext->VSSetShader(shader->m_vertexShader, NULL, NULL);
-	m_d3d11DeviceContext->PSSetShader(shader->m_pixelShader, NULL, NULL);
-	m_currentShader = shader;
 }
 
-Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource)
+Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource, VertexType vertexType)
 {
 	HRESULT hResult;
 	ShaderConfig shaderConfig;
 	shaderConfig.m_name = shaderName;
+	shaderConfig.m_vertexType = GetShaderVertexType(shaderName, vertexType);
+
 	
 	Shader* shader = new Shader(shaderConfig);
 
@@ -552,59 +647,17 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource)
 		}
 	}
 
-	std::string isSpriteLit = "Data/Shaders/SpriteLit";
-	if (shaderName == isSpriteLit)
-	{
-		// Input element is a property of a vertex, to give a vertex multiple properties we make an array of vertices like in our case with a array of PCUs
-		D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
-		{
-			{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		}; // organizing the data in a way so that the GPU can understand how our Vertices are laid out in memory
-		hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 4, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
-	}
-	else
-	{
-		// Input element is a property of a vertex, to give a vertex multiple properties we make an array of vertices like in our case with a array of PCUs
-		D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
-		{
-			{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-			{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-		}; // organizing the data in a way so that the GPU can understand how our Vertices are laid out in memory
-		hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 3, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
-	}
 	// Input element is a property of a vertex, to give a vertex multiple properties we make an array of vertices like in our case with a array of PCUs
-	// D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
-	// {
-	// 	{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-	// 	{"COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-	// 	{"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-	// }; // organizing the data in a way so that the GPU can understand how our Vertices are laid out in memory
-
+	InputLayoutDesc const& inputLayout = s_inputLayouts[shaderConfig.m_vertexType];
+	hResult = m_d3d11Device->CreateInputLayout(inputLayout.m_elements, inputLayout.m_numElements, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
 
 	if (!SUCCEEDED(hResult))
 	{
 		ERROR_AND_DIE("Could not create an input layout for how our vertices are laid out in memory")
 	}
 
-	m_loadedShaders.push_back(shader);
-
-	return shader;
-}
+	AddLoadedShader(shader);
 
-Shader* Renderer::CreateShader(char const* shaderName)
-{
-	std::string shaderFilePath = shaderName + std::string(".hlsl");
-	std::string outShaderContents;
-	int shaderItemsRead = FileReadToString(outShaderContents, shaderFilePath);
-	if (shaderItemsRead == 0)
-	{
-		ERROR_AND_DIE("Failed to read the shader file: " + shaderFilePath);
-	}
-	Shader* shader = CreateShader(shaderName, outShaderContents.c_str());
 	return shader;
 }
 
@@ -746,8 +799,11 @@ void Renderer::CopyCPUToGPU(void const* data, size_t size, IndexBuffer*& ibo)
 	m_d3d11DeviceContext->Unmap(ibo->m_buffer, NULL);														// GPU regains access to the buffer, CPU losses access
 }
 
+// Binding a buffer by hand means the next draw uses it, so anything already recorded has to be
+// drawn first or it would end up drawn with this buffer.
 void Renderer::BindVertexBuffer(VertexBuffer* vbo)
 {
+	FlushDrawCommands();
 	unsigned int vertexStride = vbo->GetStride();
 	unsigned int offset = 0;
 	m_d3d11DeviceContext->IASetVertexBuffers(0, 1, &vbo->m_buffer, &vertexStride, &offset);
@@ -756,6 +812,7 @@ void Renderer::BindVertexBuffer(VertexBuffer* vbo)
 
 void Renderer::BindIndexBuffer(IndexBuffer* ibo)
 {
+	FlushDrawCommands();
 	m_d3d11DeviceContext->IASetIndexBuffer(ibo->m_buffer, DXGI_FORMAT_R32_UINT, 0);
 }
 
@@ -799,23 +856,89 @@ void Renderer::BindConstantBuffer(int slot, ConstantBuffer* cbo)
 
 void Renderer::DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, int vertexOffset)
 {
-	SetStatesIfChanged();
 	BindVertexBuffer(vbo);
+	ApplyDrawState(GetCurrentDrawCommand());
 	m_d3d11DeviceContext->Draw(vertexCount, vertexOffset);
+	++m_drawStats.m_numDrawCalls;
 }
 
 void Renderer::DrawVertexAndIndexBuffer(VertexBuffer* vbo, IndexBuffer* ibo, int indexCount, int indexOffset, int vertexOffset)
 {
-	SetStatesIfChanged();
 	BindVertexBuffer(vbo);
 	BindIndexBuffer(ibo);
+	ApplyDrawState(GetCurrentDrawCommand());
 
 	m_d3d11DeviceContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
+	++m_drawStats.m_numDrawCalls;
 }
 
 void Renderer::DrawIndexed(int indexCount, int indexOffset, int vertexOffset)
 {
+	ApplyDrawState(GetCurrentDrawCommand());
 	m_d3d11DeviceContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
+	++m_drawStats.m_numDrawCalls;
+}
+
+InstanceBuffer* Renderer::CreateInstanceBuffer(int maxInstances)
+{
+	GUARANTEE_OR_DIE(maxInstances > 0, "An instance buffer needs room for at least one instance");
+
+	D3D11_BUFFER_DESC instanceBufferDesc = {};
+	instanceBufferDesc.Usage = D3D11_USAGE_DEFAULT;								// GPU only; updated a range at a time with UpdateSubresource instead of being mapped
+	instanceBufferDesc.ByteWidth = (UINT)(sizeof(Instance2D) * maxInstances);
+	instanceBufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+	InstanceBuffer* instanceBuffer = new InstanceBuffer(maxInstances);
+	HRESULT hResult = m_d3d11Device->CreateBuffer(&instanceBufferDesc, NULL, &instanceBuffer->m_buffer);
+	if (!SUCCEEDED(hResult))
+	{
+		ERROR_AND_DIE("Could not create the instance buffer");
+	}
+	return instanceBuffer;
+}
+
+void Renderer::UpdateInstances(InstanceBuffer* instanceBuffer, int firstInstance, int numInstances, Instance2D const* instances)
+{
+	GUARANTEE_OR_DIE(firstInstance >= 0 && firstInstance + numInstances <= instanceBuffer->m_maxInstances, "Instance update is out of the instance buffer's range");
+	if (numInstances <= 0)
+	{
+		return;
+	}
+
+	D3D11_BOX box = {};
+	box.left = (UINT)(sizeof(Instance2D) * firstInstance);
+	box.right = (UINT)(sizeof(Instance2D) * (firstInstance + numInstances));
+	box.bottom = 1;
+	box.back = 1;
+	m_d3d11DeviceContext->UpdateSubresource(instanceBuffer->m_buffer, 0, &box, instances, 0, 0);
+	m_uploadStats.m_numBytesUploaded += sizeof(Instance2D) * numInstances;
+}
+
+// Draws the unit quad once per instance in one call. Recorded draws are flushed first so the
+// order between them and this draw is kept.
+void Renderer::DrawInstanced2D(InstanceBuffer* instanceBuffer, int numInstances, int firstInstance)
+{
+	FlushDrawCommands();
+	if (numInstances <= 0)
+	{
+		return;
+	}
+
+	DrawCommand command = GetCurrentDrawCommand();
+	if (command.m_shader == m_defaultShader)
+	{
+		command.m_shader = m_defaultInstanced2DShader;
+	}
+	ApplyDrawState(command);
+
+	ID3D11Buffer* vertexBuffers[2] = { m_unitQuadVBO->m_buffer, instanceBuffer->m_buffer };
+	unsigned int strides[2] = { sizeof(Vertex_PCU), sizeof(Instance2D) };
+	unsigned int offsets[2] = { 0, 0 };
+	m_d3d11DeviceContext->IASetVertexBuffers(0, 2, vertexBuffers, strides, offsets);
+	m_d3d11DeviceContext->IASetIndexBuffer(m_unitQuadIBO->m_buffer, DXGI_FORMAT_R32_UINT, 0);
+	m_d3d11DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	m_d3d11DeviceContext->DrawIndexedInstanced(6, numInstances, 0, 0, firstInstance);
+	++m_drawStats.m_numDrawCalls;
 }
 
 void Renderer::CreateAndInitializeBlendModes()
@@ -954,66 +1077,42 @@ void Renderer::CreateDepthMode()
 	}
 }
 
-void Renderer::SetBlendMode(BlendMode blendMode)
-{
-	m_desiredBlendMode = blendMode;
-}
-
-void Renderer::SetSamplerMode(SamplerMode samplerMode)
-{
-	m_desiredSamplerMode = samplerMode;
-}
-
-void Renderer::SetRasterizerMode(RasterizerMode rasterizerMode)
+void Renderer::SetStatesIfChanged(BlendMode blendMode, SamplerMode samplerMode, RasterizerMode rasterizerMode, DepthMode depthMode)
 {
-	m_desiredRasterizedMode = rasterizerMode;
-}
-
-void Renderer::SetDepthMode(DepthMode depthMode)
-{
-	m_desiredDepthMode = depthMode;
-}
-
-void Renderer::SetStatesIfChanged()
-{
-	if (m_blendStates[int(m_desiredBlendMode)] != m_blendState)
+	if (m_blendStates[int(blendMode)] != m_blendState)
 	{
-		m_blendState = m_blendStates[int(m_desiredBlendMode)];
+		m_blendState = m_blendStates[int(blendMode)];
 		float blendFactor[4] = { 0 };
 		UINT sampleMask = 0xffffffff;
 		m_d3d11DeviceContext->OMSetBlendState(m_blendState, blendFactor, sampleMask);
+		++m_drawStats.m_numStateChanges;
 	}
 
-	if (m_samplerStates[int(m_desiredSamplerMode)] != m_d3d11SamplerState)
+	if (m_samplerStates[int(samplerMode)] != m_d3d11SamplerState)
 	{
-		m_d3d11SamplerState = m_samplerStates[int(m_desiredSamplerMode)];
+		m_d3d11SamplerState = m_samplerStates[int(samplerMode)];
 		m_d3d11DeviceContext->PSSetSamplers(0, 1, &m_d3d11SamplerState);
+		++m_drawStats.m_numStateChanges;
 	}
 
-	if (m_rasterizerStates[int(m_desiredRasterizedMode)] != m_d3d11RasterizeState)
+	if (m_rasterizerStates[int(rasterizerMode)] != m_d3d11RasterizeState)
 	{
-		m_d3d11RasterizeState = m_rasterizerStates[int(m_desiredRasterizedMode)];
+		m_d3d11RasterizeState = m_rasterizerStates[int(rasterizerMode)];
 		m_d3d11DeviceContext->RSSetState(m_d3d11RasterizeState);
+		++m_drawStats.m_numStateChanges;
 	}
 
-	if (m_depthStencilStates[int(m_desiredDepthMode)] != m_depthStencilState)
+	if (m_depthStencilStates[int(depthMode)] != m_depthStencilState)
 	{
-		m_depthStencilState = m_depthStencilStates[int(m_desiredDepthMode)];
+		m_depthStencilState = m_depthStencilStates[int(depthMode)];
 		m_d3d11DeviceContext->OMSetDepthStencilState(m_depthStencilState, 0);
+		++m_drawStats.m_numStateChanges;
 	}
 }
 
-void Renderer::SetModelConstants(Mat44 const& modelMatrix, Rgba8 const& modelColor)
-{
-	ModelConstants modelConstants;
-	modelConstants.modelMatrix = modelMatrix;
-	modelColor.GetAsFloats(modelConstants.modelColor);
-	CopyCPUToGPU(&modelConstants, sizeof(modelConstants), m_modelCBO);
-	BindConstantBuffer(s_modelConstantsSlot, m_modelCBO);
-}
-
 void Renderer::SetLightingConstants(Vec3 const& sunDirection, float sunIntensity, float ambientIntensity)
 {
+	FlushDrawCommands();
 	LightingConstants lightingConstants;
 
 	lightingConstants.sunDirection = sunDirection;
@@ -1026,12 +1125,4 @@ void Renderer::SetLightingConstants(Vec3 const& sunDirection, float sunIntensity
 	BindConstantBuffer(s_lightingConstantsSlot, m_lightingCBO);
 }
 
-void Renderer::SetLightAt(Light const& lightToSet, int indexToSet)
-{
-	bool isIndexValid = indexToSet < MAX_LIGHTS ? true : false;
-	isIndexValid = isIndexValid && (indexToSet >= 0 ? true : false);
-	
-	if (!isIndexValid) return;
-
-	m_lights[indexToSet] = lightToSet;
-}
+#endif // !defined(ENGINE_NULL_RENDERER)
@@ -5,12 +5,21 @@
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/Vertex_PNCU.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/Shader.hpp"
 
 #include "Game/EngineBuildPreferences.hpp"
 
+#include <condition_variable>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
+#if defined(ENGINE_NULL_RENDERER)
+#define DX_SAFE_RELEASE(dxObject) { (dxObject) = nullptr; }	// The null renderer never creates any D3D objects
+#else
 #define DX_SAFE_RELEASE(dxObject) { if ((dxObject) != nullptr) { (dxObject)->Release(); (dxObject) = nullptr; } }
+#endif
 
 #if defined(OPAQUE)
 #undef OPAQUE
@@ -27,6 +36,7 @@ struct ID3D11DeviceContext;
 struct IDXGISwapChain;
 struct ID3D11BlendState;
 struct ID3D11SamplerState;
+struct ID3D11Buffer;
 
 //--------------------------------------------------------------------------------------------------
 class Window;
@@ -36,6 +46,9 @@ class Shader;
 class VertexBuffer;
 class IndexBuffer;
 class ConstantBuffer;
+class InstanceBuffer;
+struct Instance2D;
+class TextureDecodeJob;
 
 //--------------------------------------------------------------------------------------------------
 enum class BlendMode
@@ -72,10 +85,89 @@ enum class DepthMode
 	COUNT,
 };
 
+//--------------------------------------------------------------------------------------------------
+enum DrawVertexStream : unsigned char
+{
+	DRAW_VERTEX_STREAM_PCU,
+	DRAW_VERTEX_STREAM_PNCU,
+	DRAW_VERTEX_STREAM_COUNT,
+};
+
+//--------------------------------------------------------------------------------------------------
+// One recorded DrawVertexArray/DrawIndexedArray call. Its indexes already point at its verts in
+// the camera's shared vertex stream, so any run of commands with the same state is one draw call.
+struct DrawCommand
+{
+	unsigned long long	m_sortKey = 0;
+	Shader const*		m_shader = nullptr;
+	Texture const*		m_texture = nullptr;
+	int					m_modelConstantsIndex = 0;
+	int					m_firstIndex = 0;
+	int					m_numIndexes = 0;
+	DrawVertexStream	m_vertexStream = DRAW_VERTEX_STREAM_PCU;
+	BlendMode			m_blendMode = BlendMode::ALPHA;
+	SamplerMode			m_samplerMode = SamplerMode::POINT_CLAMP;
+	RasterizerMode		m_rasterizerMode = RasterizerMode::SOLID_CULL_BACK;
+	DepthMode			m_depthMode = DepthMode::ENABLED;
+};
+
+//--------------------------------------------------------------------------------------------------
+// A run of sorted commands that share all their state, drawn with one DrawIndexed.
+struct DrawBatch
+{
+	int m_commandIndex = 0;		// The first command in the run
+	int m_numIndexes = 0;		// Of the whole run
+};
+
+//--------------------------------------------------------------------------------------------------
+struct ModelConstants
+{
+	Mat44 modelMatrix;
+	float modelColor[4];
+};
+
+//--------------------------------------------------------------------------------------------------
+struct RendererDrawStats
+{
+	int					m_numDrawCommands = 0;
+	int					m_numDrawCalls = 0;
+	int					m_numStateChanges = 0;			// Shader, texture, model constant and fixed function state binds
+	int					m_numVertexes = 0;
+	int					m_numIndexes = 0;
+	unsigned long long	m_checksum = 14695981039346656037ULL;	// FNV-1a of the flushed verts and indexes, see RendererConfig::m_checksumDrawData
+};
+
+//--------------------------------------------------------------------------------------------------
+struct RendererUploadStats
+{
+	size_t	m_numBytesUploaded = 0;
+	int		m_numMaps = 0;
+	int		m_numWraps = 0;		// Times a ring ran out of room and started over at the front
+	int		m_numGrows = 0;		// Times a ring was too small for one flush and was recreated bigger
+};
+
+//--------------------------------------------------------------------------------------------------
+// How long each step of one CreateOrGetTextureFromFileAsync load took, in seconds
+struct TextureLoadTiming
+{
+	std::string	m_imageFilePath;
+	size_t		m_numBytes = 0;
+	double		m_queuedSeconds = 0.0;		// Waiting for a worker to pick up the decode
+	double		m_decodeSeconds = 0.0;
+	double		m_uploadWaitSeconds = 0.0;	// Decoded, waiting for the main thread to have upload budget
+	double		m_uploadSeconds = 0.0;
+};
+
+//--------------------------------------------------------------------------------------------------
+constexpr size_t DEFAULT_TEXTURE_UPLOAD_BUDGET = 8 * 1024 * 1024;
+
 //--------------------------------------------------------------------------------------------------
 struct RendererConfig
 {
 	Window* m_window = nullptr;
+	bool	m_batchDrawCommands = true;		// False draws every DrawVertexArray/DrawIndexedArray as soon as it is called
+	bool	m_checksumDrawData = false;		// Null renderer only; lets a headless run check it submitted the same frame as before
+	size_t	m_textureUploadBudgetBytes = DEFAULT_TEXTURE_UPLOAD_BUDGET;	// Streamed texels uploaded per frame; at least one texture always goes
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -106,8 +198,18 @@ struct Light
 	//-----------------------------------				(16 byte boundary)
 };
 
+//--------------------------------------------------------------------------------------------------
+// Textures, fonts and shaders each get an ID when they are loaded: their index in the matching
+// m_loaded* list. Assets are never unloaded before Shutdown, so an ID stays valid until then.
+typedef int AssetID;
+constexpr AssetID INVALID_ASSET_ID = -1;
+
+typedef std::unordered_map<std::string, AssetID> AssetIDRegistry;	// Normalized path to ID; INVALID_ASSET_ID while it is loading
+
 //--------------------------------------------------------------------------------------------------
 constexpr int MAX_LIGHTS = 8;
+constexpr size_t DEFAULT_RING_VBO_SIZE = 4 * 1024 * 1024;
+constexpr size_t DEFAULT_RING_IBO_SIZE = 1024 * 1024;
 //--------------------------------------------------------------------------------------------------
 class Renderer
 {
@@ -127,20 +229,36 @@ public:
 	void DrawVertexArray(std::vector<Vertex_PCU> const& vertexes);
 	void DrawIndexedArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes);
 	void DrawIndexedArray(int numVertexes, Vertex_PNCU const* vertexes, int numIndexes, unsigned int const* indexes);
+	void SetDrawLayer(unsigned char drawLayer);
+	void FlushDrawCommands();
+	RendererUploadStats const& GetLastFrameUploadStats() const { return m_lastFrameUploadStats; }
+	RendererDrawStats const& GetLastFrameDrawStats() const { return m_lastFrameDrawStats; }
 	RendererConfig const& GetConfig() const { return m_config;  }
 
 	Texture* CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, unsigned char* texelData);
 	void BindTexture(Texture const* texture);
 	Texture*		CreateOrGetTextureFromFile(char const* imageFilePath);
+	Texture*		CreateOrGetTextureFromFileAsync(char const* imageFilePath);
+	void			FinishTextureLoads();
+	int				GetNumPendingTextureLoads() const { return (int)m_pendingTextureLoads.size(); }
+	std::vector<TextureLoadTiming> const& GetTextureLoadTimings() const { return m_textureLoadTimings; }
 	BitmapFont*		CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNoExtension);
-	Shader*			CreateOrGetShader(char const* shaderFilePath);
+	Shader*			CreateOrGetShader(char const* shaderFilePath, VertexType vertexType = VERTEX_TYPE_PCU);
 
 	Texture*	GetTextureForFileName	(char const* imageFilePath);
 	BitmapFont* GetBitmapFontForFileName(char const* bitmapFontFilePathWithNoExtension);
+	Shader*		GetShaderForName		(char const* shaderName, VertexType vertexType = VERTEX_TYPE_PCU);
+
+	AssetID		GetTextureID			(char const* imageFilePath) const;
+	AssetID		GetBitmapFontID			(char const* bitmapFontFilePathWithNoExtension) const;
+	AssetID		GetShaderID				(char const* shaderName, VertexType vertexType = VERTEX_TYPE_PCU) const;
+	Texture*	GetTextureForID			(AssetID textureID) const;
+	BitmapFont*	GetBitmapFontForID		(AssetID bitmapFontID) const;
+	Shader*		GetShaderForID			(AssetID shaderID) const;
 
 	void BindShader(Shader* shader);
-	Shader* CreateShader(char const* shaderName, char const* shaderSource);
-	Shader* CreateShader(char const* shaderName);
+	Shader* CreateShader(char const* shaderName, char const* shaderSource, VertexType vertexType = VERTEX_TYPE_PCU);
+	Shader* CreateShader(char const* shaderName, VertexType vertexType = VERTEX_TYPE_PCU);
 	bool CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target);
 
 	VertexBuffer* CreateVertexBuffer(size_t const size);
@@ -159,6 +277,10 @@ public:
 	void DrawVertexAndIndexBuffer(VertexBuffer* vbo, IndexBuffer* ibo, int indexCount, int indexOffset = 0, int vertexOffset = 0);
 	void DrawIndexed(int indexCount, int indexOffset = 0, int vertexOffset = 0);
 
+	InstanceBuffer* CreateInstanceBuffer(int maxInstances);
+	void UpdateInstances(InstanceBuffer* instanceBuffer, int firstInstance, int numInstances, Instance2D const* instances);
+	void DrawInstanced2D(InstanceBuffer* instanceBuffer, int numInstances, int firstInstance = 0);
+
 	void CreateAndInitializeBlendModes();
 	void CreateSamplerModes();
 	void CreateRasterizerMode();
@@ -175,8 +297,27 @@ public:
 private:
 	Texture*		CreateTextureFromFile	(char const* imageFilePath);
 	Texture*		CreateTextureFromImage	(Image const& image);
+	void			InitializeTextureFromImage(Texture& texture, Image const& image);
+	void			UpdateTextureStreaming	();
+	void			FinishTextureLoad		(TextureDecodeJob* decodeJob);
 	BitmapFont*		CreateBitmapFont		(char const* imageFilePathWithNoExtension);
 
+	AssetID			FindOrClaimAsset		(AssetIDRegistry& registry, std::string const& assetKey);
+	AssetID			FindAsset				(AssetIDRegistry const& registry, std::string const& assetKey) const;
+	AssetID			PublishAsset			(AssetIDRegistry& registry, std::string const& assetKey, AssetID assetID);
+	AssetID			AddLoadedTexture		(Texture* texture, std::string const& assetKey);
+	AssetID			AddLoadedBitmapFont		(BitmapFont* bitmapFont, std::string const& assetKey);
+	AssetID			AddLoadedShader			(Shader* shader);
+	VertexType		GetShaderVertexType		(char const* shaderName, VertexType vertexType) const;
+
+	void			RecordDrawCommand		(DrawVertexStream vertexStream, int numVertexes, void const* vertexes, int numIndexes, unsigned int const* indexes);
+	DrawCommand		GetCurrentDrawCommand	() const;
+	void			BatchDrawCommands		(unsigned int* out_indexes, int firstIndexOffset);
+	void			ResetDrawCommands		();
+	void			ApplyDrawState			(DrawCommand const& command);
+	void			SetStatesIfChanged		(BlendMode blendMode, SamplerMode samplerMode, RasterizerMode rasterizerMode, DepthMode depthMode);
+	void*			MapRingBuffer			(ID3D11Buffer* buffer, size_t bufferSize, size_t& writeOffset, size_t size, size_t& out_offset);
+
 protected:
 	void* m_dxgiDebugModule = nullptr;
 	void* m_dxgiDebug = nullptr;
@@ -205,11 +346,20 @@ protected:
 	
 	std::vector<Shader*> m_loadedShaders;
 	Shader const* m_currentShader = nullptr;
+	Shader const* m_boundShader = nullptr;
 	Shader* m_defaultShader = nullptr;
+	Shader* m_defaultInstanced2DShader = nullptr;	// DrawInstanced2D uses this while the default shader is bound
 	
-	VertexBuffer* m_immediateVBO = nullptr;
-	VertexBuffer* m_immediatePNCUVBO = nullptr;
-	IndexBuffer* m_immediateIBO = nullptr;
+	VertexBuffer* m_ringVBO = nullptr;		// Every recorded vert, both vertex streams, sub-allocated per flush
+	IndexBuffer* m_ringIBO = nullptr;
+	VertexBuffer* m_unitQuadVBO = nullptr;	// The mesh every Instance2D draws
+	IndexBuffer* m_unitQuadIBO = nullptr;
+	size_t m_ringVBOWriteOffset = 0;
+	size_t m_ringIBOWriteOffset = 0;
+	RendererUploadStats m_uploadStats;
+	RendererUploadStats m_lastFrameUploadStats;
+	RendererDrawStats m_drawStats;
+	RendererDrawStats m_lastFrameDrawStats;
 	ConstantBuffer* m_cameraCBO = nullptr;
 	ConstantBuffer* m_modelCBO = nullptr;
 	ConstantBuffer* m_lightingCBO = nullptr;
@@ -217,8 +367,40 @@ protected:
 	RendererConfig m_config;
 
 	Texture const* m_defaultTexture = nullptr;
+	Texture const* m_currentTexture = nullptr;
+	Texture const* m_boundTexture = nullptr;
 	std::vector<Texture*>		m_loadedTextures;
 	std::vector<BitmapFont*>	m_loadedFonts;
+
+	// The asset registries can be used from any thread. Lookups share the lock; a miss claims the
+	// path so other threads asking for it wait on m_assetLoadedCondition instead of loading it again.
+	AssetIDRegistry						m_textureIDs;
+	AssetIDRegistry						m_bitmapFontIDs;
+	AssetIDRegistry						m_shaderIDs;			// Keyed by name and vertex type, since each type needs its own input layout
+	mutable std::shared_mutex			m_assetMutex;
+	std::condition_variable_any			m_assetLoadedCondition;
+
+	std::vector<TextureDecodeJob*>		m_pendingTextureLoads;	// In the order they were asked for; main thread only
+	std::vector<TextureLoadTiming>		m_textureLoadTimings;
+
+	bool						m_isRecordingDrawCommands = false;	// Only between BeginCamera and EndCamera
+	unsigned char				m_drawLayer = 0;
+	int							m_drawGroup = 0;
+	bool						m_isDrawGroupReorderable = false;
+	int							m_boundModelConstantsIndex = -1;
+	std::vector<DrawCommand>	m_drawCommands;
+	std::vector<DrawBatch>		m_drawBatches;
+	std::vector<Vertex_PCU>		m_drawVertsPCU;
+	std::vector<Vertex_PNCU>	m_drawVertsPNCU;
+	std::vector<unsigned int>	m_drawIndexes;			// In record order, already offset into their vertex stream
+	std::vector<ModelConstants>	m_drawModelConstants;	// The last entry is always the current model constants
+	std::vector<Shader const*>	m_drawShaders;			// Small ids for the sort key, reset every flush
+	std::vector<Texture const*>	m_drawTextures;
+
+#if defined(ENGINE_NULL_RENDERER)
+	DrawCommand					m_nullBoundState;		// Stands in for the device's bound state when counting state changes
+	std::vector<unsigned int>	m_nullSortedIndexes;
+#endif
 private:
 	// Should this be a pointer
 	Light m_lights[MAX_LIGHTS];
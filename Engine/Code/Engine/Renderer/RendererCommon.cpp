@@ -0,0 +1,731 @@
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Renderer/Texture.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
+
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
+
+// Everything in here is the same for every backend: recording and batching draw commands, the
+// render state setters and the texture, font and shader caches. The device side lives in
+// Renderer.cpp (D3D11) or NullRenderer.cpp (ENGINE_NULL_RENDERER).
+
+// Draw command sort key, high bits first: layer, group, shader, texture, then the fixed function
+// states. Commands with equal low 32 bits can share a draw call as long as their model constants
+// match too.
+static int const s_drawKeyLayerShift			= 56;	// 8 bits
+static int const s_drawKeyGroupShift			= 32;	// 24 bits
+static int const s_drawKeyShaderShift			= 24;	// 8 bits
+static int const s_drawKeyTextureShift			= 12;	// 12 bits
+static int const s_drawKeyVertexStreamShift		= 8;	// 4 bits
+static int const s_drawKeyBlendShift			= 6;	// 2 bits
+static int const s_drawKeySamplerShift			= 4;	// 2 bits
+static int const s_drawKeyRasterizerShift		= 2;	// 2 bits
+static int const s_drawKeyDepthShift			= 0;	// 2 bits
+
+static unsigned long long const s_drawKeyStateMask = 0xffffffffULL;
+
+static int const s_maxDrawGroups	= 1 << 24;
+static int const s_maxDrawShaders	= 1 << 8;
+static int const s_maxDrawTextures	= 1 << 12;
+
+// Decodes one image file on a JobSystem worker for CreateOrGetTextureFromFileAsync. The renderer
+// takes it back itself with RetrieveSpecificJob, so RetrieveCompletedJob never hands it to the game.
+class TextureDecodeJob : public Job
+{
+public:
+	TextureDecodeJob(Texture* texture, char const* imageFilePath) :
+		m_texture(texture),
+		m_imageFilePath(imageFilePath)
+	{
+		m_isRetrievedByOwner = true;
+		m_requestSeconds = GetCurrentTimeSeconds();
+	};
+	virtual void Execute() override
+	{
+		m_decodeStartSeconds = GetCurrentTimeSeconds();
+		m_image = Image(m_imageFilePath.c_str());
+		m_decodeEndSeconds = GetCurrentTimeSeconds();
+	}
+
+	Texture*	m_texture = nullptr;
+	std::string	m_imageFilePath;
+	Image		m_image;
+	double		m_requestSeconds = 0.0;
+	double		m_decodeStartSeconds = 0.0;
+	double		m_decodeEndSeconds = 0.0;
+};
+
+static bool IsTextureDecoded(TextureDecodeJob const* decodeJob)
+{
+	JobStatus status = decodeJob->m_status;
+	return status == JOB_STATUS_COMPLETED || status == JOB_STATUS_RETRIEVED_AND_RETIRED;
+}
+
+static size_t GetNumTexelBytes(Image const& image)
+{
+	IntVec2 dimensions = image.GetDimensions();
+	return sizeof(Rgba8) * dimensions.x * dimensions.y;
+}
+
+// Windows paths ignore case and take either slash, so "Data\Fonts\A" and "data/fonts/a" should
+// find the same asset.
+static std::string NormalizeAssetPath(char const* assetPath)
+{
+	std::string normalizedPath;
+	normalizedPath.reserve(strlen(assetPath));
+	for (char const* pathChar = assetPath; *pathChar != '\0'; ++pathChar)
+	{
+		char normalizedChar = (*pathChar == '\\') ? '/' : (char)tolower((unsigned char)*pathChar);
+		if (normalizedChar == '/' && !normalizedPath.empty() && normalizedPath.back() == '/')
+		{
+			continue;
+		}
+		normalizedPath.push_back(normalizedChar);
+	}
+
+	while (normalizedPath.compare(0, 2, "./") == 0)
+	{
+		normalizedPath.erase(0, 2);
+	}
+	return normalizedPath;
+}
+
+// The same shader file built for two vertex types is two shaders with different input layouts
+static std::string GetShaderKey(char const* shaderName, VertexType vertexType)
+{
+	return NormalizeAssetPath(shaderName) + Stringf("|%d", (int)vertexType);
+}
+
+void Renderer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes)
+{
+	RecordDrawCommand(DRAW_VERTEX_STREAM_PCU, numVertexes, vertexes, 0, nullptr);
+}
+
+void Renderer::DrawVertexArray(std::vector<Vertex_PCU> const& vertexes)
+{
+	RecordDrawCommand(DRAW_VERTEX_STREAM_PCU, (int)vertexes.size(), vertexes.data(), 0, nullptr);
+}
+
+void Renderer::DrawIndexedArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	RecordDrawCommand(DRAW_VERTEX_STREAM_PCU, numVertexes, vertexes, numIndexes, indexes);
+}
+
+void Renderer::DrawIndexedArray(int numVertexes, Vertex_PNCU const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	RecordDrawCommand(DRAW_VERTEX_STREAM_PNCU, numVertexes, vertexes, numIndexes, indexes);
+}
+
+// Layers sort before everything else, so a higher layer always draws on top of a lower one no
+// matter what order the draws were made in.
+void Renderer::SetDrawLayer(unsigned char drawLayer)
+{
+	m_drawLayer = drawLayer;
+}
+
+// Opaque, depth tested draws can be drawn in any order, so back to back ones share a group and get
+// sorted by state. Any other draw starts a group of its own, which pins it between its neighbours.
+void Renderer::RecordDrawCommand(DrawVertexStream vertexStream, int numVertexes, void const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	if (numVertexes <= 0 || (indexes != nullptr && numIndexes <= 0))
+	{
+		return;
+	}
+
+	if (m_drawGroup >= s_maxDrawGroups - 1 || (int)m_drawShaders.size() >= s_maxDrawShaders || (int)m_drawTextures.size() >= s_maxDrawTextures)
+	{
+		FlushDrawCommands();
+	}
+
+	DrawCommand command = GetCurrentDrawCommand();
+	command.m_vertexStream = vertexStream;
+
+	bool isReorderable = command.m_blendMode == BlendMode::OPAQUE && command.m_depthMode == DepthMode::ENABLED;
+	if (!isReorderable || !m_isDrawGroupReorderable)
+	{
+		++m_drawGroup;
+	}
+	m_isDrawGroupReorderable = isReorderable;
+
+	int shaderId = 0;
+	while (shaderId < (int)m_drawShaders.size() && m_drawShaders[shaderId] != command.m_shader)
+	{
+		++shaderId;
+	}
+	if (shaderId == (int)m_drawShaders.size())
+	{
+		m_drawShaders.push_back(command.m_shader);
+	}
+
+	int textureId = 0;
+	while (textureId < (int)m_drawTextures.size() && m_drawTextures[textureId] != command.m_texture)
+	{
+		++textureId;
+	}
+	if (textureId == (int)m_drawTextures.size())
+	{
+		m_drawTextures.push_back(command.m_texture);
+	}
+
+	command.m_sortKey =	((unsigned long long)m_drawLayer << s_drawKeyLayerShift) |
+						((unsigned long long)m_drawGroup << s_drawKeyGroupShift) |
+						((unsigned long long)shaderId << s_drawKeyShaderShift) |
+						((unsigned long long)textureId << s_drawKeyTextureShift) |
+						((unsigned long long)vertexStream << s_drawKeyVertexStreamShift) |
+						((unsigned long long)command.m_blendMode << s_drawKeyBlendShift) |
+						((unsigned long long)command.m_samplerMode << s_drawKeySamplerShift) |
+						((unsigned long long)command.m_rasterizerMode << s_drawKeyRasterizerShift) |
+						((unsigned long long)command.m_depthMode << s_drawKeyDepthShift);
+
+	unsigned int firstVertIndex = 0;
+	if (vertexStream == DRAW_VERTEX_STREAM_PCU)
+	{
+		firstVertIndex = (unsigned int)m_drawVertsPCU.size();
+		Vertex_PCU const* verts = (Vertex_PCU const*)vertexes;
+		m_drawVertsPCU.insert(m_drawVertsPCU.end(), verts, verts + numVertexes);
+	}
+	else
+	{
+		firstVertIndex = (unsigned int)m_drawVertsPNCU.size();
+		Vertex_PNCU const* verts = (Vertex_PNCU const*)vertexes;
+		m_drawVertsPNCU.insert(m_drawVertsPNCU.end(), verts, verts + numVertexes);
+	}
+
+	command.m_firstIndex = (int)m_drawIndexes.size();
+	if (indexes == nullptr)
+	{
+		numIndexes = numVertexes;
+	}
+	command.m_numIndexes = numIndexes;
+	m_drawIndexes.resize(m_drawIndexes.size() + numIndexes);
+	unsigned int* drawIndexes = m_drawIndexes.data() + command.m_firstIndex;
+	for (int indexIndex = 0; indexIndex < numIndexes; ++indexIndex)
+	{
+		drawIndexes[indexIndex] = firstVertIndex + (indexes ? indexes[indexIndex] : (unsigned int)indexIndex);
+	}
+
+	m_drawCommands.push_back(command);
+	m_drawStats.m_numVertexes += numVertexes;
+	m_drawStats.m_numIndexes += numIndexes;
+
+	if (!m_isRecordingDrawCommands)
+	{
+		FlushDrawCommands();
+	}
+}
+
+DrawCommand Renderer::GetCurrentDrawCommand() const
+{
+	DrawCommand command;
+	command.m_shader = m_currentShader;
+	command.m_texture = (m_currentTexture && m_currentTexture->m_isLoading) ? m_defaultTexture : m_currentTexture;
+	command.m_modelConstantsIndex = (int)m_drawModelConstants.size() - 1;
+	command.m_blendMode = m_desiredBlendMode;
+	command.m_samplerMode = m_desiredSamplerMode;
+	command.m_rasterizerMode = m_desiredRasterizedMode;
+	command.m_depthMode = m_desiredDepthMode;
+	return command;
+}
+
+// Sorts the recorded commands, writes their indexes to out_indexes in sorted order and fills
+// m_drawBatches with the runs of commands that can share one draw call. Each command's first index
+// becomes its place in out_indexes plus firstIndexOffset. Sorting is stable and only ever reorders
+// draws inside a group of back to back opaque, depth tested draws, where the order can't change
+// the result; everything else keeps the order it was recorded in.
+void Renderer::BatchDrawCommands(unsigned int* out_indexes, int firstIndexOffset)
+{
+	int numCommands = (int)m_drawCommands.size();
+	std::stable_sort(m_drawCommands.begin(), m_drawCommands.end(), [](DrawCommand const& a, DrawCommand const& b) { return a.m_sortKey < b.m_sortKey; });
+
+	int numSortedIndexes = 0;
+	for (int commandIndex = 0; commandIndex < numCommands; ++commandIndex)
+	{
+		DrawCommand& command = m_drawCommands[commandIndex];
+		memcpy(out_indexes + numSortedIndexes, m_drawIndexes.data() + command.m_firstIndex, sizeof(unsigned int) * command.m_numIndexes);
+		command.m_firstIndex = firstIndexOffset + numSortedIndexes;
+		numSortedIndexes += command.m_numIndexes;
+	}
+
+	m_drawBatches.clear();
+	int commandIndex = 0;
+	while (commandIndex < numCommands)
+	{
+		DrawCommand const& command = m_drawCommands[commandIndex];
+		DrawBatch batch;
+		batch.m_commandIndex = commandIndex;
+		batch.m_numIndexes = command.m_numIndexes;
+		int nextCommandIndex = commandIndex + 1;
+		while (nextCommandIndex < numCommands)
+		{
+			DrawCommand const& nextCommand = m_drawCommands[nextCommandIndex];
+			if ((nextCommand.m_sortKey & s_drawKeyStateMask) != (command.m_sortKey & s_drawKeyStateMask) || nextCommand.m_modelConstantsIndex != command.m_modelConstantsIndex)
+			{
+				break;
+			}
+			batch.m_numIndexes += nextCommand.m_numIndexes;
+			++nextCommandIndex;
+		}
+		m_drawBatches.push_back(batch);
+		commandIndex = nextCommandIndex;
+	}
+
+	m_drawStats.m_numDrawCommands += numCommands;
+}
+
+void Renderer::ResetDrawCommands()
+{
+	// Keep only the current model constants; if they were the last ones bound they still are
+	int currentModelConstantsIndex = (int)m_drawModelConstants.size() - 1;
+	m_boundModelConstantsIndex = m_boundModelConstantsIndex == currentModelConstantsIndex ? 0 : -1;
+	m_drawModelConstants[0] = m_drawModelConstants[currentModelConstantsIndex];
+	m_drawModelConstants.resize(1);
+
+	m_drawCommands.clear();
+	m_drawBatches.clear();
+	m_drawVertsPCU.clear();
+	m_drawVertsPNCU.clear();
+	m_drawIndexes.clear();
+	m_drawShaders.clear();
+	m_drawTextures.clear();
+	m_drawGroup = 0;
+	m_isDrawGroupReorderable = false;
+}
+
+// Model constants are recorded with each draw rather than uploaded here. Setting the same ones
+// twice, or setting new ones before anything has drawn with the old ones, doesn't add an entry.
+void Renderer::SetModelConstants(Mat44 const& modelMatrix, Rgba8 const& modelColor)
+{
+	ModelConstants modelConstants;
+	modelConstants.modelMatrix = modelMatrix;
+	modelColor.GetAsFloats(modelConstants.modelColor);
+
+	int currentModelConstantsIndex = (int)m_drawModelConstants.size() - 1;
+	if (currentModelConstantsIndex >= 0)
+	{
+		if (memcmp(&m_drawModelConstants[currentModelConstantsIndex], &modelConstants, sizeof(ModelConstants)) == 0)
+		{
+			return;
+		}
+		if (m_drawCommands.empty() || m_drawCommands.back().m_modelConstantsIndex != currentModelConstantsIndex)
+		{
+			m_drawModelConstants[currentModelConstantsIndex] = modelConstants;
+			if (m_boundModelConstantsIndex == currentModelConstantsIndex)
+			{
+				m_boundModelConstantsIndex = -1;
+			}
+			return;
+		}
+	}
+	m_drawModelConstants.push_back(modelConstants);
+}
+
+void Renderer::SetBlendMode(BlendMode blendMode)
+{
+	m_desiredBlendMode = blendMode;
+}
+
+void Renderer::SetSamplerMode(SamplerMode samplerMode)
+{
+	m_desiredSamplerMode = samplerMode;
+}
+
+void Renderer::SetRasterizerMode(RasterizerMode rasterizerMode)
+{
+	m_desiredRasterizedMode = rasterizerMode;
+}
+
+void Renderer::SetDepthMode(DepthMode depthMode)
+{
+	m_desiredDepthMode = depthMode;
+}
+
+void Renderer::SetStatesIfChanged()
+{
+	SetStatesIfChanged(m_desiredBlendMode, m_desiredSamplerMode, m_desiredRasterizedMode, m_desiredDepthMode);
+}
+
+void Renderer::SetLightAt(Light const& lightToSet, int indexToSet)
+{
+	bool isIndexValid = indexToSet < MAX_LIGHTS ? true : false;
+	isIndexValid = isIndexValid && (indexToSet >= 0 ? true : false);
+	
+	if (!isIndexValid) return;
+
+	m_lights[indexToSet] = lightToSet;
+}
+
+void Renderer::BindShader(Shader* shader)
+{
+	if (shader == nullptr)
+	{
+		shader = m_defaultShader;
+	}
+
+	m_currentShader = shader;
+}
+
+void Renderer::BindTexture(Texture const* texture)
+{
+	if (texture == nullptr)
+	{
+		texture = m_defaultTexture;
+	}
+	m_currentTexture = texture;
+}
+
+Texture* Renderer::CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, unsigned char* texelData)
+{
+	// Check if the load was successful
+	GUARANTEE_OR_DIE(texelData, Stringf("CreateTextureFromData failed for \"%s\" - texelData was null!", name));
+	GUARANTEE_OR_DIE(bytesPerTexel >= 3 && bytesPerTexel <= 4, Stringf("CreateTextureFromData failed for \"%s\" - unsupported BPP=%i (must be 3 or 4)", name, bytesPerTexel));
+	GUARANTEE_OR_DIE(dimensions.x > 0 && dimensions.y > 0, Stringf("CreateTextureFromData failed for \"%s\" - illegal texture dimensions (%i x %i)", name, dimensions.x, dimensions.y));
+
+	Texture* newTexture = new Texture();
+	newTexture->m_name = name; // NOTE: m_name must be a std::string, otherwise it may point to temporary data!
+	newTexture->m_dimensions = dimensions;
+
+	return newTexture;
+}
+
+Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
+{
+	Image newImage(imageFilePath);
+	return CreateTextureFromImage(newImage);
+}
+
+Texture* Renderer::CreateTextureFromImage(Image const& image)
+{
+	Texture* texture = new Texture;
+	texture->m_name = image.GetImageFilePath();
+	InitializeTextureFromImage(*texture, image);
+	return texture;
+}
+
+BitmapFont* Renderer::CreateBitmapFont(char const* imageFilePathWithNoExtension)
+{
+	std::string imageFilePathString = imageFilePathWithNoExtension + std::string(".png");
+	char const* imageFilePath = imageFilePathString.c_str();
+	Texture* bitmapFontTexture = CreateOrGetTextureFromFile(imageFilePath);
+	BitmapFont* newBitmapFont = new BitmapFont(imageFilePathWithNoExtension, *bitmapFontTexture);
+	return newBitmapFont;
+}
+
+Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
+{
+	// See if we already have this texture previously loaded, or another thread is loading it
+	std::string textureKey = NormalizeAssetPath(imageFilePath);
+	AssetID textureID = FindOrClaimAsset(m_textureIDs, textureKey);
+	if (textureID != INVALID_ASSET_ID)
+	{
+		return GetTextureForID(textureID);
+	}
+
+	// Never seen this texture before!  Let's load it.
+	Texture* newTexture = CreateTextureFromFile(imageFilePath);
+	AddLoadedTexture(newTexture, textureKey);
+	return newTexture;
+}
+
+// Returns straight away. A texture that isn't loaded yet comes back as a placeholder, which draws as
+// the default texture until a JobSystem worker has decoded its image and UpdateTextureStreaming has
+// uploaded it. Main thread only. A plain CreateOrGetTextureFromFile of the same file gets the same
+// placeholder back without waiting.
+Texture* Renderer::CreateOrGetTextureFromFileAsync(char const* imageFilePath)
+{
+	std::string textureKey = NormalizeAssetPath(imageFilePath);
+	AssetID textureID = FindOrClaimAsset(m_textureIDs, textureKey);
+	if (textureID != INVALID_ASSET_ID)
+	{
+		return GetTextureForID(textureID);
+	}
+
+	Texture* newTexture = new Texture();
+	newTexture->m_name = imageFilePath;
+	newTexture->m_isLoading = true;
+	AddLoadedTexture(newTexture, textureKey);
+
+	TextureDecodeJob* decodeJob = new TextureDecodeJob(newTexture, imageFilePath);
+	if (g_theJobSystem && g_theJobSystem->GetNumWorkers() > 0)
+	{
+		g_theJobSystem->QueueNewJob(decodeJob);
+	}
+	else
+	{
+		decodeJob->Execute();
+		decodeJob->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+	}
+	m_pendingTextureLoads.push_back(decodeJob);
+	return newTexture;
+}
+
+// Blocks until every streaming texture is decoded and uploaded, e.g. at the end of a level load
+void Renderer::FinishTextureLoads()
+{
+	for (int loadIndex = 0; loadIndex < (int)m_pendingTextureLoads.size(); ++loadIndex)
+	{
+		FinishTextureLoad(m_pendingTextureLoads[loadIndex]);
+	}
+	m_pendingTextureLoads.clear();
+}
+
+// Uploads decoded textures in the order they were asked for, up to the config's upload budget per
+// frame. A texture that doesn't fit waits for next frame, but the first upload of a frame always
+// goes so one bigger than the whole budget still loads.
+void Renderer::UpdateTextureStreaming()
+{
+	size_t numBytesUploaded = 0;
+	int numStillPending = 0;
+	for (int loadIndex = 0; loadIndex < (int)m_pendingTextureLoads.size(); ++loadIndex)
+	{
+		TextureDecodeJob* decodeJob = m_pendingTextureLoads[loadIndex];
+		if (IsTextureDecoded(decodeJob))
+		{
+			size_t numBytes = GetNumTexelBytes(decodeJob->m_image);
+			if (numBytesUploaded == 0 || numBytesUploaded + numBytes <= m_config.m_textureUploadBudgetBytes)
+			{
+				FinishTextureLoad(decodeJob);
+				numBytesUploaded += numBytes;
+				continue;
+			}
+		}
+		m_pendingTextureLoads[numStillPending] = decodeJob;
+		++numStillPending;
+	}
+	m_pendingTextureLoads.resize(numStillPending);
+}
+
+// Waits for the decode if it is still running, takes the job back from the JobSystem, uploads the
+// texture and records how long each step took. Deletes the job.
+void Renderer::FinishTextureLoad(TextureDecodeJob* decodeJob)
+{
+	while (!IsTextureDecoded(decodeJob))
+	{
+		std::this_thread::yield();
+	}
+	if (decodeJob->m_status == JOB_STATUS_COMPLETED)
+	{
+		g_theJobSystem->RetrieveSpecificJob(decodeJob);
+	}
+
+	double uploadStartSeconds = GetCurrentTimeSeconds();
+	Texture* texture = decodeJob->m_texture;
+	InitializeTextureFromImage(*texture, decodeJob->m_image);
+	texture->m_isLoading = false;
+	double uploadEndSeconds = GetCurrentTimeSeconds();
+
+	TextureLoadTiming timing;
+	timing.m_imageFilePath = decodeJob->m_imageFilePath;
+	timing.m_numBytes = GetNumTexelBytes(decodeJob->m_image);
+	timing.m_queuedSeconds = decodeJob->m_decodeStartSeconds - decodeJob->m_requestSeconds;
+	timing.m_decodeSeconds = decodeJob->m_decodeEndSeconds - decodeJob->m_decodeStartSeconds;
+	timing.m_uploadWaitSeconds = uploadStartSeconds - decodeJob->m_decodeEndSeconds;
+	timing.m_uploadSeconds = uploadEndSeconds - uploadStartSeconds;
+	m_textureLoadTimings.push_back(timing);
+
+	m_uploadStats.m_numBytesUploaded += timing.m_numBytes;
+	delete decodeJob;
+}
+
+BitmapFont* Renderer::CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNoExtension)
+{
+	std::string bitmapFontKey = NormalizeAssetPath(bitmapFontFilePathWithNoExtension);
+	AssetID bitmapFontID = FindOrClaimAsset(m_bitmapFontIDs, bitmapFontKey);
+	if (bitmapFontID != INVALID_ASSET_ID)
+	{
+		return GetBitmapFontForID(bitmapFontID);
+	}
+
+	BitmapFont* newBitmapFont = CreateBitmapFont(bitmapFontFilePathWithNoExtension);
+	AddLoadedBitmapFont(newBitmapFont, bitmapFontKey);
+	return newBitmapFont;
+}
+
+Shader* Renderer::CreateOrGetShader(char const* shaderFilePath, VertexType vertexType)
+{
+	AssetID shaderID = FindOrClaimAsset(m_shaderIDs, GetShaderKey(shaderFilePath, GetShaderVertexType(shaderFilePath, vertexType)));
+	if (shaderID != INVALID_ASSET_ID)
+	{
+		return GetShaderForID(shaderID);
+	}
+
+	// CreateShader publishes the new shader through AddLoadedShader
+	Shader* newShader = CreateShader(shaderFilePath, vertexType);
+	return newShader;
+}
+
+Shader* Renderer::CreateShader(char const* shaderName, VertexType vertexType)
+{
+	std::string shaderFilePath = shaderName + std::string(".hlsl");
+	std::string outShaderContents;
+	int shaderItemsRead = FileReadToString(outShaderContents, shaderFilePath);
+	if (shaderItemsRead == 0)
+	{
+		ERROR_AND_DIE("Failed to read the shader file: " + shaderFilePath);
+	}
+	Shader* shader = CreateShader(shaderName, outShaderContents.c_str(), vertexType);
+	return shader;
+}
+
+Texture* Renderer::GetTextureForFileName(char const* imageFilePath)
+{
+	return GetTextureForID(GetTextureID(imageFilePath));
+}
+
+BitmapFont* Renderer::GetBitmapFontForFileName(char const* bitmapFontFilePathWithNoExtension)
+{
+	return GetBitmapFontForID(GetBitmapFontID(bitmapFontFilePathWithNoExtension));
+}
+
+Shader* Renderer::GetShaderForName(char const* shaderName, VertexType vertexType)
+{
+	return GetShaderForID(GetShaderID(shaderName, vertexType));
+}
+
+AssetID Renderer::GetTextureID(char const* imageFilePath) const
+{
+	return FindAsset(m_textureIDs, NormalizeAssetPath(imageFilePath));
+}
+
+AssetID Renderer::GetBitmapFontID(char const* bitmapFontFilePathWithNoExtension) const
+{
+	return FindAsset(m_bitmapFontIDs, NormalizeAssetPath(bitmapFontFilePathWithNoExtension));
+}
+
+AssetID Renderer::GetShaderID(char const* shaderName, VertexType vertexType) const
+{
+	return FindAsset(m_shaderIDs, GetShaderKey(shaderName, GetShaderVertexType(shaderName, vertexType)));
+}
+
+Texture* Renderer::GetTextureForID(AssetID textureID) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_assetMutex);
+	if (textureID < 0 || textureID >= (int)m_loadedTextures.size())
+	{
+		return nullptr;
+	}
+	return m_loadedTextures[textureID];
+}
+
+BitmapFont* Renderer::GetBitmapFontForID(AssetID bitmapFontID) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_assetMutex);
+	if (bitmapFontID < 0 || bitmapFontID >= (int)m_loadedFonts.size())
+	{
+		return nullptr;
+	}
+	return m_loadedFonts[bitmapFontID];
+}
+
+Shader* Renderer::GetShaderForID(AssetID shaderID) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_assetMutex);
+	if (shaderID < 0 || shaderID >= (int)m_loadedShaders.size())
+	{
+		return nullptr;
+	}
+	return m_loadedShaders[shaderID];
+}
+
+// Returns the asset's ID if it is loaded. If another thread is loading it, waits for that load
+// instead of starting a second one. Otherwise claims the path for the calling thread and returns
+// INVALID_ASSET_ID; the caller must then load the asset and publish it with AddLoaded*.
+AssetID Renderer::FindOrClaimAsset(AssetIDRegistry& registry, std::string const& assetKey)
+{
+	AssetID assetID = FindAsset(registry, assetKey);
+	if (assetID != INVALID_ASSET_ID)
+	{
+		return assetID;
+	}
+
+	std::unique_lock<std::shared_mutex> lock(m_assetMutex);
+	std::pair<AssetIDRegistry::iterator, bool> claim = registry.emplace(assetKey, INVALID_ASSET_ID);
+	if (claim.second)
+	{
+		return INVALID_ASSET_ID;
+	}
+
+	// References to map entries survive rehashing, so the claimed entry can be watched directly
+	AssetID const& claimedID = claim.first->second;
+	m_assetLoadedCondition.wait(lock, [&claimedID]() { return claimedID != INVALID_ASSET_ID; });
+	return claimedID;
+}
+
+AssetID Renderer::FindAsset(AssetIDRegistry const& registry, std::string const& assetKey) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_assetMutex);
+	AssetIDRegistry::const_iterator found = registry.find(assetKey);
+	if (found == registry.end())
+	{
+		return INVALID_ASSET_ID;
+	}
+	return found->second;
+}
+
+// m_assetMutex must be held. Fills in a claimed or missing entry; one that is already loaded keeps
+// its ID, which is returned.
+AssetID Renderer::PublishAsset(AssetIDRegistry& registry, std::string const& assetKey, AssetID assetID)
+{
+	AssetID& registeredID = registry.emplace(assetKey, INVALID_ASSET_ID).first->second;
+	if (registeredID == INVALID_ASSET_ID)
+	{
+		registeredID = assetID;
+	}
+	return registeredID;
+}
+
+AssetID Renderer::AddLoadedTexture(Texture* texture, std::string const& assetKey)
+{
+	AssetID textureID = INVALID_ASSET_ID;
+	{
+		std::unique_lock<std::shared_mutex> lock(m_assetMutex);
+		m_loadedTextures.push_back(texture);
+		textureID = PublishAsset(m_textureIDs, assetKey, (AssetID)m_loadedTextures.size() - 1);
+	}
+	m_assetLoadedCondition.notify_all();
+	return textureID;
+}
+
+AssetID Renderer::AddLoadedBitmapFont(BitmapFont* bitmapFont, std::string const& assetKey)
+{
+	AssetID bitmapFontID = INVALID_ASSET_ID;
+	{
+		std::unique_lock<std::shared_mutex> lock(m_assetMutex);
+		m_loadedFonts.push_back(bitmapFont);
+		bitmapFontID = PublishAsset(m_bitmapFontIDs, assetKey, (AssetID)m_loadedFonts.size() - 1);
+	}
+	m_assetLoadedCondition.notify_all();
+	return bitmapFontID;
+}
+
+// Every shader is registered under its name and vertex type, including ones made straight from
+// source with CreateShader, so CreateOrGetShader finds those too.
+AssetID Renderer::AddLoadedShader(Shader* shader)
+{
+	std::string shaderKey = GetShaderKey(shader->m_config.m_name.c_str(), shader->m_config.m_vertexType);
+	AssetID shaderID = INVALID_ASSET_ID;
+	{
+		std::unique_lock<std::shared_mutex> lock(m_assetMutex);
+		m_loadedShaders.push_back(shader);
+		shaderID = PublishAsset(m_shaderIDs, shaderKey, (AssetID)m_loadedShaders.size() - 1);
+	}
+	m_assetLoadedCondition.notify_all();
+	return shaderID;
+}
+
+// SpriteLit always takes PNCU verts, whatever the caller asked for
+VertexType Renderer::GetShaderVertexType(char const* shaderName, VertexType vertexType) const
+{
+	std::string isSpriteLit = "Data/Shaders/SpriteLit";
+	if (shaderName == isSpriteLit)
+	{
+		return VERTEX_TYPE_PNCU;
+	}
+	return vertexType;
+}
@@ -1,7 +1,9 @@
 #include "Engine/Renderer/Shader.hpp"
 #include "Renderer.hpp"
 
+#if !defined(ENGINE_NULL_RENDERER)
 #include <d3d11.h>
+#endif
 
 
 Shader::Shader(ShaderConfig const& config) : 
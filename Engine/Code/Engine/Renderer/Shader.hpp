@@ -7,9 +7,26 @@ struct ID3D11PixelShader;
 struct ID3D11InputLayout;
 
 
+//--------------------------------------------------------------------------------------------------
+// Which vertex struct the shader's input layout is built for.
+enum VertexType : unsigned char
+{
+	VERTEX_TYPE_PCU,
+	VERTEX_TYPE_PNCU,
+	VERTEX_TYPE_PCU_PACKED,		// Vertex_PCUPacked: half UVs
+	VERTEX_TYPE_PCU_QUANTIZED,	// Vertex_PCUQuantized: unorm16 positions, half UVs
+	VERTEX_TYPE_PNCU_PACKED,	// Vertex_PNCUPacked: octahedral normals as a float2, half UVs
+	VERTEX_TYPE_PNCU_QUANTIZED,	// Vertex_PNCUQuantized: unorm16 positions, octahedral normals, half UVs
+	VERTEX_TYPE_PCU_INSTANCED_2D,	// Vertex_PCU in slot 0, Instance2D in slot 1
+
+	VERTEX_TYPE_COUNT,
+};
+
+
 struct ShaderConfig
 {
 	std::string m_name;
+	VertexType m_vertexType = VERTEX_TYPE_PCU;
 	std::string m_vertexEntryPoint = "VertexMain";
 	std::string m_pixelEntryPoint = "PixelMain";
 };
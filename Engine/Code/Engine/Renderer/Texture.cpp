@@ -1,7 +1,9 @@
 #include "Texture.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 
+#if !defined(ENGINE_NULL_RENDERER)
 #include <d3d11.h>
+#endif
 
 Texture::~Texture()
 {
@@ -17,10 +17,12 @@ private:
 public:
 	IntVec2				GetDimensions() const { return m_dimensions; }
 	std::string const& GetImageFilePath() const { return m_name; }
+	bool				IsLoaded() const { return !m_isLoading; }
 
 protected:
 	std::string			m_name;
 	IntVec2				m_dimensions;
+	bool				m_isLoading = false;	// Still streaming in; draws as the default texture until it is uploaded
 
 	ID3D11Texture2D* m_texture = nullptr;
 	ID3D11ShaderResourceView* m_shaderResourceView = nullptr;
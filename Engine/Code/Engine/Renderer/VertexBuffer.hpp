@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stddef.h>
+
 struct ID3D11Buffer;
 
 class VertexBuffer
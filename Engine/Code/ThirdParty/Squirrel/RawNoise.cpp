@@ -2,5 +2,54 @@
 // RawNoise.cpp
 //
 #include "ThirdParty/Squirrel/RawNoise.hpp"
+#include <emmintrin.h>
 
 
+//-----------------------------------------------------------------------------------------------
+// SSE2 has no 32-bit low multiply, so build one from the two 32x32->64 multiplies it does have
+//
+static inline __m128i MultiplyLow32x4( __m128i a, __m128i b )
+{
+	__m128i evenProducts = _mm_mul_epu32( a, b );
+	__m128i oddProducts = _mm_mul_epu32( _mm_srli_si128( a, 4 ), _mm_srli_si128( b, 4 ) );
+	return _mm_unpacklo_epi32( _mm_shuffle_epi32( evenProducts, _MM_SHUFFLE( 0, 0, 2, 0 ) ), _mm_shuffle_epi32( oddProducts, _MM_SHUFFLE( 0, 0, 2, 0 ) ) );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Four lanes of Get1dNoiseUint(); the constants and steps must stay in sync with it
+//
+static inline __m128i Get1dNoiseUintX4( __m128i positions, unsigned int seed )
+{
+	constexpr unsigned int BIT_NOISE1 = 0xd2a80a23;
+	constexpr unsigned int BIT_NOISE2 = 0xa884f197;
+	constexpr unsigned int BIT_NOISE3 = 0x1b56c4e9;
+
+	__m128i mangledBits = MultiplyLow32x4( positions, _mm_set1_epi32( (int) BIT_NOISE1 ) );
+	mangledBits = _mm_add_epi32( mangledBits, _mm_set1_epi32( (int) seed ) );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 7 ) );
+	mangledBits = _mm_add_epi32( mangledBits, _mm_set1_epi32( (int) BIT_NOISE2 ) );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 8 ) );
+	mangledBits = MultiplyLow32x4( mangledBits, _mm_set1_epi32( (int) BIT_NOISE3 ) );
+	mangledBits = _mm_xor_si128( mangledBits, _mm_srli_epi32( mangledBits, 11 ) );
+	return mangledBits;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Get1dNoiseUints( unsigned int* out_noiseValues, int firstIndex, int numIndexes, unsigned int seed )
+{
+	__m128i positions = _mm_add_epi32( _mm_set1_epi32( firstIndex ), _mm_setr_epi32( 0, 1, 2, 3 ) );
+	const __m128i FOUR = _mm_set1_epi32( 4 );
+	int index = 0;
+	for( ; index + 4 <= numIndexes; index += 4 )
+	{
+		_mm_storeu_si128( (__m128i*) (out_noiseValues + index), Get1dNoiseUintX4( positions, seed ) );
+		positions = _mm_add_epi32( positions, FOUR );
+	}
+
+	for( ; index < numIndexes; ++ index )
+	{
+		out_noiseValues[ index ] = Get1dNoiseUint( (int) ((unsigned int) firstIndex + (unsigned int) index), seed );
+	}
+}
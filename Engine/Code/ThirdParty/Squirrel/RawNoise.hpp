@@ -60,6 +60,13 @@ constexpr float Get2dNoiseNegOneToOne( int indexX, int indexY, unsigned int seed
 constexpr float Get3dNoiseNegOneToOne( int indexX, int indexY, int indexZ, unsigned int seed=0 );
 constexpr float Get4dNoiseNegOneToOne( int indexX, int indexY, int indexZ, int indexT, unsigned int seed=0 );
 
+//-----------------------------------------------------------------------------------------------
+// Bulk version of Get1dNoiseUint() for the consecutive indexes [firstIndex, firstIndex+numIndexes),
+//	hashed four at a time (SSE2).  Results match the single-index function exactly, including
+//	wrap-around past the largest int.
+//
+void Get1dNoiseUints( unsigned int* out_noiseValues, int firstIndex, int numIndexes, unsigned int seed=0 );
+
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // Inline function definitions below
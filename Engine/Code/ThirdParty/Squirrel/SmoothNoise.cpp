@@ -6,7 +6,9 @@
 #include "Engine/Math/Vec4.hpp"				// for Vec4( float x,y,z,w ) class/struct
 #include "Engine/Math/Vec3.hpp"				// for Vec3( float x,y,z ) class/struct
 #include "Engine/Math/Vec2.hpp"				// for Vec2( float x,y ) class/struct
+#include "Engine/Core/JobSystem.hpp"		// for splitting grid fills across worker threads
 #include <math.h>
+#include <limits.h>
 
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -23,6 +25,32 @@
 //------------------------------------------------------------------------------------------------
 constexpr float fSQRT_3_OVER_3 = 0.57735026918962576450914878050196f;
 
+//------------------------------------------------------------------------------------------------
+// Perlin gradient tables, shared by the single-sample functions and the grid fills below
+static const Vec2 PERLIN_GRADIENTS_2D[ 8 ] = // Normalized unit vectors in 8 quarter-cardinal directions
+{
+	Vec2( +0.923879533f, +0.382683432f ), //  22.5 degrees (ENE)
+	Vec2( +0.382683432f, +0.923879533f ), //  67.5 degrees (NNE)
+	Vec2( -0.382683432f, +0.923879533f ), // 112.5 degrees (NNW)
+	Vec2( -0.923879533f, +0.382683432f ), // 157.5 degrees (WNW)
+	Vec2( -0.923879533f, -0.382683432f ), // 202.5 degrees (WSW)
+	Vec2( -0.382683432f, -0.923879533f ), // 247.5 degrees (SSW)
+	Vec2( +0.382683432f, -0.923879533f ), // 292.5 degrees (SSE)
+	Vec2( +0.923879533f, -0.382683432f )	 // 337.5 degrees (ESE)
+};
+
+static const Vec3 PERLIN_GRADIENTS_3D[ 8 ] = // Traditional "12 edges" requires modulus and isn't any better.
+{
+	Vec3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), // Normalized unit 3D vectors
+	Vec3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), //  pointing toward cube
+	Vec3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), //  corners, so components
+	Vec3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), //  are all sqrt(3)/3, i.e.
+	Vec3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ), // 0.5773502691896257645091f.
+	Vec3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ), // These are slightly better
+	Vec3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ), // than axes (1,0,0) and much
+	Vec3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 )  // faster than edges (1,1,0).
+};
+
 
 //-----------------------------------------------------------------------------------------------
 float Compute1dFractalNoise( float position, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
@@ -371,17 +399,7 @@ float Compute1dPerlinNoise( float position, float scale, unsigned int numOctaves
 float Compute2dPerlinNoise( float posX, float posY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
 {
 	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
-	static const Vec2 gradients[ 8 ] = // Normalized unit vectors in 8 quarter-cardinal directions
-	{
-		Vec2( +0.923879533f, +0.382683432f ), //  22.5 degrees (ENE)
-		Vec2( +0.382683432f, +0.923879533f ), //  67.5 degrees (NNE)
-		Vec2( -0.382683432f, +0.923879533f ), // 112.5 degrees (NNW)
-		Vec2( -0.923879533f, +0.382683432f ), // 157.5 degrees (WNW)
-		Vec2( -0.923879533f, -0.382683432f ), // 202.5 degrees (WSW)
-		Vec2( -0.382683432f, -0.923879533f ), // 247.5 degrees (SSW)
-		Vec2( +0.382683432f, -0.923879533f ), // 292.5 degrees (SSE)
-		Vec2( +0.923879533f, -0.382683432f )	 // 337.5 degrees (ESE)
-	};
+	const Vec2* gradients = PERLIN_GRADIENTS_2D;
 
 	float totalNoise = 0.f;
 	float totalAmplitude = 0.f;
@@ -463,17 +481,7 @@ float Compute3dPerlinNoise( float posX, float posY, float posZ, float scale, uns
 {
 	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
 
-	static const Vec3 gradients[ 8 ] = // Traditional "12 edges" requires modulus and isn't any better.
-	{
-		Vec3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), // Normalized unit 3D vectors
-		Vec3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), //  pointing toward cube
-		Vec3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), //  corners, so components
-		Vec3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, +fSQRT_3_OVER_3 ), //  are all sqrt(3)/3, i.e.
-		Vec3( +fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ), // 0.5773502691896257645091f.
-		Vec3( -fSQRT_3_OVER_3, +fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ), // These are slightly better
-		Vec3( +fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 ), // than axes (1,0,0) and much
-		Vec3( -fSQRT_3_OVER_3, -fSQRT_3_OVER_3, -fSQRT_3_OVER_3 )  // faster than edges (1,1,0).
-	};
+	const Vec3* gradients = PERLIN_GRADIENTS_3D;
 
 	float totalNoise = 0.f;
 	float totalAmplitude = 0.f;
@@ -744,3 +752,375 @@ float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, floa
 	return totalNoise;
 }
 
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+// Grid fills
+//
+// A grid is filled one row (along X) at a time.  Within a row, Y and Z - and so everything about
+//	the lattice in those axes - are the same for every sample, so only X varies per sample.  Each
+//	octave hashes the span of lattice columns the row covers once (Get1dNoiseUints()), and samples
+//	sharing a lattice cell read the same corner hashes.  If the row covers far more lattice columns
+//	than it has samples (very high octaves), each sample's corners are hashed directly instead.
+//
+// Every float operation below mirrors the single-sample functions exactly, in the same order,
+//	which is what keeps the results bit-identical.
+/////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr int NOISE_GRID_ROWS_PER_JOB = 16;
+
+
+//-----------------------------------------------------------------------------------------------
+struct NoiseGridSettings
+{
+	float*			m_noiseValues = nullptr;
+	int				m_numSamples[ 3 ] = { 1, 1, 1 };
+	float			m_start[ 3 ] = { 0.f, 0.f, 0.f };
+	float			m_step[ 3 ] = { 1.f, 1.f, 1.f };
+	float			m_scale = 1.f;
+	unsigned int	m_numOctaves = 1;
+	float			m_octavePersistence = 0.5f;
+	float			m_octaveScale = 2.f;
+	bool			m_renormalize = true;
+	unsigned int	m_seed = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+// Lattice position (X,Y,Z) hashes as X + <rowOffset>, where rowOffset = (PRIME1 * Y) + (PRIME2 * Z)
+//	wraps the same way as in Get2dNoiseUint() / Get3dNoiseUint()
+static unsigned int GetLatticeRowOffset( int indexY, int indexZ )
+{
+	constexpr unsigned int PRIME1 = 198491317;
+	constexpr unsigned int PRIME2 = 6542989;
+	return (PRIME1 * (unsigned int) indexY) + (PRIME2 * (unsigned int) indexZ);
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Same conversion as Get2dNoiseZeroToOne() / Get3dNoiseZeroToOne()
+static inline float GetNoiseZeroToOneForUint( unsigned int noise )
+{
+	const double ONE_OVER_MAX_UINT = (1.0 / (double) 0xFFFFFFFF);
+	return (float)( ONE_OVER_MAX_UINT * (double) noise );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+// Corner rows are ordered (south, north) in 2D and (below south, below north, above south,
+//	above north) in 3D; each has a west and an east corner.
+//
+template< int NUM_DIMENSIONS, bool IS_PERLIN >
+static void FillNoiseGridRows( NoiseGridSettings const& settings, int firstRow, int numRows )
+{
+	const float OCTAVE_OFFSET = 0.636764989593174f; // Translation/bias to add to each octave
+	constexpr int NUM_CORNER_ROWS = NUM_DIMENSIONS == 2 ? 2 : 4;
+
+	int numSamplesX = settings.m_numSamples[ 0 ];
+	int numSamplesY = settings.m_numSamples[ 1 ];
+	float invScale = (1.f / settings.m_scale);
+
+	std::vector<float>			currentXs( numSamplesX );
+	std::vector<float>			cellMinXs( numSamplesX );
+	std::vector<int>			indexWestXs( numSamplesX );
+	std::vector<float>			totalNoises( numSamplesX );
+	std::vector<unsigned int>	latticeRowHashes;
+
+	for( int rowIndex = firstRow; rowIndex < firstRow + numRows; ++ rowIndex )
+	{
+		int sampleY = rowIndex % numSamplesY;
+		int sampleZ = rowIndex / numSamplesY;
+		float posY = settings.m_start[ 1 ] + (settings.m_step[ 1 ] * (float) sampleY);
+		float posZ = settings.m_start[ 2 ] + (settings.m_step[ 2 ] * (float) sampleZ);
+		float currentY = posY * invScale;
+		float currentZ = posZ * invScale;
+		for( int sampleX = 0; sampleX < numSamplesX; ++ sampleX )
+		{
+			float posX = settings.m_start[ 0 ] + (settings.m_step[ 0 ] * (float) sampleX);
+			currentXs[ sampleX ] = posX * invScale;
+			totalNoises[ sampleX ] = 0.f;
+		}
+
+		float totalAmplitude = 0.f;
+		float currentAmplitude = 1.f;
+		unsigned int seed = settings.m_seed;
+		for( unsigned int octaveNum = 0; octaveNum < settings.m_numOctaves; ++ octaveNum )
+		{
+			// Everything about the lattice in Y and Z is shared by the whole row
+			float cellMinY = floorf( currentY );
+			float cellMaxY = cellMinY + 1.f;
+			float cellMinZ = floorf( currentZ );
+			float cellMaxZ = cellMinZ + 1.f;
+			int indexSouthY = (int) cellMinY;
+			int indexBelowZ = NUM_DIMENSIONS == 2 ? 0 : (int) cellMinZ;
+			float displacementFromMinY = currentY - cellMinY;
+			float displacementFromMaxY = currentY - cellMaxY;
+			float displacementFromMinZ = currentZ - cellMinZ;
+			float displacementFromMaxZ = currentZ - cellMaxZ;
+			float weightNorth = SmoothStep3( displacementFromMinY );
+			float weightSouth = 1.f - weightNorth;
+			float weightAbove = NUM_DIMENSIONS == 2 ? 0.f : SmoothStep3( displacementFromMinZ );
+			float weightBelow = 1.f - weightAbove;
+
+			unsigned int cornerRowOffsets[ 4 ] =
+			{
+				GetLatticeRowOffset( indexSouthY,		indexBelowZ ),
+				GetLatticeRowOffset( indexSouthY + 1,	indexBelowZ ),
+				GetLatticeRowOffset( indexSouthY,		indexBelowZ + 1 ),
+				GetLatticeRowOffset( indexSouthY + 1,	indexBelowZ + 1 ),
+			};
+
+			int minIndexX = INT_MAX;
+			int maxIndexX = INT_MIN;
+			for( int sampleX = 0; sampleX < numSamplesX; ++ sampleX )
+			{
+				float cellMinX = floorf( currentXs[ sampleX ] );
+				int indexWestX = (int) cellMinX;
+				cellMinXs[ sampleX ] = cellMinX;
+				indexWestXs[ sampleX ] = indexWestX;
+				minIndexX = indexWestX < minIndexX ? indexWestX : minIndexX;
+				maxIndexX = indexWestX > maxIndexX ? indexWestX : maxIndexX;
+			}
+
+			long long numLatticeColumns = (long long) maxIndexX - (long long) minIndexX + 2;
+			bool areHashesShared = numLatticeColumns <= (2 * (long long) numSamplesX) + 8;
+			if( areHashesShared )
+			{
+				latticeRowHashes.resize( (size_t) (NUM_CORNER_ROWS * numLatticeColumns) );
+				for( int cornerRow = 0; cornerRow < NUM_CORNER_ROWS; ++ cornerRow )
+				{
+					int firstPosition = (int) ((unsigned int) minIndexX + cornerRowOffsets[ cornerRow ]);
+					Get1dNoiseUints( latticeRowHashes.data() + (cornerRow * numLatticeColumns), firstPosition, (int) numLatticeColumns, seed );
+				}
+			}
+
+			for( int sampleX = 0; sampleX < numSamplesX; ++ sampleX )
+			{
+				// West and east corner hashes for each corner row
+				unsigned int cornerHashes[ 4 ][ 2 ];
+				int indexWestX = indexWestXs[ sampleX ];
+				if( areHashesShared )
+				{
+					int columnIndex = indexWestX - minIndexX;
+					for( int cornerRow = 0; cornerRow < NUM_CORNER_ROWS; ++ cornerRow )
+					{
+						cornerHashes[ cornerRow ][ 0 ] = latticeRowHashes[ (cornerRow * numLatticeColumns) + columnIndex ];
+						cornerHashes[ cornerRow ][ 1 ] = latticeRowHashes[ (cornerRow * numLatticeColumns) + columnIndex + 1 ];
+					}
+				}
+				else
+				{
+					for( int cornerRow = 0; cornerRow < NUM_CORNER_ROWS; ++ cornerRow )
+					{
+						unsigned int westPosition = (unsigned int) indexWestX + cornerRowOffsets[ cornerRow ];
+						cornerHashes[ cornerRow ][ 0 ] = Get1dNoiseUint( (int) westPosition, seed );
+						cornerHashes[ cornerRow ][ 1 ] = Get1dNoiseUint( (int) (westPosition + 1), seed );
+					}
+				}
+
+				float currentX = currentXs[ sampleX ];
+				float cellMinX = cellMinXs[ sampleX ];
+				float cellMaxX = cellMinX + 1.f;
+				float displacementFromMinX = currentX - cellMinX;
+				float displacementFromMaxX = currentX - cellMaxX;
+				float weightEast = SmoothStep3( displacementFromMinX );
+				float weightWest = 1.f - weightEast;
+
+				// Value (fractal) or gradient dot product (Perlin) at each corner
+				float cornerValues[ 4 ][ 2 ] = {};
+				for( int cornerRow = 0; cornerRow < NUM_CORNER_ROWS; ++ cornerRow )
+				{
+					for( int cornerColumn = 0; cornerColumn < 2; ++ cornerColumn )
+					{
+						unsigned int noise = cornerHashes[ cornerRow ][ cornerColumn ];
+						if( !IS_PERLIN )
+						{
+							cornerValues[ cornerRow ][ cornerColumn ] = GetNoiseZeroToOneForUint( noise );
+							continue;
+						}
+
+						float displacementX = cornerColumn == 0 ? displacementFromMinX : displacementFromMaxX;
+						float displacementY = (cornerRow & 1) == 0 ? displacementFromMinY : displacementFromMaxY;
+						if( NUM_DIMENSIONS == 2 )
+						{
+							const Vec2& gradient = PERLIN_GRADIENTS_2D[ noise & 0x00000007 ];
+							cornerValues[ cornerRow ][ cornerColumn ] = (gradient.x * displacementX) + (gradient.y * displacementY);
+						}
+						else
+						{
+							float displacementZ = (cornerRow & 2) == 0 ? displacementFromMinZ : displacementFromMaxZ;
+							const Vec3& gradient = PERLIN_GRADIENTS_3D[ noise & 0x00000007 ];
+							cornerValues[ cornerRow ][ cornerColumn ] = (gradient.x * displacementX) + (gradient.y * displacementY) + (gradient.z * displacementZ);
+						}
+					}
+				}
+
+				float blendSouth = (weightEast * cornerValues[ 0 ][ 1 ]) + (weightWest * cornerValues[ 0 ][ 0 ]);
+				float blendNorth = (weightEast * cornerValues[ 1 ][ 1 ]) + (weightWest * cornerValues[ 1 ][ 0 ]);
+				float blendTotal = (weightSouth * blendSouth) + (weightNorth * blendNorth);
+				if( NUM_DIMENSIONS == 3 )
+				{
+					float blendAboveSouth = (weightEast * cornerValues[ 2 ][ 1 ]) + (weightWest * cornerValues[ 2 ][ 0 ]);
+					float blendAboveNorth = (weightEast * cornerValues[ 3 ][ 1 ]) + (weightWest * cornerValues[ 3 ][ 0 ]);
+					float blendAbove = (weightSouth * blendAboveSouth) + (weightNorth * blendAboveNorth);
+					blendTotal = (weightBelow * blendTotal) + (weightAbove * blendAbove);
+				}
+
+				float noiseThisOctave = 0.f;
+				if( !IS_PERLIN )
+				{
+					noiseThisOctave = 2.f * (blendTotal - 0.5f); // Map from [0,1] to [-1,1]
+				}
+				else if( NUM_DIMENSIONS == 2 )
+				{
+					noiseThisOctave = blendTotal * (1.f / 0.662578106f); // 2D Perlin is in [-.662578106,.662578106]; map to ~[-1,1]
+				}
+				else
+				{
+					noiseThisOctave = blendTotal * (1.f / 0.793856621f); // 3D Perlin is in [-.793856621,.793856621]; map to ~[-1,1]
+				}
+
+				totalNoises[ sampleX ] += noiseThisOctave * currentAmplitude;
+			}
+
+			// Prepare for next octave (if any)
+			totalAmplitude += currentAmplitude;
+			currentAmplitude *= settings.m_octavePersistence;
+			for( int sampleX = 0; sampleX < numSamplesX; ++ sampleX )
+			{
+				currentXs[ sampleX ] *= settings.m_octaveScale;
+				currentXs[ sampleX ] += OCTAVE_OFFSET;
+			}
+			currentY *= settings.m_octaveScale;
+			currentY += OCTAVE_OFFSET;
+			currentZ *= settings.m_octaveScale;
+			currentZ += OCTAVE_OFFSET;
+			++ seed;
+		}
+
+		// Re-normalize total noise to within [-1,1] and fix octaves pulling us far away from limits
+		float* rowNoiseValues = settings.m_noiseValues + ((size_t) rowIndex * (size_t) numSamplesX);
+		for( int sampleX = 0; sampleX < numSamplesX; ++ sampleX )
+		{
+			float totalNoise = totalNoises[ sampleX ];
+			if( settings.m_renormalize && totalAmplitude > 0.f )
+			{
+				totalNoise /= totalAmplitude;				// Amplitude exceeds 1.0 if octaves are used
+				totalNoise = (totalNoise * 0.5f) + 0.5f;	// Map to [0,1]
+				totalNoise = SmoothStep3( totalNoise );		// Push towards extents (octaves pull us away)
+				totalNoise = (totalNoise * 2.0f) - 1.f;		// Map back to [-1,1]
+			}
+			rowNoiseValues[ sampleX ] = totalNoise;
+		}
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+typedef void (*NoiseGridRowsFunction)( NoiseGridSettings const& settings, int firstRow, int numRows );
+
+
+//-----------------------------------------------------------------------------------------------
+class NoiseGridRowsJob : public Job
+{
+public:
+	NoiseGridRowsJob( NoiseGridSettings const& settings, NoiseGridRowsFunction fillRows, int firstRow, int numRows ) :
+		m_settings( settings ),
+		m_fillRows( fillRows ),
+		m_firstRow( firstRow ),
+		m_numRows( numRows )
+	{};
+	virtual void Execute() override
+	{
+		m_fillRows( m_settings, m_firstRow, m_numRows );
+	}
+
+	NoiseGridSettings const&	m_settings;
+	NoiseGridRowsFunction		m_fillRows = nullptr;
+	int							m_firstRow = 0;
+	int							m_numRows = 0;
+};
+
+
+//-----------------------------------------------------------------------------------------------
+static void FillNoiseGrid( NoiseGridSettings const& settings, NoiseGridRowsFunction fillRows, bool useJobSystem )
+{
+	if( settings.m_numSamples[ 0 ] <= 0 || settings.m_numSamples[ 1 ] <= 0 || settings.m_numSamples[ 2 ] <= 0 )
+	{
+		return;
+	}
+
+	int numRows = settings.m_numSamples[ 1 ] * settings.m_numSamples[ 2 ];
+	if( !useJobSystem || !g_theJobSystem || g_theJobSystem->GetNumWorkers() == 0 || numRows <= NOISE_GRID_ROWS_PER_JOB )
+	{
+		fillRows( settings, 0, numRows );
+		return;
+	}
+
+	std::vector<Job*> jobs;
+	for( int firstRow = 0; firstRow < numRows; firstRow += NOISE_GRID_ROWS_PER_JOB )
+	{
+		int numRowsInJob = numRows - firstRow < NOISE_GRID_ROWS_PER_JOB ? numRows - firstRow : NOISE_GRID_ROWS_PER_JOB;
+		jobs.push_back( new NoiseGridRowsJob( settings, fillRows, firstRow, numRowsInJob ) );
+	}
+	g_theJobSystem->ExecuteAndRetrieveJobs( jobs );
+
+	for( int jobIndex = 0; jobIndex < (int) jobs.size(); ++ jobIndex )
+	{
+		delete jobs[ jobIndex ];
+	}
+}
+
+
+//-----------------------------------------------------------------------------------------------
+static NoiseGridSettings MakeNoiseGridSettings( float* out_noiseValues, int numSamplesX, int numSamplesY, int numSamplesZ, float startX, float startY, float startZ, float stepX, float stepY, float stepZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed )
+{
+	NoiseGridSettings settings;
+	settings.m_noiseValues = out_noiseValues;
+	settings.m_numSamples[ 0 ] = numSamplesX;
+	settings.m_numSamples[ 1 ] = numSamplesY;
+	settings.m_numSamples[ 2 ] = numSamplesZ;
+	settings.m_start[ 0 ] = startX;
+	settings.m_start[ 1 ] = startY;
+	settings.m_start[ 2 ] = startZ;
+	settings.m_step[ 0 ] = stepX;
+	settings.m_step[ 1 ] = stepY;
+	settings.m_step[ 2 ] = stepZ;
+	settings.m_scale = scale;
+	settings.m_numOctaves = numOctaves;
+	settings.m_octavePersistence = octavePersistence;
+	settings.m_octaveScale = octaveScale;
+	settings.m_renormalize = renormalize;
+	settings.m_seed = seed;
+	return settings;
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill2dFractalNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, float startX, float startY, float stepX, float stepY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobSystem )
+{
+	NoiseGridSettings settings = MakeNoiseGridSettings( out_noiseValues, numSamplesX, numSamplesY, 1, startX, startY, 0.f, stepX, stepY, 1.f, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+	FillNoiseGrid( settings, FillNoiseGridRows< 2, false >, useJobSystem );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill3dFractalNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, int numSamplesZ, float startX, float startY, float startZ, float stepX, float stepY, float stepZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobSystem )
+{
+	NoiseGridSettings settings = MakeNoiseGridSettings( out_noiseValues, numSamplesX, numSamplesY, numSamplesZ, startX, startY, startZ, stepX, stepY, stepZ, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+	FillNoiseGrid( settings, FillNoiseGridRows< 3, false >, useJobSystem );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill2dPerlinNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, float startX, float startY, float stepX, float stepY, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobSystem )
+{
+	NoiseGridSettings settings = MakeNoiseGridSettings( out_noiseValues, numSamplesX, numSamplesY, 1, startX, startY, 0.f, stepX, stepY, 1.f, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+	FillNoiseGrid( settings, FillNoiseGridRows< 2, true >, useJobSystem );
+}
+
+
+//-----------------------------------------------------------------------------------------------
+void Fill3dPerlinNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, int numSamplesZ, float startX, float startY, float startZ, float stepX, float stepY, float stepZ, float scale, unsigned int numOctaves, float octavePersistence, float octaveScale, bool renormalize, unsigned int seed, bool useJobSystem )
+{
+	NoiseGridSettings settings = MakeNoiseGridSettings( out_noiseValues, numSamplesX, numSamplesY, numSamplesZ, startX, startY, startZ, stepX, stepY, stepZ, scale, numOctaves, octavePersistence, octaveScale, renormalize, seed );
+	FillNoiseGrid( settings, FillNoiseGridRows< 3, true >, useJobSystem );
+}
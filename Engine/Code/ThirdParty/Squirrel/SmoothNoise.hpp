@@ -76,6 +76,23 @@ float Compute3dPerlinNoise( float posX, float posY, float posZ, float scale=1.f,
 float Compute4dPerlinNoise( float posX, float posY, float posZ, float posT, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0 );
 
 
+//-----------------------------------------------------------------------------------------------
+// Grid fills (batch versions of the 2D/3D fractal and Perlin functions above)
+//
+// Fill a whole grid of evenly spaced samples at once, writing sample (x,y,z) to
+//	out_noiseValues[ x + (numSamplesX * (y + (numSamplesY * z))) ].  Each sample is bit-identical
+//	to calling the single-sample function at position ( startX + (stepX * (float) x), ... ),
+//	so existing seeds keep producing the same worlds.
+//
+// Lattice corners are hashed four at a time with SSE2 and shared by every sample in a row that
+//	falls in the same lattice cell; rows are split across JobSystem workers if <useJobSystem>.
+//
+void Fill2dFractalNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, float startX, float startY, float stepX=1.f, float stepY=1.f, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobSystem=true );
+void Fill3dFractalNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, int numSamplesZ, float startX, float startY, float startZ, float stepX=1.f, float stepY=1.f, float stepZ=1.f, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobSystem=true );
+void Fill2dPerlinNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, float startX, float startY, float stepX=1.f, float stepY=1.f, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobSystem=true );
+void Fill3dPerlinNoiseGrid( float* out_noiseValues, int numSamplesX, int numSamplesY, int numSamplesZ, float startX, float startY, float startZ, float stepX=1.f, float stepY=1.f, float stepZ=1.f, float scale=1.f, unsigned int numOctaves=1, float octavePersistence=0.5f, float octaveScale=2.f, bool renormalize=true, unsigned int seed=0, bool useJobSystem=true );
+
+
 //-----------------------------------------------------------------------------------------------
 // Simplex noise functions (random-access / deterministic)
 //
@@ -80,6 +80,10 @@ void App::Startup()
 //--------------------------------------------------------------------------------------------------
 void App::Shutdown()
 {	
+	m_theGame->Shutdown();
+	delete m_theGame;
+	m_theGame = nullptr;
+
 	// g_audio->Shutdown();
 	g_theRenderer->Shutdown();
 	g_theWindow->Shutdown();
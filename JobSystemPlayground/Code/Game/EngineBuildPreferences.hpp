@@ -9,8 +9,10 @@
 //
 
 #define ENGINE_DISABLE_AUDIO	// (If uncommented) Disables AudioSystem code and fmod linkage.
+//#define ENGINE_NULL_RENDERER	// (If uncommented) Builds NullRenderer.cpp instead of the D3D11 Renderer.cpp, for headless CPU benchmarking.
+//#define ENGINE_VERIFY_FLOW_FIELD_REPAIRS	// (If uncommented) Checks every TileFlowField repair against a full rebuild, and dies if they differ.
 
-#if defined(_DEBUG)
+#if defined(_DEBUG) && !defined(ENGINE_NULL_RENDERER)
 #define ENGINE_DEBUG_RENDERER
 #endif
 
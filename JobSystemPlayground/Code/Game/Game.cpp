@@ -6,7 +6,8 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Audio/AudioSystem.hpp"
-#include "Engine/Core/VertexUtils.hpp"
+
+#include <algorithm>
 
 //--------------------------------------------------------------------------------------------------
 extern Renderer* g_theRenderer;
@@ -37,6 +38,8 @@ void Game::Startup()
 //--------------------------------------------------------------------------------------------------
 void Game::Shutdown()
 {
+	delete m_tileInstanceBuffer;
+	m_tileInstanceBuffer = nullptr;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -101,61 +104,82 @@ void Game::UpdateTileStatus()
 		Tile&		currentTile		= m_tiles[tileIndex];
 		TestJob*	currentTestJob	= m_testJobs[tileIndex];
 
-		currentTile.m_tileStatus = currentTestJob->m_status;
+		JobStatus tileStatus = currentTestJob->m_status;
+		if (tileStatus != currentTile.m_tileStatus)
+		{
+			currentTile.m_tileStatus = tileStatus;
+			m_tileInstances[tileIndex].m_color = GetTileColor(tileStatus);
+			m_dirtyTileIndexes.push_back(tileIndex);
+		}
 	}
+
+	UpdateTileInstances();
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::RenderTiles() const
+// Only the tiles whose status changed since last frame are sent to the GPU. Nearby dirty tiles are
+// merged into one range, since re-sending a few clean instances is cheaper than another update call.
+void Game::UpdateTileInstances()
 {
-	static std::vector<Vertex_PCU> tempVerts;
-	constexpr int VERTS_PER_QUAD = 4;
-	tempVerts.reserve(NUM_OF_TILES * VERTS_PER_QUAD);
-	
-	static std::vector<unsigned int> tempIndexes;
-	constexpr int INDEXES_PER_QUAD = 6;
-	tempVerts.reserve(NUM_OF_TILES * INDEXES_PER_QUAD);
+	if (m_dirtyTileIndexes.empty())
+	{
+		return;
+	}
 
-	for (int tileIndex = 0; tileIndex < NUM_OF_TILES; ++tileIndex)
+	std::sort(m_dirtyTileIndexes.begin(), m_dirtyTileIndexes.end());
+	int firstTileIndex = m_dirtyTileIndexes[0];
+	int lastTileIndex = firstTileIndex;
+	for (int dirtyIndex = 1; dirtyIndex < (int)m_dirtyTileIndexes.size(); ++dirtyIndex)
 	{
-		Tile const& currentTile = m_tiles[tileIndex];
-		Rgba8 tileColor(Rgba8::WHITE);
-		switch (currentTile.m_tileStatus)
+		int tileIndex = m_dirtyTileIndexes[dirtyIndex];
+		if (tileIndex - lastTileIndex > TILE_INSTANCE_UPLOAD_MAX_GAP)
 		{
-		case JOB_STATUS_QUEUED:
-		{
-			tileColor = Rgba8::RED;
-			break;
+			g_theRenderer->UpdateInstances(m_tileInstanceBuffer, firstTileIndex, lastTileIndex - firstTileIndex + 1, &m_tileInstances[firstTileIndex]);
+			firstTileIndex = tileIndex;
 		}
-		case JOB_STATUS_CLAIMED_AND_EXECUTING:
-		{
-			tileColor = Rgba8::YELLOW;
-			break;
-		}
-		case JOB_STATUS_COMPLETED:
-		{
-			tileColor = Rgba8::GREEN;
-			break;
-		}
-		case JOB_STATUS_RETRIEVED_AND_RETIRED:
-		{
-			tileColor = Rgba8::BLUE;
-			break;
-		}
-		default:
-			break;
-		}
-		AddVertsForAABB2D(tempVerts, tempIndexes, currentTile.m_bounds, tileColor);
+		lastTileIndex = tileIndex;
 	}
+	g_theRenderer->UpdateInstances(m_tileInstanceBuffer, firstTileIndex, lastTileIndex - firstTileIndex + 1, &m_tileInstances[firstTileIndex]);
 
+	m_dirtyTileIndexes.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Game::RenderTiles() const
+{
 	g_theRenderer->SetModelConstants();
 	g_theRenderer->BindShader(nullptr);
 	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->DrawIndexedArray((int)tempVerts.size(), tempVerts.data(), (int)tempIndexes.size(), tempIndexes.data());
+	g_theRenderer->DrawInstanced2D(m_tileInstanceBuffer, NUM_OF_TILES);
+}
 
-	tempVerts.clear();
-	tempIndexes.clear();
+
+//--------------------------------------------------------------------------------------------------
+Rgba8 Game::GetTileColor(JobStatus tileStatus) const
+{
+	switch (tileStatus)
+	{
+	case JOB_STATUS_QUEUED:
+	{
+		return Rgba8::RED;
+	}
+	case JOB_STATUS_CLAIMED_AND_EXECUTING:
+	{
+		return Rgba8::YELLOW;
+	}
+	case JOB_STATUS_COMPLETED:
+	{
+		return Rgba8::GREEN;
+	}
+	case JOB_STATUS_RETRIEVED_AND_RETIRED:
+	{
+		return Rgba8::BLUE;
+	}
+	default:
+		return Rgba8::WHITE;
+	}
 }
 
 
@@ -169,7 +193,15 @@ void Game::InitializeTiles()
 		AABB2 cosmeticTileBounds(currentTileCoords.x, currentTileCoords.y, currentTileCoords.x + 1.f, currentTileCoords.y + 1.f);
 		cosmeticTileBounds.AddPadding(-0.05f, -0.05f);
 		currentTile.m_bounds = cosmeticTileBounds;
+
+		Instance2D& tileInstance = m_tileInstances[tileIndex];
+		tileInstance.m_translation = cosmeticTileBounds.m_mins;
+		tileInstance.m_scale = cosmeticTileBounds.GetDimensions();
+		tileInstance.m_color = GetTileColor(currentTile.m_tileStatus);
 	}
+
+	m_tileInstanceBuffer = g_theRenderer->CreateInstanceBuffer(NUM_OF_TILES);
+	g_theRenderer->UpdateInstances(m_tileInstanceBuffer, 0, NUM_OF_TILES, m_tileInstances);
 }
 
 
@@ -2,6 +2,7 @@
 
 //--------------------------------------------------------------------------------------------------
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/InstanceBuffer.hpp"
 #include "Engine/Core/JobSystem.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/Vec2.hpp"
@@ -12,6 +13,8 @@ constexpr int MAP_SIZE_X	= 40;
 constexpr int MAP_SIZE_Y	= 20;
 constexpr int NUM_OF_TILES	= MAP_SIZE_X * MAP_SIZE_Y;
 
+constexpr int TILE_INSTANCE_UPLOAD_MAX_GAP = 16;	// Dirty tiles this close together are uploaded as one range
+
 
 //--------------------------------------------------------------------------------------------------
 class TestJob : public Job
@@ -65,6 +68,8 @@ public:
 	void	UpdateTileStatus();
 	void	RenderTiles() const;
 	void	InitializeTiles();
+	void	UpdateTileInstances();
+	Rgba8	GetTileColor(JobStatus tileStatus) const;
 	Vec2	GetTileCoordsFromTileIndex(int tileIndex) const;
 	void	CreateTestJobs();
 
@@ -94,6 +99,10 @@ private:
 	Camera		m_worldCamera	= {};
 	Tile		m_tiles[NUM_OF_TILES];
 	TestJob*	m_testJobs[NUM_OF_TILES];
+
+	InstanceBuffer*		m_tileInstanceBuffer = nullptr;
+	Instance2D			m_tileInstances[NUM_OF_TILES];
+	std::vector<int>	m_dirtyTileIndexes;
 	GameState	m_currentState	= GAME_STATE_INVALID;
 	GameState	m_desiredState	= GAME_STATE_INVALID;
 };
\ No newline at end of file